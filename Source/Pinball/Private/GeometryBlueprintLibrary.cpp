@@ -2,8 +2,195 @@
 
 #include "GeometryBlueprintLibrary.h"
 #include "GeomTools.h"
+#include "Components/SplineComponent.h"
+#include "SplineGeometry.h"
+#include "PolygonClipping.h"
+#include "WallActor.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGeometryBlueprintLibrary, Log, All);
 
 bool UGeometryBlueprintLibrary::TriangulatePoly(TArray<FVector2D>& OutTris, const TArray<FVector2D>& InPolyVerts, bool bKeepColinearVertices)
 {
 	return FGeomTools2D::TriangulatePoly(OutTris, InPolyVerts, bKeepColinearVertices);
 }
+
+bool UGeometryBlueprintLibrary::MakeThickWallPolygon(TArray<FVector2D>& OutPolygon, const USplineComponent* Spline, float Thickness, int32 SamplesPerSegment)
+{
+	OutPolygon.Reset();
+	if (Spline == nullptr || Spline->GetNumberOfSplinePoints() < 2)
+	{
+		return false;
+	}
+
+	FSplineGeometry::MakeThickWallPolygon(Spline->SplineCurves.Position, Spline->IsClosedLoop(), Thickness, SamplesPerSegment, OutPolygon);
+	return OutPolygon.Num() >= 3;
+}
+
+bool UGeometryBlueprintLibrary::GetSplineOutline(TArray<FVector2D>& OutOutline, const USplineComponent* Spline, int32 SamplesPerSegment)
+{
+	OutOutline.Reset();
+	if (Spline == nullptr || Spline->GetNumberOfSplinePoints() < 2)
+	{
+		return false;
+	}
+
+	const FInterpCurveVector& PositionCurve = Spline->SplineCurves.Position;
+	const FTransform& SplineTransform = Spline->GetComponentTransform();
+	const int32 NumPoints = PositionCurve.Points.Num();
+	const bool bClosedLoop = Spline->IsClosedLoop();
+	const int32 NumSegments = bClosedLoop ? NumPoints : NumPoints - 1;
+	SamplesPerSegment = FMath::Max(SamplesPerSegment, 1);
+
+	OutOutline.Reserve(NumSegments * SamplesPerSegment + 1);
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		const int32 NumSamples = (PositionCurve.Points[SegmentIndex].InterpMode == CIM_Linear) ? 1 : SamplesPerSegment;
+		for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+		{
+			const FVector Location = PositionCurve.Eval(SegmentIndex + (float)SampleIndex / NumSamples, FVector::ZeroVector);
+			OutOutline.Add(FVector2D(SplineTransform.TransformPosition(Location)));
+		}
+	}
+
+	if (!bClosedLoop)
+	{
+		OutOutline.Add(FVector2D(SplineTransform.TransformPosition(PositionCurve.Points.Last().OutVal)));
+	}
+
+	return OutOutline.Num() >= 2;
+}
+
+bool UGeometryBlueprintLibrary::UnionSplineOutlines(TArray<FVector2D>& OutPolygon, const TArray<USplineComponent*>& Splines, int32 SamplesPerSegment)
+{
+	OutPolygon.Reset();
+
+	TArray<TArray<FVector2D>> Outlines;
+	for (const USplineComponent* Spline : Splines)
+	{
+		if (Spline != nullptr && Spline->IsClosedLoop())
+		{
+			GetSplineOutline(Outlines.AddDefaulted_GetRef(), Spline, SamplesPerSegment);
+		}
+	}
+
+	TArray<FPolygonWithHoles> MergedPolygons;
+	FPolygonClipping::Union(Outlines, MergedPolygons);
+	if (MergedPolygons.Num() == 0)
+	{
+		return false;
+	}
+
+	int32 LargestPolygon = 0;
+	for (int32 PolygonIndex = 1; PolygonIndex < MergedPolygons.Num(); ++PolygonIndex)
+	{
+		if (FSplineGeometry::GetSignedArea(MergedPolygons[PolygonIndex].Outer) > FSplineGeometry::GetSignedArea(MergedPolygons[LargestPolygon].Outer))
+		{
+			LargestPolygon = PolygonIndex;
+		}
+	}
+
+	FPolygonClipping::MakeKeyholePolygon(MergedPolygons[LargestPolygon], OutPolygon);
+	return MergedPolygons.Num() == 1;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Wall union benchmark
+
+static void BenchmarkWallUnionCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	int32 NumIterations = 10;
+	int32 SamplesPerSegment = 8;
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Iterations="), NumIterations);
+		FParse::Value(*Arg, TEXT("Samples="), SamplesPerSegment);
+	}
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	// The outlines of every closed wall of the table, as they would be merged by the editor
+	const double SampleStartTime = FPlatformTime::Seconds();
+	TArray<TArray<FVector2D>> Outlines;
+	int32 NumInputVertices = 0;
+	float InputArea = 0.0f;
+	for (TActorIterator<AWallActor> It(World); It; ++It)
+	{
+		const USplineComponent* Spline = It->SplineComponent;
+		if (Spline != nullptr && Spline->IsClosedLoop())
+		{
+			TArray<FVector2D>& Outline = Outlines.AddDefaulted_GetRef();
+			UGeometryBlueprintLibrary::GetSplineOutline(Outline, Spline, SamplesPerSegment);
+			NumInputVertices += Outline.Num();
+			InputArea += FMath::Abs(FSplineGeometry::GetSignedArea(Outline));
+		}
+	}
+	const double SampleTime = FPlatformTime::Seconds() - SampleStartTime;
+
+	if (Outlines.Num() == 0)
+	{
+		UE_LOG(LogGeometryBlueprintLibrary, Warning, TEXT("BenchmarkWallUnion: no closed walls in %s"), *World->GetName());
+		return;
+	}
+
+	// Caps as they are now, one per wall
+	int32 NumInputTriangles = 0;
+	TArray<FVector2D> Triangles;
+	for (const TArray<FVector2D>& Outline : Outlines)
+	{
+		if (FGeomTools2D::TriangulatePoly(Triangles, Outline, false))
+		{
+			NumInputTriangles += Triangles.Num() / 3;
+		}
+	}
+
+	TArray<FPolygonWithHoles> MergedPolygons;
+	const double UnionStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FPolygonClipping::Union(Outlines, MergedPolygons);
+	}
+	const double UnionTime = (FPlatformTime::Seconds() - UnionStartTime) / NumIterations;
+
+	// Caps of the merged walls
+	const double TriangulateStartTime = FPlatformTime::Seconds();
+	int32 NumOutputVertices = 0;
+	int32 NumOutputTriangles = 0;
+	int32 NumHoles = 0;
+	int32 NumFailedTriangulations = 0;
+	float OutputArea = 0.0f;
+	TArray<FVector2D> KeyholePolygon;
+	for (const FPolygonWithHoles& MergedPolygon : MergedPolygons)
+	{
+		FPolygonClipping::MakeKeyholePolygon(MergedPolygon, KeyholePolygon);
+		NumOutputVertices += KeyholePolygon.Num();
+		NumHoles += MergedPolygon.Holes.Num();
+		OutputArea += FSplineGeometry::GetSignedArea(KeyholePolygon);
+		if (FGeomTools2D::TriangulatePoly(Triangles, KeyholePolygon, false))
+		{
+			NumOutputTriangles += Triangles.Num() / 3;
+		}
+		else
+		{
+			++NumFailedTriangulations;
+		}
+	}
+	const double TriangulateTime = FPlatformTime::Seconds() - TriangulateStartTime;
+
+	UE_LOG(LogGeometryBlueprintLibrary, Log, TEXT("BenchmarkWallUnion: %d wall(s), %d vertices -> %d merged wall(s) with %d hole(s), %d vertices"),
+		Outlines.Num(), NumInputVertices, MergedPolygons.Num(), NumHoles, NumOutputVertices);
+	UE_LOG(LogGeometryBlueprintLibrary, Log, TEXT("BenchmarkWallUnion: cap triangles %d -> %d, overlapping area removed %.1f (%.1f%%), %d cap(s) failed to triangulate"),
+		NumInputTriangles, NumOutputTriangles, InputArea - OutputArea, (InputArea > 0.0f) ? 100.0f * (InputArea - OutputArea) / InputArea : 0.0f, NumFailedTriangulations);
+	UE_LOG(LogGeometryBlueprintLibrary, Log, TEXT("BenchmarkWallUnion: sampling %.3fms, union %.3fms (average of %d), keyhole and triangulation %.3fms"),
+		SampleTime * 1000.0, UnionTime * 1000.0, NumIterations, TriangulateTime * 1000.0);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkWallUnionConsoleCommand(
+	TEXT("Pinball.BenchmarkWallUnion"),
+	TEXT("Merges the outlines of every closed wall of the current world and logs the time taken and the vertices and cap triangles saved, without changing the walls. Usage: Pinball.BenchmarkWallUnion [Iterations=N] [Samples=SamplesPerSegment]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkWallUnionCommand));
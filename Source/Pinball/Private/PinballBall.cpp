@@ -1,6 +1,14 @@
 // Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
 
 #include "PinballBall.h"
+#include "PinballForceField.h"
+#include "Components/SplineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballBall, Log, All);
 
 APinballBall::APinballBall(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -11,4 +19,222 @@ APinballBall::APinballBall(const FObjectInitializer& ObjectInitializer)
 
 	// Set up forces
 	RollTorque = 50000000.0f;
+
+	BallId = 0;
+	bPooled = false;
+	bPooledBallActive = false;
+
+	BallState = EPinballBallState::Dynamic;
+	SimulatedCollision = ECollisionEnabled::QueryAndPhysics;
+	Path = nullptr;
+	PathSpeed = 0.0f;
+	PathDistance = 0.0f;
+	PathReleaseVelocity = FVector::ZeroVector;
+
+	ForceFields = nullptr;
+	OnCalculateCustomPhysics.BindUObject(this, &APinballBall::ApplyForceFields);
+}
+
+void APinballBall::ActivatePooledBall(const FTransform& Transform, const FVector& Velocity)
+{
+	bPooledBallActive = true;
+
+	// Teleported, a pooled ball must not sweep or carry its velocity from where it was parked
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	ReleaseBall(Velocity);
+}
+
+void APinballBall::DeactivatePooledBall()
+{
+	bPooledBallActive = false;
+
+	if (Ball->IsSimulatingPhysics())
+	{
+		SimulatedCollision = Ball->GetCollisionEnabled();
+	}
+	Path = nullptr;
+	SetBallState(EPinballBallState::Dynamic);
+	Ball->SetSimulatePhysics(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+}
+
+void APinballBall::CaptureBall(FVector Location)
+{
+	StopSimulating();
+	SetActorLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+	Path = nullptr;
+	SetBallState(EPinballBallState::Captured);
+}
+
+void APinballBall::SleepBall()
+{
+	if (BallState != EPinballBallState::Dynamic)
+	{
+		ReleaseBall(FVector::ZeroVector);
+	}
+	Ball->PutRigidBodyToSleep();
+	SetBallState(EPinballBallState::Sleeping);
+}
+
+void APinballBall::MoveBallAlongPath(const USplineComponent* InPath, float Speed, FVector ReleaseVelocity)
+{
+	if (InPath == nullptr || Speed <= 0.0f)
+	{
+		UE_LOG(LogPinballBall, Warning, TEXT("%s: a ball can't be moved along no path or at no speed"), *GetName());
+		return;
+	}
+
+	StopSimulating();
+	Path = InPath;
+	PathSpeed = Speed;
+	PathDistance = 0.0f;
+	PathReleaseVelocity = ReleaseVelocity;
+	SetActorLocation(Path->GetLocationAtDistanceAlongSpline(0.0f, ESplineCoordinateSpace::World), false, nullptr, ETeleportType::TeleportPhysics);
+	SetBallState(EPinballBallState::KinematicPath);
+}
+
+void APinballBall::ReleaseBall(FVector Velocity)
+{
+	Path = nullptr;
+
+	// Velocities set on the body before it simulates again would be lost
+	if (!Ball->IsSimulatingPhysics())
+	{
+		Ball->SetCollisionEnabled(SimulatedCollision);
+		Ball->SetSimulatePhysics(true);
+	}
+	Ball->SetPhysicsLinearVelocity(Velocity);
+	Ball->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+	Ball->WakeRigidBody();
+	SetBallState(EPinballBallState::Dynamic);
+}
+
+int32 APinballBall::GetNumBallsInState(const UObject* WorldContextObject, EPinballBallState State)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (World == nullptr)
+	{
+		return 0;
+	}
+
+	int32 NumBalls = 0;
+	for (TActorIterator<APinballBall> It(World); It; ++It)
+	{
+		if (It->IsInPlay() && It->BallState == State)
+		{
+			++NumBalls;
+		}
+	}
+	return NumBalls;
+}
+
+void APinballBall::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// Fields are applied in every substep of the coming physics step, so they don't depend on the frame rate, sleeping balls aren't woken by them
+	UPinballForceFieldSubsystem* ForceFieldSubsystem = UPinballForceFieldSubsystem::Get(GetWorld());
+	ForceFields = (ForceFieldSubsystem != nullptr) ? &ForceFieldSubsystem->UpdateFields() : nullptr;
+	if (ForceFields != nullptr && ForceFields->Num() > 0 && BallState == EPinballBallState::Dynamic)
+	{
+		Ball->GetBodyInstance()->AddCustomPhysics(OnCalculateCustomPhysics);
+	}
+
+	switch (BallState)
+	{
+	case EPinballBallState::Sleeping:
+		// Woken by a hit
+		if (Ball->RigidBodyIsAwake())
+		{
+			SetBallState(EPinballBallState::Dynamic);
+		}
+		break;
+
+	case EPinballBallState::KinematicPath:
+		if (Path == nullptr)
+		{
+			ReleaseBall(FVector::ZeroVector);
+			break;
+		}
+
+		PathDistance += PathSpeed * DeltaSeconds;
+		if (PathDistance < Path->GetSplineLength())
+		{
+			SetActorLocation(Path->GetLocationAtDistanceAlongSpline(PathDistance, ESplineCoordinateSpace::World), false, nullptr, ETeleportType::TeleportPhysics);
+		}
+		else
+		{
+			// Left exactly at the end, so the release is the same every time
+			const float PathLength = Path->GetSplineLength();
+			const FVector ReleaseVelocity = PathReleaseVelocity.IsZero()
+				? Path->GetDirectionAtDistanceAlongSpline(PathLength, ESplineCoordinateSpace::World) * PathSpeed
+				: PathReleaseVelocity;
+			SetActorLocation(Path->GetLocationAtDistanceAlongSpline(PathLength, ESplineCoordinateSpace::World), false, nullptr, ETeleportType::TeleportPhysics);
+			ReleaseBall(ReleaseVelocity);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void APinballBall::SetBallState(EPinballBallState NewState)
+{
+	if (BallState != NewState)
+	{
+		BallState = NewState;
+		OnBallStateChanged.Broadcast(NewState);
+	}
 }
+
+void APinballBall::ApplyForceFields(float DeltaTime, FBodyInstance* BodyInstance)
+{
+	if (ForceFields == nullptr)
+	{
+		return;
+	}
+
+	const FVector Location = BodyInstance->GetUnrealWorldTransform_AssumesLocked().GetLocation();
+	FVector Acceleration;
+	ForceFields->Evaluate(&Location, 1, &Acceleration);
+	if (!Acceleration.IsNearlyZero())
+	{
+		BodyInstance->AddForce(Acceleration, false, true);
+	}
+}
+
+void APinballBall::StopSimulating()
+{
+	if (Ball->IsSimulatingPhysics())
+	{
+		SimulatedCollision = Ball->GetCollisionEnabled();
+		Ball->SetSimulatePhysics(false);
+	}
+
+	// Out of the solver, but still overlapping the triggers it is moved through
+	Ball->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Ball state report
+
+static void ReportBallsCommand(UWorld* World)
+{
+	const UEnum* BallStateEnum = StaticEnum<EPinballBallState>();
+	for (int32 State = 0; State <= int32(EPinballBallState::KinematicPath); ++State)
+	{
+		UE_LOG(LogPinballBall, Log, TEXT("%s: %d ball(s)"), *BallStateEnum->GetNameStringByValue(State),
+			APinballBall::GetNumBallsInState(World, EPinballBallState(State)));
+	}
+}
+
+static FAutoConsoleCommandWithWorld ReportBallsConsoleCommand(
+	TEXT("Pinball.ReportBalls"),
+	TEXT("Logs how many balls in play are in each state, simulated or not"),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&ReportBallsCommand));
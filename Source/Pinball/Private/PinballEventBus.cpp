@@ -0,0 +1,101 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballEventBus.h"
+
+FPinballEventBus::FPinballEventBus()
+	: Mask(0)
+	, EnqueuePosition(0)
+	, NumDropped(0)
+	, DequeuePosition(0)
+	, HighWaterMark(0)
+	, NumDrained(0)
+{
+}
+
+void FPinballEventBus::Init(int32 InCapacity)
+{
+	const int32 Capacity = int32(FMath::RoundUpToPowerOfTwo(uint32(FMath::Max(InCapacity, 2))));
+
+	// Atomics can't be copied, so the slots are built in place
+	Slots.Empty(Capacity);
+	for (int32 SlotIndex = 0; SlotIndex < Capacity; ++SlotIndex)
+	{
+		FSlot* Slot = new(Slots) FSlot();
+		Slot->Sequence.Store(uint32(SlotIndex), EMemoryOrder::Relaxed);
+	}
+	Mask = uint32(Capacity - 1);
+
+	EnqueuePosition.Store(0, EMemoryOrder::Relaxed);
+	DequeuePosition = 0;
+	HighWaterMark = 0;
+	NumDropped.Store(0, EMemoryOrder::Relaxed);
+	NumDrained = 0;
+}
+
+bool FPinballEventBus::Post(const FPinballHitEvent& Event)
+{
+	if (Slots.Num() == 0)
+	{
+		++NumDropped;
+		return false;
+	}
+
+	// Claim a position whose slot the consumer has released, a slot still a lap behind means the ring is full
+	// The sequence loads and stores are sequentially consistent, the only TAtomic order stronger than relaxed, so they order the event copies around them
+	uint32 Position = EnqueuePosition.Load(EMemoryOrder::Relaxed);
+	FSlot* Slot = nullptr;
+	for (;;)
+	{
+		Slot = &Slots[Position & Mask];
+		const int32 Difference = int32(Slot->Sequence.Load() - Position);
+		if (Difference == 0)
+		{
+			if (EnqueuePosition.CompareExchange(Position, Position + 1))
+			{
+				break;
+			}
+		}
+		else if (Difference < 0)
+		{
+			++NumDropped;
+			return false;
+		}
+		else
+		{
+			Position = EnqueuePosition.Load(EMemoryOrder::Relaxed);
+		}
+	}
+
+	Slot->Event = Event;
+	Slot->Sequence.Store(Position + 1);
+	return true;
+}
+
+int32 FPinballEventBus::Drain(TArray<FPinballHitEvent>& OutEvents)
+{
+	if (Slots.Num() == 0)
+	{
+		return 0;
+	}
+
+	HighWaterMark = FMath::Max(HighWaterMark, GetDepth());
+
+	int32 NumEvents = 0;
+	for (;;)
+	{
+		// Stops at the first slot not written yet, events posted after that are drained next frame
+		FSlot& Slot = Slots[DequeuePosition & Mask];
+		if (int32(Slot.Sequence.Load() - (DequeuePosition + 1)) < 0)
+		{
+			break;
+		}
+
+		OutEvents.Add(Slot.Event);
+		Slot.Sequence.Store(DequeuePosition + Mask + 1);
+		++DequeuePosition;
+		++NumEvents;
+	}
+
+	NumDrained += NumEvents;
+	return NumEvents;
+}
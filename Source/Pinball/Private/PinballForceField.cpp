@@ -0,0 +1,303 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballForceField.h"
+#include "PinballForceFieldComponent.h"
+#include "Engine/World.h"
+#include "Math/VectorRegister.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballForceField, Log, All);
+
+namespace PinballForceFieldDefs
+{
+	/** Fields evaluated together */
+	const int32 FieldsPerRegister = 4;
+
+	/** Squared distance under which a location is at the center of a field */
+	const float MinDistanceSquared = 1.0e-4f;
+}
+
+FPinballForceFieldSet::FPinballForceFieldSet()
+	: NumFields(0)
+{
+}
+
+void FPinballForceFieldSet::Reset()
+{
+	NumFields = 0;
+	for (FFieldArray* Array : { &LocationX, &LocationY, &LocationZ, &RadiusSquared, &InvRadius, &Strength, &RadialWeight,
+		&DirectionX, &DirectionY, &DirectionZ, &AxisX, &AxisY, &AxisZ, &ConstantFalloff, &LinearFalloff, &QuadraticFalloff })
+	{
+		Array->Reset();
+	}
+}
+
+void FPinballForceFieldSet::Add(const FPinballForceField& Field)
+{
+	using namespace PinballForceFieldDefs;
+
+	// A new register of padding fields, none of which ever contains a location
+	if (NumFields % FieldsPerRegister == 0)
+	{
+		for (FFieldArray* Array : { &LocationX, &LocationY, &LocationZ, &RadiusSquared, &InvRadius, &Strength, &RadialWeight,
+			&DirectionX, &DirectionY, &DirectionZ, &AxisX, &AxisY, &AxisZ, &ConstantFalloff, &LinearFalloff, &QuadraticFalloff })
+		{
+			Array->AddZeroed(FieldsPerRegister);
+		}
+	}
+
+	const int32 Index = NumFields++;
+	LocationX[Index] = Field.Location.X;
+	LocationY[Index] = Field.Location.Y;
+	LocationZ[Index] = Field.Location.Z;
+	RadiusSquared[Index] = (Field.Radius > 0.0f) ? FMath::Square(Field.Radius) : MAX_FLT;
+	InvRadius[Index] = (Field.Radius > 0.0f) ? 1.0f / Field.Radius : 0.0f;
+	Strength[Index] = Field.Strength;
+
+	const FVector Direction = Field.Direction.GetSafeNormal();
+	switch (Field.Type)
+	{
+	case EPinballForceFieldType::Radial:
+		RadialWeight[Index] = 1.0f;
+		break;
+	case EPinballForceFieldType::Directional:
+		DirectionX[Index] = Direction.X;
+		DirectionY[Index] = Direction.Y;
+		DirectionZ[Index] = Direction.Z;
+		break;
+	case EPinballForceFieldType::Vortex:
+		AxisX[Index] = Direction.X;
+		AxisY[Index] = Direction.Y;
+		AxisZ[Index] = Direction.Z;
+		break;
+	}
+
+	switch (Field.Falloff)
+	{
+	case EPinballForceFalloff::None:
+		ConstantFalloff[Index] = 1.0f;
+		break;
+	case EPinballForceFalloff::Linear:
+		LinearFalloff[Index] = 1.0f;
+		break;
+	case EPinballForceFalloff::Quadratic:
+		QuadraticFalloff[Index] = 1.0f;
+		break;
+	}
+}
+
+void FPinballForceFieldSet::Evaluate(const FVector* Locations, int32 NumLocations, FVector* OutAccelerations) const
+{
+	using namespace PinballForceFieldDefs;
+
+	const int32 NumPaddedFields = LocationX.Num();
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister One = VectorOne();
+	const VectorRegister MinDistanceSquaredRegister = VectorSetFloat1(MinDistanceSquared);
+
+	for (int32 LocationIndex = 0; LocationIndex < NumLocations; ++LocationIndex)
+	{
+		const VectorRegister X = VectorSetFloat1(Locations[LocationIndex].X);
+		const VectorRegister Y = VectorSetFloat1(Locations[LocationIndex].Y);
+		const VectorRegister Z = VectorSetFloat1(Locations[LocationIndex].Z);
+		VectorRegister AccelerationX = Zero;
+		VectorRegister AccelerationY = Zero;
+		VectorRegister AccelerationZ = Zero;
+
+		for (int32 FieldIndex = 0; FieldIndex < NumPaddedFields; FieldIndex += FieldsPerRegister)
+		{
+			// Towards the center of each field
+			const VectorRegister ToCenterX = VectorSubtract(VectorLoadAligned(&LocationX[FieldIndex]), X);
+			const VectorRegister ToCenterY = VectorSubtract(VectorLoadAligned(&LocationY[FieldIndex]), Y);
+			const VectorRegister ToCenterZ = VectorSubtract(VectorLoadAligned(&LocationZ[FieldIndex]), Z);
+			const VectorRegister DistanceSquared = VectorMultiplyAdd(ToCenterX, ToCenterX, VectorMultiplyAdd(ToCenterY, ToCenterY, VectorMultiply(ToCenterZ, ToCenterZ)));
+			const VectorRegister InsideMask = VectorCompareGT(VectorLoadAligned(&RadiusSquared[FieldIndex]), DistanceSquared);
+			const VectorRegister InvDistance = VectorReciprocalSqrt(VectorMax(DistanceSquared, MinDistanceSquaredRegister));
+			const VectorRegister NormalX = VectorMultiply(ToCenterX, InvDistance);
+			const VectorRegister NormalY = VectorMultiply(ToCenterY, InvDistance);
+			const VectorRegister NormalZ = VectorMultiply(ToCenterZ, InvDistance);
+
+			// Falloff, from 1 at the center to 0 at the radius
+			const VectorRegister Fade = VectorMax(VectorSubtract(One, VectorMultiply(VectorMultiply(DistanceSquared, InvDistance), VectorLoadAligned(&InvRadius[FieldIndex]))), Zero);
+			const VectorRegister Falloff = VectorMultiplyAdd(Fade, VectorMultiplyAdd(Fade, VectorLoadAligned(&QuadraticFalloff[FieldIndex]), VectorLoadAligned(&LinearFalloff[FieldIndex])), VectorLoadAligned(&ConstantFalloff[FieldIndex]));
+			const VectorRegister Scale = VectorSelect(InsideMask, VectorMultiply(Falloff, VectorLoadAligned(&Strength[FieldIndex])), Zero);
+
+			// Radial, directional and vortex parts, all but one of which have no weight
+			const VectorRegister RadialWeightRegister = VectorLoadAligned(&RadialWeight[FieldIndex]);
+			const VectorRegister FieldAxisX = VectorLoadAligned(&AxisX[FieldIndex]);
+			const VectorRegister FieldAxisY = VectorLoadAligned(&AxisY[FieldIndex]);
+			const VectorRegister FieldAxisZ = VectorLoadAligned(&AxisZ[FieldIndex]);
+			const VectorRegister DirectionSumX = VectorAdd(VectorMultiplyAdd(RadialWeightRegister, NormalX, VectorLoadAligned(&DirectionX[FieldIndex])),
+				VectorSubtract(VectorMultiply(NormalY, FieldAxisZ), VectorMultiply(NormalZ, FieldAxisY)));
+			const VectorRegister DirectionSumY = VectorAdd(VectorMultiplyAdd(RadialWeightRegister, NormalY, VectorLoadAligned(&DirectionY[FieldIndex])),
+				VectorSubtract(VectorMultiply(NormalZ, FieldAxisX), VectorMultiply(NormalX, FieldAxisZ)));
+			const VectorRegister DirectionSumZ = VectorAdd(VectorMultiplyAdd(RadialWeightRegister, NormalZ, VectorLoadAligned(&DirectionZ[FieldIndex])),
+				VectorSubtract(VectorMultiply(NormalX, FieldAxisY), VectorMultiply(NormalY, FieldAxisX)));
+
+			AccelerationX = VectorMultiplyAdd(Scale, DirectionSumX, AccelerationX);
+			AccelerationY = VectorMultiplyAdd(Scale, DirectionSumY, AccelerationY);
+			AccelerationZ = VectorMultiplyAdd(Scale, DirectionSumZ, AccelerationZ);
+		}
+
+		MS_ALIGN(16) float SumX[4] GCC_ALIGN(16);
+		MS_ALIGN(16) float SumY[4] GCC_ALIGN(16);
+		MS_ALIGN(16) float SumZ[4] GCC_ALIGN(16);
+		VectorStoreAligned(AccelerationX, SumX);
+		VectorStoreAligned(AccelerationY, SumY);
+		VectorStoreAligned(AccelerationZ, SumZ);
+		OutAccelerations[LocationIndex] = FVector(SumX[0] + SumX[1] + SumX[2] + SumX[3], SumY[0] + SumY[1] + SumY[2] + SumY[3], SumZ[0] + SumZ[1] + SumZ[2] + SumZ[3]);
+	}
+}
+
+void FPinballForceFieldSet::EvaluateScalar(const FVector* Locations, int32 NumLocations, FVector* OutAccelerations) const
+{
+	using namespace PinballForceFieldDefs;
+
+	for (int32 LocationIndex = 0; LocationIndex < NumLocations; ++LocationIndex)
+	{
+		const FVector& Location = Locations[LocationIndex];
+		FVector Acceleration = FVector::ZeroVector;
+
+		for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+		{
+			const FVector ToCenter = FVector(LocationX[FieldIndex], LocationY[FieldIndex], LocationZ[FieldIndex]) - Location;
+			const float DistanceSquared = ToCenter.SizeSquared();
+			if (DistanceSquared >= RadiusSquared[FieldIndex])
+			{
+				continue;
+			}
+
+			const float InvDistance = FMath::InvSqrt(FMath::Max(DistanceSquared, MinDistanceSquared));
+			const FVector Normal = ToCenter * InvDistance;
+			const float Fade = FMath::Max(1.0f - DistanceSquared * InvDistance * InvRadius[FieldIndex], 0.0f);
+			const float Falloff = ConstantFalloff[FieldIndex] + Fade * (LinearFalloff[FieldIndex] + Fade * QuadraticFalloff[FieldIndex]);
+			const FVector Axis(AxisX[FieldIndex], AxisY[FieldIndex], AxisZ[FieldIndex]);
+
+			Acceleration += (Falloff * Strength[FieldIndex]) * (RadialWeight[FieldIndex] * Normal
+				+ FVector(DirectionX[FieldIndex], DirectionY[FieldIndex], DirectionZ[FieldIndex])
+				+ (Normal ^ Axis));
+		}
+
+		OutAccelerations[LocationIndex] = Acceleration;
+	}
+}
+
+UPinballForceFieldSubsystem::UPinballForceFieldSubsystem()
+	: bFieldsDirty(false)
+{
+}
+
+UPinballForceFieldSubsystem* UPinballForceFieldSubsystem::Get(const UWorld* World)
+{
+	return (World != nullptr) ? World->GetSubsystem<UPinballForceFieldSubsystem>() : nullptr;
+}
+
+void UPinballForceFieldSubsystem::RegisterField(UPinballForceFieldComponent* Field)
+{
+	if (Field != nullptr)
+	{
+		FieldComponents.AddUnique(Field);
+		bFieldsDirty = true;
+	}
+}
+
+void UPinballForceFieldSubsystem::UnregisterField(UPinballForceFieldComponent* Field)
+{
+	if (FieldComponents.RemoveSingleSwap(Field) > 0)
+	{
+		bFieldsDirty = true;
+	}
+}
+
+const FPinballForceFieldSet& UPinballForceFieldSubsystem::UpdateFields()
+{
+	if (bFieldsDirty)
+	{
+		bFieldsDirty = false;
+		Fields.Reset();
+		for (const UPinballForceFieldComponent* Field : FieldComponents)
+		{
+			if (Field->IsActive() && Field->Strength != 0.0f)
+			{
+				Fields.Add(Field->GetForceField());
+			}
+		}
+	}
+	return Fields;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+static void BenchmarkForceFieldsCommand(const TArray<FString>& Args)
+{
+	int32 NumBalls = 8;
+	int32 NumFields = 16;
+	int32 NumIterations = 10000;
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Balls="), NumBalls);
+		FParse::Value(*Arg, TEXT("Fields="), NumFields);
+		FParse::Value(*Arg, TEXT("Iterations="), NumIterations);
+	}
+	NumBalls = FMath::Max(NumBalls, 1);
+	NumFields = FMath::Max(NumFields, 1);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	// Fields of every type and falloff over a table, with balls spread over it too
+	FRandomStream Random(NumBalls * NumFields);
+	const FBox TableBounds(FVector(-1000.0f, -500.0f, 0.0f), FVector(1000.0f, 500.0f, 100.0f));
+	FPinballForceFieldSet Fields;
+	for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+	{
+		FPinballForceField Field;
+		Field.Type = EPinballForceFieldType(FieldIndex % 3);
+		Field.Falloff = EPinballForceFalloff((FieldIndex / 3) % 3);
+		Field.Location = Random.RandPointInBox(TableBounds);
+		Field.Direction = Random.GetUnitVector();
+		Field.Strength = Random.FRandRange(-1000.0f, 1000.0f);
+		Field.Radius = Random.FRandRange(100.0f, 800.0f);
+		Fields.Add(Field);
+	}
+
+	TArray<FVector> Locations;
+	for (int32 BallIndex = 0; BallIndex < NumBalls; ++BallIndex)
+	{
+		Locations.Add(Random.RandPointInBox(TableBounds));
+	}
+
+	TArray<FVector> ScalarAccelerations;
+	TArray<FVector> Accelerations;
+	ScalarAccelerations.SetNumUninitialized(NumBalls);
+	Accelerations.SetNumUninitialized(NumBalls);
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		Fields.EvaluateScalar(Locations.GetData(), NumBalls, ScalarAccelerations.GetData());
+	}
+	const double ScalarTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		Fields.Evaluate(Locations.GetData(), NumBalls, Accelerations.GetData());
+	}
+	const double VectorTime = FPlatformTime::Seconds() - StartTime;
+
+	float MaxError = 0.0f;
+	for (int32 BallIndex = 0; BallIndex < NumBalls; ++BallIndex)
+	{
+		MaxError = FMath::Max(MaxError, (Accelerations[BallIndex] - ScalarAccelerations[BallIndex]).Size());
+	}
+
+	const double NumPairs = double(NumBalls) * NumFields * NumIterations;
+	UE_LOG(LogPinballForceField, Log, TEXT("BenchmarkForceFields: %d ball(s) x %d field(s), %d iteration(s)"), NumBalls, NumFields, NumIterations);
+	UE_LOG(LogPinballForceField, Log, TEXT("BenchmarkForceFields: scalar %.3fms, %.2fns per ball and field"), ScalarTime * 1000.0, ScalarTime * 1.0e9 / NumPairs);
+	UE_LOG(LogPinballForceField, Log, TEXT("BenchmarkForceFields: vectorized %.3fms, %.2fns per ball and field, %.2fx faster, %.4f cm/s^2 max difference"),
+		VectorTime * 1000.0, VectorTime * 1.0e9 / NumPairs, (VectorTime > 0.0) ? ScalarTime / VectorTime : 0.0, MaxError);
+}
+
+static FAutoConsoleCommand BenchmarkForceFieldsConsoleCommand(
+	TEXT("Pinball.BenchmarkForceFields"),
+	TEXT("Evaluates random force fields for random balls, one field at a time then four at a time, and logs the cost of each. Usage: Pinball.BenchmarkForceFields [Balls=N] [Fields=N] [Iterations=N]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkForceFieldsCommand));
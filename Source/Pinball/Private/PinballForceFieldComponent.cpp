@@ -0,0 +1,97 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballForceFieldComponent.h"
+#include "Engine/World.h"
+
+namespace PinballForceFieldComponentDefs
+{
+	const float DefaultStrength = 500.0f;
+	const float DefaultRadius = 200.0f;
+}
+
+UPinballForceFieldComponent::UPinballForceFieldComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Type(EPinballForceFieldType::Radial)
+	, Falloff(EPinballForceFalloff::Linear)
+	, Strength(PinballForceFieldComponentDefs::DefaultStrength)
+	, Radius(PinballForceFieldComponentDefs::DefaultRadius)
+{
+	// Evaluated by the balls, it never ticks
+	bAutoActivate = true;
+}
+
+void UPinballForceFieldComponent::SetStrength(float NewStrength)
+{
+	if (Strength != NewStrength)
+	{
+		Strength = NewStrength;
+		MarkFieldsDirty();
+	}
+}
+
+void UPinballForceFieldComponent::SetRadius(float NewRadius)
+{
+	if (Radius != NewRadius)
+	{
+		Radius = NewRadius;
+		MarkFieldsDirty();
+	}
+}
+
+FPinballForceField UPinballForceFieldComponent::GetForceField() const
+{
+	FPinballForceField Field;
+	Field.Type = Type;
+	Field.Falloff = Falloff;
+	Field.Location = GetComponentLocation();
+	Field.Direction = (Type == EPinballForceFieldType::Vortex) ? GetUpVector() : GetForwardVector();
+	Field.Strength = Strength;
+	Field.Radius = Radius;
+	return Field;
+}
+
+void UPinballForceFieldComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (UPinballForceFieldSubsystem* Subsystem = UPinballForceFieldSubsystem::Get(GetWorld()))
+	{
+		Subsystem->RegisterField(this);
+	}
+}
+
+void UPinballForceFieldComponent::OnUnregister()
+{
+	if (UPinballForceFieldSubsystem* Subsystem = UPinballForceFieldSubsystem::Get(GetWorld()))
+	{
+		Subsystem->UnregisterField(this);
+	}
+
+	Super::OnUnregister();
+}
+
+void UPinballForceFieldComponent::Activate(bool bReset)
+{
+	Super::Activate(bReset);
+	MarkFieldsDirty();
+}
+
+void UPinballForceFieldComponent::Deactivate()
+{
+	Super::Deactivate();
+	MarkFieldsDirty();
+}
+
+void UPinballForceFieldComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+	MarkFieldsDirty();
+}
+
+void UPinballForceFieldComponent::MarkFieldsDirty()
+{
+	if (UPinballForceFieldSubsystem* Subsystem = UPinballForceFieldSubsystem::Get(GetWorld()))
+	{
+		Subsystem->MarkFieldsDirty();
+	}
+}
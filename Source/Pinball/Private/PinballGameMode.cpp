@@ -2,10 +2,249 @@
 
 #include "PinballGameMode.h"
 #include "PinballBall.h"
+#include "PinballScoreComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballGameMode, Log, All);
+
+namespace PinballGameModeDefs
+{
+	/** Enough for every element to be hit a few times in a frame of multiball */
+	const int32 DefaultEventBusCapacity = 1024;
+
+	/** Enough for the biggest multiball and a ball save */
+	const int32 DefaultBallPoolSize = 6;
+
+	/** Where pooled balls wait off the table */
+	const FVector PooledBallLocation(0.0f, 0.0f, -100000.0f);
+}
 
 APinballGameMode::APinballGameMode(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, EventBusCapacity(PinballGameModeDefs::DefaultEventBusCapacity)
+	, bUseBallPool(true)
+	, BallPoolSize(PinballGameModeDefs::DefaultBallPoolSize)
+	, NextBallId(1)
 {
 	// set default pawn class to our ball
 	DefaultPawnClass = APinballBall::StaticClass();
+
+	ScoreComponent = CreateDefaultSubobject<UPinballScoreComponent>(TEXT("ScoreComponent"));
+
+	// Hit events are drained once the physics of the frame has posted them
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+}
+
+int32 APinballGameMode::RegisterElement(UObject* Element)
+{
+	if (Element == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 ElementId = Elements.Find(Element);
+	return (ElementId != INDEX_NONE) ? ElementId : Elements.Add(Element);
+}
+
+UObject* APinballGameMode::GetElement(int32 ElementId) const
+{
+	return Elements.IsValidIndex(ElementId) ? Elements[ElementId] : nullptr;
+}
+
+bool APinballGameMode::PostHitEvent(int32 ElementId, EPinballHitType Type, uint8 BallId, float Time)
+{
+	FPinballHitEvent Event;
+	Event.Time = (Time >= 0.0f) ? Time : GetWorld()->GetTimeSeconds();
+	Event.ElementId = ElementId;
+	Event.BallId = BallId;
+	Event.Type = Type;
+	return EventBus.Post(Event);
+}
+
+APinballBall* APinballGameMode::AcquireBall(const FTransform& Transform, FVector Velocity)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	APinballBall* Ball = nullptr;
+	if (bUseBallPool)
+	{
+		Ball = (FreeBalls.Num() > 0) ? FreeBalls.Pop(false) : SpawnPooledBall();
+	}
+	else
+	{
+		// What multiball used to do, a ball spawned on the table and destroyed when drained
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Ball = GetWorld()->SpawnActor<APinballBall>(*ExtraBallClass, Transform, SpawnParameters);
+		if (Ball != nullptr)
+		{
+			AssignBallId(Ball);
+			Ball->GetBall()->SetPhysicsLinearVelocity(Velocity);
+			++BallPoolStats.NumSpawned;
+		}
+	}
+
+	if (Ball != nullptr && Ball->IsPooled())
+	{
+		Ball->ActivatePooledBall(Transform, Velocity);
+	}
+
+	const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+	++BallPoolStats.NumAcquired;
+	BallPoolStats.AcquireSeconds += Seconds;
+	BallPoolStats.MaxAcquireSeconds = FMath::Max(BallPoolStats.MaxAcquireSeconds, Seconds);
+	return Ball;
+}
+
+void APinballGameMode::ReleaseBall(APinballBall* Ball)
+{
+	if (Ball == nullptr || !Ball->IsInPlay())
+	{
+		return;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// Possessed balls are the player's, they are never pooled
+	if (Ball->IsPooled())
+	{
+		Ball->DeactivatePooledBall();
+		Ball->SetActorLocation(PinballGameModeDefs::PooledBallLocation, false, nullptr, ETeleportType::ResetPhysics);
+		FreeBalls.Push(Ball);
+	}
+	else if (Ball->GetController() == nullptr)
+	{
+		Ball->Destroy();
+	}
+
+	const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+	++BallPoolStats.NumReleased;
+	BallPoolStats.ReleaseSeconds += Seconds;
+	BallPoolStats.MaxReleaseSeconds = FMath::Max(BallPoolStats.MaxReleaseSeconds, Seconds);
 }
+
+APinballBall* APinballGameMode::SpawnPooledBall()
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APinballBall* Ball = GetWorld()->SpawnActor<APinballBall>(*ExtraBallClass, PinballGameModeDefs::PooledBallLocation, FRotator::ZeroRotator, SpawnParameters);
+	if (Ball != nullptr)
+	{
+		AssignBallId(Ball);
+		Ball->bPooled = true;
+		Ball->DeactivatePooledBall();
+		++BallPoolStats.NumSpawned;
+	}
+	return Ball;
+}
+
+void APinballGameMode::AssignBallId(APinballBall* Ball)
+{
+	Ball->BallId = NextBallId;
+	NextBallId = (NextBallId == MAX_uint8) ? 1 : NextBallId + 1;
+}
+
+void APinballGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ExtraBallClass == nullptr)
+	{
+		ExtraBallClass = (DefaultPawnClass != nullptr && DefaultPawnClass->IsChildOf<APinballBall>()) ? *DefaultPawnClass : APinballBall::StaticClass();
+	}
+
+	// All the balls a game needs are created now rather than when multiball starts
+	if (bUseBallPool)
+	{
+		FreeBalls.Reserve(BallPoolSize);
+		for (int32 BallIndex = 0; BallIndex < BallPoolSize; ++BallIndex)
+		{
+			if (APinballBall* Ball = SpawnPooledBall())
+			{
+				FreeBalls.Push(Ball);
+			}
+		}
+		ResetBallPoolStats();
+	}
+}
+
+void APinballGameMode::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	EventBus.Init(EventBusCapacity);
+}
+
+void APinballGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	DrainedEvents.Reset();
+	if (EventBus.Drain(DrainedEvents) > 0)
+	{
+		OnNativeHitEvents.Broadcast(DrainedEvents);
+		OnHitEvents.Broadcast(DrainedEvents);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Ball pool benchmark
+
+static void BenchmarkBallPoolCommand(const TArray<FString>& Args, UWorld* World)
+{
+	APinballGameMode* GameMode = (World != nullptr) ? World->GetAuthGameMode<APinballGameMode>() : nullptr;
+	if (GameMode == nullptr)
+	{
+		UE_LOG(LogPinballGameMode, Warning, TEXT("BenchmarkBallPool: needs a game running a pinball game mode"));
+		return;
+	}
+
+	int32 NumBalls = 4;
+	int32 NumRounds = 20;
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Balls="), NumBalls);
+		FParse::Value(*Arg, TEXT("Rounds="), NumRounds);
+	}
+	NumBalls = FMath::Max(NumBalls, 1);
+	NumRounds = FMath::Max(NumRounds, 1);
+
+	// Multiball starts and drains, spawning and destroying balls then using the pool
+	const bool bWasUsingBallPool = GameMode->bUseBallPool;
+	const FTransform Transform(PinballGameModeDefs::PooledBallLocation + FVector(0.0f, 0.0f, 1000.0f));
+	for (const bool bUseBallPool : { false, true })
+	{
+		GameMode->bUseBallPool = bUseBallPool;
+		GameMode->ResetBallPoolStats();
+
+		TArray<APinballBall*> Balls;
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			for (int32 BallIndex = 0; BallIndex < NumBalls; ++BallIndex)
+			{
+				Balls.Add(GameMode->AcquireBall(Transform, FVector::ZeroVector));
+			}
+			for (APinballBall* Ball : Balls)
+			{
+				GameMode->ReleaseBall(Ball);
+			}
+			Balls.Reset();
+		}
+
+		const FPinballBallPoolStats& Stats = GameMode->GetBallPoolStats();
+		UE_LOG(LogPinballGameMode, Log, TEXT("BenchmarkBallPool: %s, %d ball(s) x %d round(s), %d spawned, acquire %.3fms average %.3fms max, release %.3fms average %.3fms max"),
+			bUseBallPool ? TEXT("pooled") : TEXT("spawned"), NumBalls, NumRounds, Stats.NumSpawned,
+			Stats.AcquireSeconds * 1000.0 / FMath::Max(Stats.NumAcquired, 1), Stats.MaxAcquireSeconds * 1000.0,
+			Stats.ReleaseSeconds * 1000.0 / FMath::Max(Stats.NumReleased, 1), Stats.MaxReleaseSeconds * 1000.0);
+	}
+
+	GameMode->bUseBallPool = bWasUsingBallPool;
+	GameMode->ResetBallPoolStats();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkBallPoolConsoleCommand(
+	TEXT("Pinball.BenchmarkBallPool"),
+	TEXT("Starts and drains multiballs with balls spawned and destroyed, then with pooled balls, and logs the time taken to acquire and release a ball. Usage: Pinball.BenchmarkBallPool [Balls=N] [Rounds=N]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkBallPoolCommand));
@@ -0,0 +1,59 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballGateComponent.h"
+#include "PinballBall.h"
+#include "Components/StaticMeshComponent.h"
+
+namespace PinballGateComponentDefs
+{
+	const float DefaultMaxOpenAngle = 100.0f;
+	const float DefaultStopRestitution = 0.2f;
+	const float DefaultBlockedRestitution = 0.5f;
+}
+
+UPinballGateComponent::UPinballGateComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, MaxOpenAngle(PinballGateComponentDefs::DefaultMaxOpenAngle)
+	, StopRestitution(PinballGateComponentDefs::DefaultStopRestitution)
+	, BlockedRestitution(PinballGateComponentDefs::DefaultBlockedRestitution)
+{
+}
+
+void UPinballGateComponent::OnBallCrossing(APinballBall* Ball, float CrossingSpeed)
+{
+	if (CrossingSpeed > 0.0f)
+	{
+		// Only pushes the flap open, a ball slower than the flap already opening doesn't hold it back
+		if (CrossingSpeed > AngularVelocity * FlapLength)
+		{
+			ApplyBallImpulse(Ball, CrossingSpeed);
+		}
+		WakeFlap();
+		PostElementEvent(EPinballHitType::Gate, Ball->GetBallId());
+		OnGatePassed.Broadcast();
+	}
+	else if (CrossingSpeed < 0.0f && Ball->GetBallState() == EPinballBallState::Dynamic)
+	{
+		// The closed side, the ball bounces back off it along the X axis of the box
+		UStaticMeshComponent* BallComponent = Ball->GetBall();
+		const FVector CrossingVelocity = CrossingSpeed * GetForwardVector();
+		BallComponent->SetPhysicsLinearVelocity(BallComponent->GetPhysicsLinearVelocity() - (1.0f + BlockedRestitution) * CrossingVelocity);
+		WakeFlap();
+	}
+}
+
+void UPinballGateComponent::OnStepped()
+{
+	// Between the closed stop and the open one, bouncing off each
+	const float MaxAngle = FMath::DegreesToRadians(MaxOpenAngle);
+	if (Angle < 0.0f)
+	{
+		Angle = 0.0f;
+		AngularVelocity = (AngularVelocity < 0.0f) ? -AngularVelocity * StopRestitution : AngularVelocity;
+	}
+	else if (Angle > MaxAngle)
+	{
+		Angle = MaxAngle;
+		AngularVelocity = (AngularVelocity > 0.0f) ? -AngularVelocity * StopRestitution : AngularVelocity;
+	}
+}
@@ -0,0 +1,172 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballHingeComponent.h"
+#include "PinballBall.h"
+#include "PinballGameMode.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+
+namespace PinballHingeComponentDefs
+{
+	const float DefaultFlapLength = 20.0f;
+	const float DefaultFlapInertiaRatio = 0.5f;
+	const float DefaultRestitution = 0.3f;
+	const float DefaultDamping = 1.5f;
+	const float DefaultRestoringStiffness = 60.0f;
+
+	/** The angle is stepped at this rate whatever the frame rate */
+	const float StepTime = 1.0f / 240.0f;
+
+	/** Steps in one update at most, after a hitch the rest of the time is dropped */
+	const int32 MaxStepsPerUpdate = 120;
+
+	/** The flap sleeps under these angle and angular velocity */
+	const float SleepAngle = 0.01f;
+	const float SleepAngularVelocity = 0.05f;
+}
+
+UPinballHingeComponent::UPinballHingeComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, FlapComponent(nullptr)
+	, FlapLength(PinballHingeComponentDefs::DefaultFlapLength)
+	, FlapInertiaRatio(PinballHingeComponentDefs::DefaultFlapInertiaRatio)
+	, Restitution(PinballHingeComponentDefs::DefaultRestitution)
+	, Damping(PinballHingeComponentDefs::DefaultDamping)
+	, RestoringStiffness(PinballHingeComponentDefs::DefaultRestoringStiffness)
+	, Angle(0.0f)
+	, AngularVelocity(0.0f)
+	, StepEndTime(0.0f)
+	, ImpulseBallId(0)
+	, StepTimeRemainder(0.0f)
+	, FlapRestRotation(FQuat::Identity)
+	, ElementId(INDEX_NONE)
+{
+	// Only overlaps balls, the flap is moved by the tick manager while it turns
+	SetCollisionProfileName(TEXT("Trigger"));
+	SetGenerateOverlapEvents(true);
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UPinballHingeComponent::UpdateElement(float DeltaTime)
+{
+	using namespace PinballHingeComponentDefs;
+
+	// Damping and the restoring acceleration integrated semi-implicitly, the same steps for the same time
+	const float DampingFactor = FMath::Exp(-Damping * StepTime);
+	// The steps pick up from the time the last update left unstepped
+	StepEndTime = GetWorld()->GetTimeSeconds() - DeltaTime - StepTimeRemainder;
+	StepTimeRemainder += DeltaTime;
+	int32 NumSteps = FMath::Min(FMath::FloorToInt(StepTimeRemainder / StepTime), MaxStepsPerUpdate);
+	StepTimeRemainder = (NumSteps < MaxStepsPerUpdate) ? StepTimeRemainder - NumSteps * StepTime : 0.0f;
+	for (; NumSteps > 0; --NumSteps)
+	{
+		AngularVelocity = AngularVelocity * DampingFactor - RestoringStiffness * FMath::Sin(Angle) * StepTime;
+		Angle += AngularVelocity * StepTime;
+		StepEndTime += StepTime;
+		OnStepped();
+	}
+
+	if (FlapComponent != nullptr)
+	{
+		// Turned around the Y axis of the box, which the rest rotation of the flap may not line up with
+		FlapComponent->SetRelativeRotation(FQuat(FVector::RightVector, Angle) * FlapRestRotation);
+	}
+
+	if (FMath::Abs(Angle) < SleepAngle && FMath::Abs(AngularVelocity) < SleepAngularVelocity)
+	{
+		Angle = 0.0f;
+		AngularVelocity = 0.0f;
+		StepTimeRemainder = 0.0f;
+		if (FlapComponent != nullptr)
+		{
+			FlapComponent->SetRelativeRotation(FlapRestRotation);
+		}
+
+		if (UPinballTickManager* TickManager = UPinballTickManager::Get(GetWorld()))
+		{
+			TickManager->SleepElement(this);
+		}
+	}
+}
+
+void UPinballHingeComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (FlapComponent == nullptr && GetNumChildrenComponents() > 0)
+	{
+		FlapComponent = GetChildComponent(0);
+	}
+	if (FlapComponent != nullptr)
+	{
+		FlapRestRotation = FlapComponent->GetRelativeRotation().Quaternion();
+	}
+}
+
+void UPinballHingeComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnComponentBeginOverlap.AddDynamic(this, &UPinballHingeComponent::OnBeginOverlap);
+
+	if (APinballGameMode* GameMode = GetWorld()->GetAuthGameMode<APinballGameMode>())
+	{
+		ElementId = GameMode->RegisterElement(GetOwner());
+	}
+
+	// Hanging still until a ball crosses
+	if (UPinballTickManager* TickManager = UPinballTickManager::Get(GetWorld()))
+	{
+		TickManager->RegisterElement(this);
+		TickManager->SleepElement(this);
+	}
+}
+
+void UPinballHingeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPinballTickManager* TickManager = UPinballTickManager::Get(GetWorld()))
+	{
+		TickManager->UnregisterElement(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+float UPinballHingeComponent::ApplyBallImpulse(const APinballBall* Ball, float CrossingSpeed)
+{
+	ImpulseBallId = Ball->GetBallId();
+
+	// Hit of the ball on the flap at the flap length, with the speed of the flap there taken away
+	const float RelativeSpeed = CrossingSpeed - AngularVelocity * FlapLength;
+	const float DeltaAngularVelocity = (1.0f + Restitution) * RelativeSpeed / (FlapLength * (1.0f + FlapInertiaRatio));
+	AngularVelocity += DeltaAngularVelocity;
+	return DeltaAngularVelocity;
+}
+
+void UPinballHingeComponent::PostElementEvent(EPinballHitType Type, uint8 BallId, float Time)
+{
+	if (APinballGameMode* GameMode = GetWorld()->GetAuthGameMode<APinballGameMode>())
+	{
+		GameMode->PostHitEvent(ElementId, Type, BallId, Time);
+	}
+}
+
+void UPinballHingeComponent::WakeFlap()
+{
+	if (UPinballTickManager* TickManager = UPinballTickManager::Get(GetWorld()))
+	{
+		TickManager->NoteElementActivity(this);
+	}
+}
+
+void UPinballHingeComponent::OnBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	APinballBall* Ball = Cast<APinballBall>(OtherActor);
+	if (Ball == nullptr || OtherComp != Ball->GetBall())
+	{
+		return;
+	}
+
+	const float CrossingSpeed = FVector::DotProduct(Ball->GetBall()->GetPhysicsLinearVelocity(), GetForwardVector());
+	OnBallCrossing(Ball, CrossingSpeed);
+}
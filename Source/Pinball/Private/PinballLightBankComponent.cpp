@@ -0,0 +1,215 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballLightBankComponent.h"
+#include "PinballPartBatchActor.h"
+
+UPinballLightBankComponent::UPinballLightBankComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, NumDirtyLights(0)
+	, NumLightUploads(0)
+{
+	NumCustomDataFloats = EPinballPartCustomData::Num;
+
+	// Lights rarely all change in one frame, this mostly upload nothing
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+	bTickInEditor = true;
+}
+
+int32 UPinballLightBankComponent::AddLight(const FTransform& LightTransform, FName LightName, FLinearColor Color, float Intensity, bool bOn)
+{
+	const int32 LightIndex = AddInstance(LightTransform);
+
+	// Instances and lights can only get out of step if the instances were edited directly
+	Lights.SetNum(FMath::Max(Lights.Num(), LightIndex + 1));
+	FPinballLight& Light = Lights[LightIndex];
+	Light.Name = LightName;
+	Light.Color = Color;
+	Light.Intensity = Intensity;
+	Light.bOn = bOn;
+
+	MarkLightDirty(LightIndex);
+	return LightIndex;
+}
+
+bool UPinballLightBankComponent::RemoveLight(int32 LightIndex)
+{
+	if (!Lights.IsValidIndex(LightIndex) || !RemoveInstance(LightIndex))
+	{
+		return false;
+	}
+
+	// Instances after it shift down along with their custom data
+	Lights.RemoveAt(LightIndex);
+	DirtyLights.Init(false, Lights.Num());
+	NumDirtyLights = 0;
+	UploadLights(true);
+	return true;
+}
+
+int32 UPinballLightBankComponent::FindLight(FName LightName) const
+{
+	return Lights.IndexOfByPredicate([LightName](const FPinballLight& Light)
+	{
+		return Light.Name == LightName;
+	});
+}
+
+bool UPinballLightBankComponent::IsLightOn(int32 LightIndex) const
+{
+	return Lights.IsValidIndex(LightIndex) && Lights[LightIndex].bOn;
+}
+
+void UPinballLightBankComponent::SetLightOn(int32 LightIndex, bool bOn)
+{
+	if (Lights.IsValidIndex(LightIndex) && Lights[LightIndex].bOn != bOn)
+	{
+		Lights[LightIndex].bOn = bOn;
+		MarkLightDirty(LightIndex);
+	}
+}
+
+void UPinballLightBankComponent::SetLightIntensity(int32 LightIndex, float Intensity)
+{
+	if (Lights.IsValidIndex(LightIndex) && Lights[LightIndex].Intensity != Intensity)
+	{
+		Lights[LightIndex].Intensity = Intensity;
+		MarkLightDirty(LightIndex);
+	}
+}
+
+void UPinballLightBankComponent::SetLightColor(int32 LightIndex, FLinearColor Color)
+{
+	if (Lights.IsValidIndex(LightIndex) && Lights[LightIndex].Color != Color)
+	{
+		Lights[LightIndex].Color = Color;
+		MarkLightDirty(LightIndex);
+	}
+}
+
+void UPinballLightBankComponent::SetLight(int32 LightIndex, bool bOn, float Intensity, FLinearColor Color)
+{
+	if (!Lights.IsValidIndex(LightIndex))
+	{
+		return;
+	}
+
+	FPinballLight& Light = Lights[LightIndex];
+	if (Light.bOn != bOn || Light.Intensity != Intensity || Light.Color != Color)
+	{
+		Light.bOn = bOn;
+		Light.Intensity = Intensity;
+		Light.Color = Color;
+		MarkLightDirty(LightIndex);
+	}
+}
+
+void UPinballLightBankComponent::SetAllLightsOn(bool bOn)
+{
+	for (int32 LightIndex = 0; LightIndex < Lights.Num(); ++LightIndex)
+	{
+		SetLightOn(LightIndex, bOn);
+	}
+}
+
+void UPinballLightBankComponent::FlushLights()
+{
+	if (NumDirtyLights > 0)
+	{
+		UploadLights(false);
+	}
+}
+
+void UPinballLightBankComponent::OnRegister()
+{
+	// Lights may have been edited or loaded without their custom data
+	UploadLights(true);
+
+	Super::OnRegister();
+}
+
+void UPinballLightBankComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushLights();
+	SetComponentTickEnabled(false);
+}
+
+#if WITH_EDITOR
+void UPinballLightBankComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UPinballLightBankComponent, Lights))
+	{
+		UploadLights(true);
+	}
+}
+#endif
+
+void UPinballLightBankComponent::MarkLightDirty(int32 LightIndex)
+{
+	if (DirtyLights.Num() < Lights.Num())
+	{
+		DirtyLights.Add(false, Lights.Num() - DirtyLights.Num());
+	}
+
+	if (DirtyLights[LightIndex])
+	{
+		return;
+	}
+	DirtyLights[LightIndex] = true;
+	++NumDirtyLights;
+
+	// The first change of the frame schedules the upload, without a tick it is done straight away, and an unregistered bank uploads everything once registered
+	if (!IsRegistered())
+	{
+		return;
+	}
+	else if (!PrimaryComponentTick.IsTickFunctionRegistered())
+	{
+		UploadLights(false);
+	}
+	else if (NumDirtyLights == 1)
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UPinballLightBankComponent::UploadLights(bool bAllLights)
+{
+	const int32 NumLights = FMath::Min(Lights.Num(), PerInstanceSMData.Num());
+
+	// Written straight into the custom data, the render state is only marked dirty once for all the changed lights
+	PerInstanceSMCustomData.SetNumZeroed(PerInstanceSMData.Num() * NumCustomDataFloats);
+	if (NumCustomDataFloats >= EPinballPartCustomData::Num)
+	{
+		for (int32 LightIndex = 0; LightIndex < NumLights; ++LightIndex)
+		{
+			if (!bAllLights && !(DirtyLights.IsValidIndex(LightIndex) && DirtyLights[LightIndex]))
+			{
+				continue;
+			}
+
+			const FPinballLight& Light = Lights[LightIndex];
+			float* CustomData = &PerInstanceSMCustomData[LightIndex * NumCustomDataFloats];
+			CustomData[EPinballPartCustomData::ColorR] = Light.Color.R;
+			CustomData[EPinballPartCustomData::ColorG] = Light.Color.G;
+			CustomData[EPinballPartCustomData::ColorB] = Light.Color.B;
+			CustomData[EPinballPartCustomData::State] = Light.bOn ? Light.Intensity : 0.0f;
+		}
+	}
+
+	DirtyLights.Init(false, Lights.Num());
+	NumDirtyLights = 0;
+	++NumLightUploads;
+
+	if (IsRegistered())
+	{
+		// The scene proxy only rebuilds its instance data when the command buffer was edited, as SetCustomDataValue does
+		InstanceUpdateCmdBuffer.Edit();
+		MarkRenderStateDirty();
+	}
+}
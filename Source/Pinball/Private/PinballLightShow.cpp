@@ -0,0 +1,224 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballLightShow.h"
+#include "PinballLightBankComponent.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballLightShow, Log, All);
+
+UPinballLightShow::UPinballLightShow(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Duration(0.0f)
+{
+}
+
+int32 FPinballCompiledLightShow::Compile(const UPinballLightShow& Show, const UPinballLightBankComponent& LightBank, FPinballCompiledLightShow& OutCompiledShow)
+{
+	struct FKey
+	{
+		float Time;
+		FPinballLightShowValue Value;
+	};
+
+	TArray<FKey> Keys;
+	int32 NumMissingLights = 0;
+	for (const FPinballLightShowTrack& Track : Show.Tracks)
+	{
+		for (int32 LightNumber = 0; LightNumber < Track.LightNames.Num(); ++LightNumber)
+		{
+			const int32 LightIndex = LightBank.FindLight(Track.LightNames[LightNumber]);
+			if (LightIndex == INDEX_NONE)
+			{
+				++NumMissingLights;
+				continue;
+			}
+
+			const float LightTimeOffset = LightNumber * Track.LightDelay;
+			for (const FPinballLightShowKeyframe& Keyframe : Track.Keyframes)
+			{
+				FKey& Key = Keys.AddDefaulted_GetRef();
+				Key.Time = FMath::Max(Keyframe.Time + LightTimeOffset, 0.0f);
+				Key.Value.Color = Keyframe.Color;
+				Key.Value.Intensity = Keyframe.Intensity;
+				Key.Value.LightIndex = LightIndex;
+				Key.Value.bOn = Keyframe.bOn;
+			}
+		}
+	}
+
+	// Keys at the same time keep their authored order, so later tracks override earlier ones
+	Keys.StableSort([](const FKey& A, const FKey& B)
+	{
+		return A.Time < B.Time;
+	});
+
+	OutCompiledShow.KeyTimes.Reset(Keys.Num());
+	OutCompiledShow.KeyValues.Reset(Keys.Num());
+	for (const FKey& Key : Keys)
+	{
+		OutCompiledShow.KeyTimes.Add(Key.Time);
+		OutCompiledShow.KeyValues.Add(Key.Value);
+	}
+	OutCompiledShow.Duration = FMath::Max(Show.Duration, (Keys.Num() > 0) ? Keys.Last().Time : 0.0f);
+
+	if (NumMissingLights > 0)
+	{
+		UE_LOG(LogPinballLightShow, Warning, TEXT("%s: %d light(s) not found in %s"), *Show.GetName(), NumMissingLights, *LightBank.GetPathName());
+	}
+	return NumMissingLights;
+}
+
+int32 FPinballLightSequencer::Play(const TSharedRef<const FPinballCompiledLightShow>& Show, bool bLoop, float PlayRate)
+{
+	FActiveShow& ActiveShow = ActiveShows.Emplace_GetRef(FActiveShow{ Show });
+	ActiveShow.Time = 0.0f;
+	ActiveShow.PlayRate = FMath::Max(PlayRate, 0.0f);
+	ActiveShow.Cursor = 0;
+	ActiveShow.Handle = NextHandle++;
+	ActiveShow.bLoop = bLoop;
+	return ActiveShow.Handle;
+}
+
+void FPinballLightSequencer::Stop(int32 Handle)
+{
+	ActiveShows.RemoveAll([Handle](const FActiveShow& ActiveShow)
+	{
+		return ActiveShow.Handle == Handle;
+	});
+}
+
+bool FPinballLightSequencer::IsPlaying(int32 Handle) const
+{
+	return ActiveShows.ContainsByPredicate([Handle](const FActiveShow& ActiveShow)
+	{
+		return ActiveShow.Handle == Handle;
+	});
+}
+
+int32 FPinballLightSequencer::Advance(float DeltaTime, UPinballLightBankComponent& LightBank)
+{
+	int32 NumAppliedKeys = 0;
+	for (int32 ShowIndex = 0; ShowIndex < ActiveShows.Num();)
+	{
+		FActiveShow& ActiveShow = ActiveShows[ShowIndex];
+		const FPinballCompiledLightShow& Show = *ActiveShow.Show;
+		const float* KeyTimes = Show.KeyTimes.GetData();
+		const FPinballLightShowValue* KeyValues = Show.KeyValues.GetData();
+		const int32 NumKeys = Show.KeyTimes.Num();
+
+		ActiveShow.Time += DeltaTime * ActiveShow.PlayRate;
+
+		bool bFinished = false;
+		for (;;)
+		{
+			// Keys are sorted, so the ones due this frame are the ones between the cursor and the current time
+			const float EndTime = FMath::Min(ActiveShow.Time, Show.Duration);
+			for (; ActiveShow.Cursor < NumKeys && KeyTimes[ActiveShow.Cursor] <= EndTime; ++ActiveShow.Cursor)
+			{
+				const FPinballLightShowValue& Value = KeyValues[ActiveShow.Cursor];
+				LightBank.SetLight(Value.LightIndex, Value.bOn, Value.Intensity, Value.Color);
+				++NumAppliedKeys;
+			}
+
+			if (ActiveShow.Time < Show.Duration)
+			{
+				break;
+			}
+			else if (!ActiveShow.bLoop || Show.Duration <= 0.0f)
+			{
+				bFinished = true;
+				break;
+			}
+
+			// A frame longer than the show only plays it through once more
+			ActiveShow.Time = FMath::Fmod(ActiveShow.Time - Show.Duration, Show.Duration);
+			ActiveShow.Cursor = 0;
+		}
+
+		if (bFinished)
+		{
+			ActiveShows.RemoveAt(ShowIndex);
+		}
+		else
+		{
+			++ShowIndex;
+		}
+	}
+	return NumAppliedKeys;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+static void BenchmarkLightShowsCommand(const TArray<FString>& Args)
+{
+	int32 NumShows = 8;
+	int32 NumLights = 256;
+	int32 NumKeyframes = 16;
+	int32 NumFrames = 600;
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Shows="), NumShows);
+		FParse::Value(*Arg, TEXT("Lights="), NumLights);
+		FParse::Value(*Arg, TEXT("Keyframes="), NumKeyframes);
+		FParse::Value(*Arg, TEXT("Frames="), NumFrames);
+	}
+	NumShows = FMath::Max(NumShows, 1);
+	NumLights = FMath::Max(NumLights, 1);
+	NumKeyframes = FMath::Max(NumKeyframes, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	// An unregistered bank, so only the evaluation and the light state changes are measured
+	UPinballLightBankComponent* LightBank = NewObject<UPinballLightBankComponent>(GetTransientPackage());
+	TArray<FName> LightNames;
+	for (int32 LightIndex = 0; LightIndex < NumLights; ++LightIndex)
+	{
+		const FName LightName(TEXT("Light"), LightIndex);
+		LightBank->AddLight(FTransform::Identity, LightName, FLinearColor::White);
+		LightNames.Add(LightName);
+	}
+
+	// Chases over every light, blinking through hues, each show with a different speed
+	const double CompileStartTime = FPlatformTime::Seconds();
+	FPinballLightSequencer Sequencer;
+	int32 NumKeys = 0;
+	for (int32 ShowIndex = 0; ShowIndex < NumShows; ++ShowIndex)
+	{
+		UPinballLightShow* Show = NewObject<UPinballLightShow>(GetTransientPackage());
+		FPinballLightShowTrack& Track = Show->Tracks.AddDefaulted_GetRef();
+		Track.LightNames = LightNames;
+		Track.LightDelay = 1.0f / NumLights;
+		for (int32 KeyframeIndex = 0; KeyframeIndex < NumKeyframes; ++KeyframeIndex)
+		{
+			FPinballLightShowKeyframe& Keyframe = Track.Keyframes.AddDefaulted_GetRef();
+			Keyframe.Time = KeyframeIndex * 0.1f * (ShowIndex + 1);
+			Keyframe.bOn = (KeyframeIndex % 2) == 0;
+			Keyframe.Color = FLinearColor::MakeFromHSV8(uint8(KeyframeIndex * 255 / NumKeyframes), 255, 255);
+		}
+
+		TSharedRef<FPinballCompiledLightShow> CompiledShow = MakeShared<FPinballCompiledLightShow>();
+		FPinballCompiledLightShow::Compile(*Show, *LightBank, *CompiledShow);
+		NumKeys += CompiledShow->KeyTimes.Num();
+		Sequencer.Play(CompiledShow, true);
+	}
+	const double CompileTime = FPlatformTime::Seconds() - CompileStartTime;
+
+	const float DeltaTime = 1.0f / 60.0f;
+	int32 NumAppliedKeys = 0;
+	const double AdvanceStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		NumAppliedKeys += Sequencer.Advance(DeltaTime, *LightBank);
+	}
+	const double AdvanceTime = FPlatformTime::Seconds() - AdvanceStartTime;
+
+	UE_LOG(LogPinballLightShow, Log, TEXT("BenchmarkLightShows: %d show(s) x %d light(s), %d key(s) compiled in %.3fms"),
+		NumShows, NumLights, NumKeys, CompileTime * 1000.0);
+	UE_LOG(LogPinballLightShow, Log, TEXT("BenchmarkLightShows: %d frame(s), %.1f key(s) applied and %.4fms per frame, %.1fns per key"),
+		NumFrames, float(NumAppliedKeys) / NumFrames, AdvanceTime * 1000.0 / NumFrames, (NumAppliedKeys > 0) ? AdvanceTime * 1.0e9 / NumAppliedKeys : 0.0);
+}
+
+static FAutoConsoleCommand BenchmarkLightShowsConsoleCommand(
+	TEXT("Pinball.BenchmarkLightShows"),
+	TEXT("Plays looping chases over a bank of lights and logs the evaluation cost per frame. Usage: Pinball.BenchmarkLightShows [Shows=N] [Lights=N] [Keyframes=N] [Frames=N]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkLightShowsCommand));
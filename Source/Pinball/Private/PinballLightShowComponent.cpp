@@ -0,0 +1,86 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballLightShowComponent.h"
+#include "PinballLightBankComponent.h"
+#include "GameFramework/Actor.h"
+
+UPinballLightShowComponent::UPinballLightShowComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, LightBank(nullptr)
+{
+	// Only ticks while shows are playing, before the light bank uploads the lights at the end of the frame
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+int32 UPinballLightShowComponent::PlayLightShow(UPinballLightShow* Show, bool bLoop, float PlayRate)
+{
+	if (Show == nullptr || LightBank == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	// Light indices are only valid for the bank the shows were compiled for
+	if (CompiledLightBank != LightBank)
+	{
+		Sequencer.StopAll();
+		CompiledShows.Reset();
+		CompiledLightBank = LightBank;
+	}
+
+	const TSharedRef<const FPinballCompiledLightShow>* CompiledShow = CompiledShows.Find(Show);
+	if (CompiledShow == nullptr)
+	{
+		TSharedRef<FPinballCompiledLightShow> NewCompiledShow = MakeShared<FPinballCompiledLightShow>();
+		FPinballCompiledLightShow::Compile(*Show, *LightBank, *NewCompiledShow);
+		CompiledShow = &CompiledShows.Add(Show, NewCompiledShow);
+	}
+
+	SetComponentTickEnabled(true);
+	return Sequencer.Play(*CompiledShow, bLoop, PlayRate);
+}
+
+void UPinballLightShowComponent::StopLightShow(int32 Handle)
+{
+	Sequencer.Stop(Handle);
+}
+
+void UPinballLightShowComponent::StopAllLightShows()
+{
+	Sequencer.StopAll();
+}
+
+bool UPinballLightShowComponent::IsLightShowPlaying(int32 Handle) const
+{
+	return Sequencer.IsPlaying(Handle);
+}
+
+void UPinballLightShowComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (LightBank == nullptr && GetOwner() != nullptr)
+	{
+		LightBank = GetOwner()->FindComponentByClass<UPinballLightBankComponent>();
+	}
+}
+
+void UPinballLightShowComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (LightBank != nullptr && LightBank == CompiledLightBank)
+	{
+		Sequencer.Advance(DeltaTime, *LightBank);
+	}
+	else
+	{
+		Sequencer.StopAll();
+	}
+
+	if (Sequencer.GetNumActiveShows() == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
@@ -0,0 +1,283 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballPartBatchActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "StaticMeshResources.h"
+#include "UObject/UObjectIterator.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballPartBatch, Log, All);
+
+namespace PinballPartBatchDefs
+{
+	/** Colour of parts that haven't been given one */
+	const FLinearColor DefaultPartColor = FLinearColor::White;
+
+	/** Mesh sections drawn by a static mesh, each is a separate draw call */
+	int32 GetNumMeshSections(const UStaticMesh* StaticMesh)
+	{
+		if (StaticMesh == nullptr || !StaticMesh->RenderData.IsValid() || StaticMesh->RenderData->LODResources.Num() == 0)
+		{
+			return 0;
+		}
+		return StaticMesh->RenderData->LODResources[0].Sections.Num();
+	}
+
+	/** Whether a part component draws and collides the same way as a static mesh component */
+	bool IsMatchingPartComponent(const UHierarchicalInstancedStaticMeshComponent* PartComponent, const UStaticMeshComponent* MeshComponent)
+	{
+		return PartComponent->GetStaticMesh() == MeshComponent->GetStaticMesh()
+			&& PartComponent->OverrideMaterials == MeshComponent->OverrideMaterials
+			&& PartComponent->GetCollisionProfileName() == MeshComponent->GetCollisionProfileName()
+			&& PartComponent->GetCollisionEnabled() == MeshComponent->GetCollisionEnabled()
+			&& PartComponent->BodyInstance.bNotifyRigidBodyCollision == MeshComponent->BodyInstance.bNotifyRigidBodyCollision
+			&& PartComponent->CastShadow == MeshComponent->CastShadow;
+	}
+}
+
+APinballPartBatchActor::APinballPartBatchActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	USceneComponent* SceneComponent = ObjectInitializer.CreateDefaultSubobject<USceneComponent>(this, TEXT("SceneComp"));
+	SceneComponent->SetMobility(EComponentMobility::Static);
+	RootComponent = SceneComponent;
+
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+int32 APinballPartBatchActor::FindPart(FName PartName) const
+{
+	return Parts.IndexOfByPredicate([PartName](const FPinballBatchedPart& Part)
+	{
+		return Part.Name == PartName;
+	});
+}
+
+void APinballPartBatchActor::FindPartsWithTag(FName Tag, TArray<int32>& OutPartIndices) const
+{
+	OutPartIndices.Reset();
+	for (int32 PartIndex = 0; PartIndex < Parts.Num(); ++PartIndex)
+	{
+		if (Parts[PartIndex].Tags.Contains(Tag))
+		{
+			OutPartIndices.Add(PartIndex);
+		}
+	}
+}
+
+int32 APinballPartBatchActor::FindPartByInstance(const UPrimitiveComponent* Component, int32 InstanceIndex) const
+{
+	const int32 ComponentIndex = PartComponents.IndexOfByKey(Component);
+	if (ComponentIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	UpdateInstancePartLookup();
+	return InstanceParts[ComponentIndex].IsValidIndex(InstanceIndex) ? InstanceParts[ComponentIndex][InstanceIndex] : INDEX_NONE;
+}
+
+FTransform APinballPartBatchActor::GetPartTransform(int32 PartIndex) const
+{
+	FTransform PartTransform = FTransform::Identity;
+	if (Parts.IsValidIndex(PartIndex) && Parts[PartIndex].Instances.Num() > 0)
+	{
+		const FPinballPartInstance& Instance = Parts[PartIndex].Instances[0];
+		if (PartComponents.IsValidIndex(Instance.ComponentIndex) && PartComponents[Instance.ComponentIndex] != nullptr)
+		{
+			PartComponents[Instance.ComponentIndex]->GetInstanceTransform(Instance.InstanceIndex, PartTransform, true);
+		}
+	}
+	return PartTransform;
+}
+
+void APinballPartBatchActor::SetPartCustomData(int32 PartIndex, int32 CustomDataIndex, float Value, bool bMarkRenderStateDirty)
+{
+	if (!Parts.IsValidIndex(PartIndex))
+	{
+		return;
+	}
+
+	for (const FPinballPartInstance& Instance : Parts[PartIndex].Instances)
+	{
+		if (PartComponents.IsValidIndex(Instance.ComponentIndex) && PartComponents[Instance.ComponentIndex] != nullptr)
+		{
+			PartComponents[Instance.ComponentIndex]->SetCustomDataValue(Instance.InstanceIndex, CustomDataIndex, Value, bMarkRenderStateDirty);
+		}
+	}
+}
+
+void APinballPartBatchActor::SetPartColor(int32 PartIndex, FLinearColor Color, bool bMarkRenderStateDirty)
+{
+	SetPartCustomData(PartIndex, EPinballPartCustomData::ColorR, Color.R, false);
+	SetPartCustomData(PartIndex, EPinballPartCustomData::ColorG, Color.G, false);
+	SetPartCustomData(PartIndex, EPinballPartCustomData::ColorB, Color.B, bMarkRenderStateDirty);
+}
+
+void APinballPartBatchActor::SetPartState(int32 PartIndex, float State, bool bMarkRenderStateDirty)
+{
+	SetPartCustomData(PartIndex, EPinballPartCustomData::State, State, bMarkRenderStateDirty);
+}
+
+void APinballPartBatchActor::MarkPartsRenderStateDirty()
+{
+	for (UHierarchicalInstancedStaticMeshComponent* PartComponent : PartComponents)
+	{
+		if (PartComponent != nullptr)
+		{
+			PartComponent->MarkRenderStateDirty();
+		}
+	}
+}
+
+#if WITH_EDITOR
+int32 APinballPartBatchActor::AddPart(FName PartName, const TArray<FName>& PartTags, const TArray<UStaticMeshComponent*>& MeshComponents)
+{
+	using namespace PinballPartBatchDefs;
+
+	Modify();
+
+	const int32 PartIndex = Parts.AddDefaulted();
+	FPinballBatchedPart& Part = Parts[PartIndex];
+	Part.Name = PartName;
+	Part.Tags = PartTags;
+
+	for (const UStaticMeshComponent* MeshComponent : MeshComponents)
+	{
+		if (MeshComponent == nullptr || MeshComponent->GetStaticMesh() == nullptr)
+		{
+			continue;
+		}
+
+		FPinballPartInstance& Instance = Part.Instances.AddDefaulted_GetRef();
+		UHierarchicalInstancedStaticMeshComponent* PartComponent = FindOrAddPartComponent(MeshComponent, Instance.ComponentIndex);
+		PartComponent->Modify();
+		Instance.InstanceIndex = PartComponent->AddInstanceWorldSpace(MeshComponent->GetComponentTransform());
+
+		TArray<float> CustomData;
+		CustomData.SetNumZeroed(EPinballPartCustomData::Num);
+		CustomData[EPinballPartCustomData::ColorR] = DefaultPartColor.R;
+		CustomData[EPinballPartCustomData::ColorG] = DefaultPartColor.G;
+		CustomData[EPinballPartCustomData::ColorB] = DefaultPartColor.B;
+		PartComponent->SetCustomData(Instance.InstanceIndex, CustomData, true);
+	}
+
+	// Rebuilt on the next lookup
+	InstanceParts.Reset();
+
+	return PartIndex;
+}
+#endif
+
+UHierarchicalInstancedStaticMeshComponent* APinballPartBatchActor::FindOrAddPartComponent(const UStaticMeshComponent* MeshComponent, int32& OutComponentIndex)
+{
+	using namespace PinballPartBatchDefs;
+
+	for (int32 ComponentIndex = 0; ComponentIndex < PartComponents.Num(); ++ComponentIndex)
+	{
+		if (PartComponents[ComponentIndex] != nullptr && IsMatchingPartComponent(PartComponents[ComponentIndex], MeshComponent))
+		{
+			OutComponentIndex = ComponentIndex;
+			return PartComponents[ComponentIndex];
+		}
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* PartComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, NAME_None, RF_Transactional);
+	PartComponent->CreationMethod = EComponentCreationMethod::Instance;
+	PartComponent->SetupAttachment(RootComponent);
+	PartComponent->SetMobility(EComponentMobility::Static);
+	PartComponent->SetStaticMesh(MeshComponent->GetStaticMesh());
+	PartComponent->OverrideMaterials = MeshComponent->OverrideMaterials;
+	PartComponent->SetCollisionProfileName(MeshComponent->GetCollisionProfileName());
+	PartComponent->SetCollisionEnabled(MeshComponent->GetCollisionEnabled());
+	PartComponent->BodyInstance.bNotifyRigidBodyCollision = MeshComponent->BodyInstance.bNotifyRigidBodyCollision;
+	PartComponent->CastShadow = MeshComponent->CastShadow;
+	PartComponent->NumCustomDataFloats = EPinballPartCustomData::Num;
+	AddInstanceComponent(PartComponent);
+	PartComponent->RegisterComponent();
+
+	Modify();
+	OutComponentIndex = PartComponents.Add(PartComponent);
+	return PartComponent;
+}
+
+void APinballPartBatchActor::UpdateInstancePartLookup() const
+{
+	if (InstanceParts.Num() == PartComponents.Num())
+	{
+		return;
+	}
+
+	InstanceParts.SetNum(PartComponents.Num());
+	for (int32 ComponentIndex = 0; ComponentIndex < PartComponents.Num(); ++ComponentIndex)
+	{
+		InstanceParts[ComponentIndex].Init(INDEX_NONE, (PartComponents[ComponentIndex] != nullptr) ? PartComponents[ComponentIndex]->GetInstanceCount() : 0);
+	}
+
+	for (int32 PartIndex = 0; PartIndex < Parts.Num(); ++PartIndex)
+	{
+		for (const FPinballPartInstance& Instance : Parts[PartIndex].Instances)
+		{
+			if (InstanceParts.IsValidIndex(Instance.ComponentIndex) && InstanceParts[Instance.ComponentIndex].IsValidIndex(Instance.InstanceIndex))
+			{
+				InstanceParts[Instance.ComponentIndex][Instance.InstanceIndex] = PartIndex;
+			}
+		}
+	}
+}
+
+FPinballDrawCallStats APinballPartBatchActor::EstimateDrawCalls(const UWorld* World)
+{
+	using namespace PinballPartBatchDefs;
+
+	FPinballDrawCallStats Stats;
+	for (TObjectIterator<UPrimitiveComponent> It; It; ++It)
+	{
+		const UPrimitiveComponent* PrimitiveComponent = *It;
+		if (PrimitiveComponent->GetWorld() != World || !PrimitiveComponent->IsRegistered() || !PrimitiveComponent->IsVisible() || PrimitiveComponent->bHiddenInGame || PrimitiveComponent->IsPendingKill())
+		{
+			continue;
+		}
+
+		++Stats.NumPrimitives;
+		if (const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(PrimitiveComponent))
+		{
+			const int32 NumInstances = InstancedComponent->GetInstanceCount();
+			Stats.NumInstances += NumInstances;
+			Stats.NumDrawCalls += (NumInstances > 0) ? GetNumMeshSections(InstancedComponent->GetStaticMesh()) : 0;
+		}
+		else if (const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(PrimitiveComponent))
+		{
+			++Stats.NumInstances;
+			Stats.NumDrawCalls += GetNumMeshSections(MeshComponent->GetStaticMesh());
+		}
+		else
+		{
+			++Stats.NumInstances;
+			++Stats.NumDrawCalls;
+		}
+	}
+	return Stats;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Draw call report
+
+static void ReportDrawCallsCommand(UWorld* World)
+{
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	const FPinballDrawCallStats Stats = APinballPartBatchActor::EstimateDrawCalls(World);
+	UE_LOG(LogPinballPartBatch, Log, TEXT("%s: %d visible primitive(s), %d mesh instance(s), about %d draw call(s)"),
+		*World->GetMapName(), Stats.NumPrimitives, Stats.NumInstances, Stats.NumDrawCalls);
+}
+
+static FAutoConsoleCommandWithWorld ReportDrawCallsConsoleCommand(
+	TEXT("Pinball.ReportDrawCalls"),
+	TEXT("Logs an estimate of the draw calls of the current world, one per visible mesh section, with instanced components drawing each section once"),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&ReportDrawCallsCommand));
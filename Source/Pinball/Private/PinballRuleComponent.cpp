@@ -0,0 +1,180 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballRuleComponent.h"
+#include "PinballGameMode.h"
+#include "PinballScoreComponent.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballRuleComponent, Log, All);
+
+namespace PinballRuleComponentDefs
+{
+	/** Element event not looked up yet */
+	const int32 UnknownElementEvent = INDEX_NONE - 1;
+
+	/** Directory of Saved the recorded event streams go to */
+	const TCHAR* RecordDirectory = TEXT("RuleEvents");
+}
+
+UPinballRuleComponent::UPinballRuleComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, RuleTable(nullptr)
+	, bRecordEvents(false)
+	, StartTime(0.0f)
+{
+	// After the game mode drained the hits of the frame
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UPinballRuleComponent::PostRuleEvent(FName Event)
+{
+	PostRuleEventIndex(RuleEngine.FindEvent(Event));
+}
+
+FName UPinballRuleComponent::GetModeState(FName Mode) const
+{
+	return RuleEngine.GetModeState(RuleEngine.FindMode(Mode));
+}
+
+float UPinballRuleComponent::GetModeTimeRemaining(FName Mode) const
+{
+	return RuleEngine.GetModeTimeRemaining(RuleEngine.FindMode(Mode));
+}
+
+void UPinballRuleComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (RuleTable == nullptr || !RuleEngine.Compile(*RuleTable))
+	{
+		return;
+	}
+
+	// Rule time starts with the rules, as replays do
+	StartTime = GetWorld()->GetTimeSeconds();
+
+	// Hit types are posted by their name
+	const UEnum* HitTypeEnum = StaticEnum<EPinballHitType>();
+	HitTypeEvents.Reset();
+	for (int32 HitType = 0; HitType <= int32(EPinballHitType::Custom); ++HitType)
+	{
+		HitTypeEvents.Add(RuleEngine.FindEvent(FName(*HitTypeEnum->GetNameStringByValue(HitType))));
+	}
+
+	if (APinballGameMode* GameMode = GetWorld()->GetAuthGameMode<APinballGameMode>())
+	{
+		HitEventsHandle = GameMode->OnNativeHitEvents.AddUObject(this, &UPinballRuleComponent::OnHitEvents);
+		AddTickPrerequisiteActor(GameMode);
+	}
+}
+
+void UPinballRuleComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (APinballGameMode* GameMode = GetWorld()->GetAuthGameMode<APinballGameMode>())
+	{
+		GameMode->OnNativeHitEvents.Remove(HitEventsHandle);
+	}
+
+	if (bRecordEvents && RecordedEvents.Num() > 0)
+	{
+		const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), PinballRuleComponentDefs::RecordDirectory,
+			FString::Printf(TEXT("%s_%s.txt"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString()));
+		if (FPinballRuleEngine::SaveEventStream(Filename, RecordedEvents))
+		{
+			UE_LOG(LogPinballRuleComponent, Log, TEXT("Recorded %d rule event(s) to %s"), RecordedEvents.Num(), *Filename);
+		}
+		RecordedEvents.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPinballRuleComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Time limits first, then the events of the frame, the order Pinball.ReplayRuleEvents replays the recording in
+	const float Time = GetWorld()->GetTimeSeconds() - StartTime;
+	if (bRecordEvents)
+	{
+		for (const int32 EventIndex : PendingEvents)
+		{
+			FPinballRecordedRuleEvent& RecordedEvent = RecordedEvents.AddDefaulted_GetRef();
+			RecordedEvent.Time = Time;
+			RecordedEvent.Event = RuleEngine.GetEventName(EventIndex);
+		}
+	}
+	RuleEngine.Update(Time, PendingEvents);
+	PendingEvents.Reset();
+
+	Firings.Reset();
+	RuleEngine.ConsumeFirings(Firings);
+	if (Firings.Num() == 0)
+	{
+		return;
+	}
+
+	APinballGameMode* GameMode = GetWorld()->GetAuthGameMode<APinballGameMode>();
+	for (const FPinballRuleFiring& Firing : Firings)
+	{
+		if (Firing.ScoreReward != 0 && GameMode != nullptr && GameMode->ScoreComponent != nullptr)
+		{
+			GameMode->ScoreComponent->RegisterScore(Firing.ScoreReward);
+		}
+		OnRuleFired.Broadcast(Firing.Mode, Firing.FromState, Firing.ToState, Firing.Reward);
+	}
+}
+
+void UPinballRuleComponent::OnHitEvents(TArrayView<const FPinballHitEvent> Events)
+{
+	for (const FPinballHitEvent& Event : Events)
+	{
+		const int32 HitType = int32(Event.Type);
+		if (HitTypeEvents.IsValidIndex(HitType) && HitTypeEvents[HitType] != INDEX_NONE)
+		{
+			PostRuleEventIndex(HitTypeEvents[HitType]);
+		}
+
+		const int32 ElementEvent = GetElementEvent(Event.ElementId);
+		if (ElementEvent != INDEX_NONE)
+		{
+			PostRuleEventIndex(ElementEvent);
+		}
+	}
+}
+
+void UPinballRuleComponent::PostRuleEventIndex(int32 EventIndex)
+{
+	// Events no rule listens to have nothing to fire, nor to replay
+	if (EventIndex != INDEX_NONE)
+	{
+		PendingEvents.Add(EventIndex);
+	}
+}
+
+int32 UPinballRuleComponent::GetElementEvent(int32 ElementId)
+{
+	using namespace PinballRuleComponentDefs;
+
+	if (ElementId < 0)
+	{
+		return INDEX_NONE;
+	}
+
+	while (ElementEvents.Num() <= ElementId)
+	{
+		ElementEvents.Add(UnknownElementEvent);
+	}
+
+	if (ElementEvents[ElementId] == UnknownElementEvent)
+	{
+		const APinballGameMode* GameMode = GetWorld()->GetAuthGameMode<APinballGameMode>();
+		const AActor* Element = (GameMode != nullptr) ? Cast<AActor>(GameMode->GetElement(ElementId)) : nullptr;
+		ElementEvents[ElementId] = (Element != nullptr && Element->Tags.Num() > 0) ? RuleEngine.FindEvent(Element->Tags[0]) : INDEX_NONE;
+	}
+	return ElementEvents[ElementId];
+}
@@ -0,0 +1,678 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballRuleEngine.h"
+#include "Misc/FileHelper.h"
+#include "Templates/Function.h"
+#include "Misc/Paths.h"
+#include "Misc/AutomationTest.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballRules, Log, All);
+
+namespace PinballRuleEngineDefs
+{
+	/** Event posted to a mode when the time limit of its state runs out */
+	const FName TimeoutEventName(TEXT("Timeout"));
+
+	/** Most reward events one event can chain into, so rules rewarding each other can't loop forever */
+	const int32 MaxChainedEvents = 64;
+}
+
+bool FPinballRuleEngine::Compile(const UDataTable& RuleTable)
+{
+	using namespace PinballRuleEngineDefs;
+
+	const UScriptStruct* RowStruct = RuleTable.GetRowStruct();
+	if (RowStruct == nullptr || !RowStruct->IsChildOf(FPinballRuleRow::StaticStruct()))
+	{
+		UE_LOG(LogPinballRules, Error, TEXT("%s doesn't have FPinballRuleRow rows"), *RuleTable.GetPathName());
+		return false;
+	}
+
+	Transitions.Reset();
+	EventFirstTransition.Reset();
+	ModeTransitions.Reset();
+	ModeNames.Reset();
+	ModeStateNames.Reset();
+	EventIndices.Reset();
+	EventNames.Reset();
+	TimeoutEvent = FindOrAddEvent(TimeoutEventName);
+
+	// Every mode, state and event first, conditions can refer to modes defined further down
+	TArray<const FPinballRuleRow*> Rules;
+	TArray<FName> RuleNames;
+	for (const TPair<FName, uint8*>& Row : RuleTable.GetRowMap())
+	{
+		const FPinballRuleRow* Rule = reinterpret_cast<const FPinballRuleRow*>(Row.Value);
+		if (Rule->Mode.IsNone() || Rule->Event.IsNone())
+		{
+			UE_LOG(LogPinballRules, Warning, TEXT("%s: rule %s has no mode or no event, skipped"), *RuleTable.GetName(), *Row.Key.ToString());
+			continue;
+		}
+
+		for (const FName& ModeName : { Rule->Mode, Rule->RequiredMode })
+		{
+			if (!ModeName.IsNone() && !ModeNames.Contains(ModeName))
+			{
+				ModeNames.Add(ModeName);
+				ModeStateNames.AddDefaulted_GetRef().Add(NAME_None);
+			}
+		}
+
+		TArray<FName>& StateNames = ModeStateNames[ModeNames.IndexOfByKey(Rule->Mode)];
+		FindOrAddState(StateNames, Rule->FromState);
+		FindOrAddState(StateNames, Rule->ToState);
+		if (!Rule->RequiredMode.IsNone())
+		{
+			FindOrAddState(ModeStateNames[ModeNames.IndexOfByKey(Rule->RequiredMode)], Rule->RequiredState);
+		}
+		FindOrAddEvent(Rule->Event);
+
+		Rules.Add(Rule);
+		RuleNames.Add(Row.Key);
+	}
+
+	TArray<int32> TransitionEvents;
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FPinballRuleRow& Rule = *Rules[RuleIndex];
+		const int32 ModeIndex = ModeNames.IndexOfByKey(Rule.Mode);
+		const TArray<FName>& StateNames = ModeStateNames[ModeIndex];
+
+		FTransition& Transition = Transitions.AddDefaulted_GetRef();
+		Transition.RuleName = RuleNames[RuleIndex];
+		Transition.Reward = Rule.Reward;
+		Transition.Mode = ModeIndex;
+		Transition.FromState = StateNames.IndexOfByKey(Rule.FromState);
+		Transition.ToState = StateNames.IndexOfByKey(Rule.ToState);
+		Transition.Count = FMath::Max(Rule.Count, 1);
+		Transition.RequiredMode = Rule.RequiredMode.IsNone() ? INDEX_NONE : ModeNames.IndexOfByKey(Rule.RequiredMode);
+		Transition.RequiredState = (Transition.RequiredMode != INDEX_NONE) ? ModeStateNames[Transition.RequiredMode].IndexOfByKey(Rule.RequiredState) : INDEX_NONE;
+		Transition.RewardEvent = FindEvent(Rule.Reward);
+		Transition.ScoreReward = Rule.ScoreReward;
+		Transition.TimeLimit = FMath::Max(Rule.TimeLimit, 0.0f);
+		TransitionEvents.Add(FindEvent(Rule.Event));
+	}
+
+	// Grouped by event keeping the order of the table, which decides between rules of one mode firing on the same event
+	TArray<int32> Order;
+	for (int32 TransitionIndex = 0; TransitionIndex < Transitions.Num(); ++TransitionIndex)
+	{
+		Order.Add(TransitionIndex);
+	}
+	Order.StableSort([&TransitionEvents](int32 A, int32 B)
+	{
+		return TransitionEvents[A] < TransitionEvents[B];
+	});
+
+	TArray<FTransition> SortedTransitions;
+	SortedTransitions.Reserve(Transitions.Num());
+	EventFirstTransition.Init(0, EventIndices.Num() + 1);
+	for (int32 TransitionIndex : Order)
+	{
+		SortedTransitions.Add(Transitions[TransitionIndex]);
+		++EventFirstTransition[TransitionEvents[TransitionIndex] + 1];
+	}
+	for (int32 EventIndex = 0; EventIndex < EventIndices.Num(); ++EventIndex)
+	{
+		EventFirstTransition[EventIndex + 1] += EventFirstTransition[EventIndex];
+	}
+	Transitions = MoveTemp(SortedTransitions);
+
+	ModeTransitions.SetNum(ModeNames.Num());
+	for (int32 TransitionIndex = 0; TransitionIndex < Transitions.Num(); ++TransitionIndex)
+	{
+		ModeTransitions[Transitions[TransitionIndex].Mode].Add(TransitionIndex);
+	}
+
+	Reset();
+
+	UE_LOG(LogPinballRules, Log, TEXT("%s: %d rule(s), %d mode(s), %d event(s)"), *RuleTable.GetName(), Transitions.Num(), ModeNames.Num(), EventIndices.Num());
+	return true;
+}
+
+void FPinballRuleEngine::Reset()
+{
+	ModeStates.Init(0, ModeNames.Num());
+	ModeDeadlines.Init(0.0f, ModeNames.Num());
+	CurrentTime = 0.0f;
+	EventTime = 0.0f;
+	ModeEventSerials.Init(0, ModeNames.Num());
+	TransitionCounts.Init(0, Transitions.Num());
+	TimedModes.Reset();
+	PendingEvents.Reset();
+	Firings.Reset();
+	EventSerial = 0;
+}
+
+int32 FPinballRuleEngine::PostEvent(int32 EventIndex)
+{
+	if (!EventFirstTransition.IsValidIndex(EventIndex + 1) || EventIndex < 0)
+	{
+		return 0;
+	}
+
+	EventTime = CurrentTime;
+	return ProcessEvent(EventIndex, INDEX_NONE) + ProcessPendingEvents();
+}
+
+int32 FPinballRuleEngine::Update(float Time, TArrayView<const int32> EventIndices)
+{
+	CurrentTime = FMath::Max(Time, CurrentTime);
+
+	// Time limits run out in order, the earliest first and the first mode on a tie, a timeout can start a time limit that runs out too
+	int32 NumFired = 0;
+	for (;;)
+	{
+		int32 ExpiredTimedModeIndex = INDEX_NONE;
+		for (int32 TimedModeIndex = 0; TimedModeIndex < TimedModes.Num(); ++TimedModeIndex)
+		{
+			const int32 ModeIndex = TimedModes[TimedModeIndex];
+			if (ModeDeadlines[ModeIndex] <= CurrentTime && (ExpiredTimedModeIndex == INDEX_NONE
+				|| ModeDeadlines[ModeIndex] < ModeDeadlines[TimedModes[ExpiredTimedModeIndex]]
+				|| (ModeDeadlines[ModeIndex] == ModeDeadlines[TimedModes[ExpiredTimedModeIndex]] && ModeIndex < TimedModes[ExpiredTimedModeIndex])))
+			{
+				ExpiredTimedModeIndex = TimedModeIndex;
+			}
+		}
+		if (ExpiredTimedModeIndex == INDEX_NONE)
+		{
+			break;
+		}
+
+		// Removed first, the timeout can start another time limit
+		const int32 ModeIndex = TimedModes[ExpiredTimedModeIndex];
+		TimedModes.RemoveAtSwap(ExpiredTimedModeIndex);
+		EventTime = ModeDeadlines[ModeIndex];
+		NumFired += ProcessEvent(TimeoutEvent, ModeIndex) + ProcessPendingEvents();
+	}
+
+	for (const int32 EventIndex : EventIndices)
+	{
+		NumFired += PostEvent(EventIndex);
+	}
+	return NumFired;
+}
+
+void FPinballRuleEngine::ConsumeFirings(TArray<FPinballRuleFiring>& OutFirings)
+{
+	OutFirings.Append(Firings);
+	Firings.Reset();
+}
+
+int32 FPinballRuleEngine::ProcessEvent(int32 EventIndex, int32 OnlyMode)
+{
+	// A mode changes state at most once per event, the first of its rules that fires wins
+	++EventSerial;
+
+	int32 NumFired = 0;
+	const int32 LastTransition = EventFirstTransition[EventIndex + 1];
+	for (int32 TransitionIndex = EventFirstTransition[EventIndex]; TransitionIndex < LastTransition; ++TransitionIndex)
+	{
+		const FTransition& Transition = Transitions[TransitionIndex];
+		const int32 ModeIndex = Transition.Mode;
+		if ((OnlyMode != INDEX_NONE && ModeIndex != OnlyMode) || ModeStates[ModeIndex] != Transition.FromState || ModeEventSerials[ModeIndex] == EventSerial)
+		{
+			continue;
+		}
+		if (Transition.RequiredMode != INDEX_NONE && ModeStates[Transition.RequiredMode] != Transition.RequiredState)
+		{
+			continue;
+		}
+		if (++TransitionCounts[TransitionIndex] < Transition.Count)
+		{
+			continue;
+		}
+
+		TransitionCounts[TransitionIndex] = 0;
+		++NumFired;
+
+		FPinballRuleFiring& Firing = Firings.AddDefaulted_GetRef();
+		Firing.RuleName = Transition.RuleName;
+		Firing.Mode = ModeNames[ModeIndex];
+		Firing.FromState = ModeStateNames[ModeIndex][Transition.FromState];
+		Firing.ToState = ModeStateNames[ModeIndex][Transition.ToState];
+		Firing.Reward = Transition.Reward;
+		Firing.ScoreReward = Transition.ScoreReward;
+
+		if (Transition.RewardEvent != INDEX_NONE)
+		{
+			PendingEvents.Add(Transition.RewardEvent);
+		}
+
+		// Rules staying in their state, such as jackpots, keep the counts and the time limit running
+		if (Transition.ToState == Transition.FromState)
+		{
+			continue;
+		}
+
+		ModeStates[ModeIndex] = Transition.ToState;
+		ModeEventSerials[ModeIndex] = EventSerial;
+		for (int32 ModeTransitionIndex : ModeTransitions[ModeIndex])
+		{
+			TransitionCounts[ModeTransitionIndex] = 0;
+		}
+
+		ModeDeadlines[ModeIndex] = EventTime + Transition.TimeLimit;
+		if (Transition.TimeLimit > 0.0f)
+		{
+			TimedModes.AddUnique(ModeIndex);
+		}
+		else
+		{
+			TimedModes.RemoveSwap(ModeIndex);
+		}
+	}
+	return NumFired;
+}
+
+int32 FPinballRuleEngine::ProcessPendingEvents()
+{
+	int32 NumFired = 0;
+	int32 NumProcessed = 0;
+	for (; NumProcessed < PendingEvents.Num() && NumProcessed < PinballRuleEngineDefs::MaxChainedEvents; ++NumProcessed)
+	{
+		const int32 EventIndex = PendingEvents[NumProcessed];
+		NumFired += ProcessEvent(EventIndex, INDEX_NONE);
+	}
+
+	if (NumProcessed < PendingEvents.Num())
+	{
+		UE_LOG(LogPinballRules, Warning, TEXT("Rewards chained into more than %d events, the rules probably reward each other in a loop"), PinballRuleEngineDefs::MaxChainedEvents);
+	}
+	PendingEvents.Reset();
+	return NumFired;
+}
+
+int32 FPinballRuleEngine::FindOrAddState(TArray<FName>& StateNames, FName StateName)
+{
+	const int32 StateIndex = StateNames.IndexOfByKey(StateName);
+	return (StateIndex != INDEX_NONE) ? StateIndex : StateNames.Add(StateName);
+}
+
+int32 FPinballRuleEngine::FindOrAddEvent(FName EventName)
+{
+	if (const int32* EventIndex = EventIndices.Find(EventName))
+	{
+		return *EventIndex;
+	}
+	EventNames.Add(EventName);
+	return EventIndices.Add(EventName, EventIndices.Num());
+}
+
+bool FPinballRuleEngine::LoadEventStream(const FString& Filename, TArray<FPinballRecordedRuleEvent>& OutEvents)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Filename))
+	{
+		return false;
+	}
+
+	OutEvents.Reset();
+	for (const FString& Line : Lines)
+	{
+		FString TimeString;
+		FString EventString;
+		const FString TrimmedLine = Line.TrimStartAndEnd();
+		if (TrimmedLine.IsEmpty() || TrimmedLine.StartsWith(TEXT("#")) || !TrimmedLine.Split(TEXT(" "), &TimeString, &EventString))
+		{
+			continue;
+		}
+
+		FPinballRecordedRuleEvent& Event = OutEvents.AddDefaulted_GetRef();
+		Event.Time = FCString::Atof(*TimeString);
+		Event.Event = FName(*EventString.TrimStartAndEnd());
+	}
+
+	OutEvents.StableSort([](const FPinballRecordedRuleEvent& A, const FPinballRecordedRuleEvent& B)
+	{
+		return A.Time < B.Time;
+	});
+	return true;
+}
+
+bool FPinballRuleEngine::SaveEventStream(const FString& Filename, const TArray<FPinballRecordedRuleEvent>& Events)
+{
+	FString Text = TEXT("# Time Event\n");
+	for (const FPinballRecordedRuleEvent& Event : Events)
+	{
+		// Enough digits to read back the same float, so replays see the same times as the game
+		Text += FString::Printf(TEXT("%.9g %s\n"), Event.Time, *Event.Event.ToString());
+	}
+	return FFileHelper::SaveStringToFile(Text, *Filename);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Replay
+
+/**
+ * Drives events through the rules from the start, each group of events at the same time in one update like the frame that recorded them
+ * @return	Number of rules fired
+ */
+static int32 ReplayRuleEvents(FPinballRuleEngine& RuleEngine, const TArray<FPinballRecordedRuleEvent>& Events, TArrayView<const int32> EventIndices,
+	TFunctionRef<void(float Time, const FPinballRuleFiring& Firing)> OnFiring)
+{
+	RuleEngine.Reset();
+
+	int32 NumFired = 0;
+	TArray<FPinballRuleFiring> Firings;
+	for (int32 FirstEvent = 0; FirstEvent < Events.Num();)
+	{
+		const float Time = Events[FirstEvent].Time;
+		int32 NumEvents = 1;
+		while (FirstEvent + NumEvents < Events.Num() && Events[FirstEvent + NumEvents].Time == Time)
+		{
+			++NumEvents;
+		}
+
+		NumFired += RuleEngine.Update(Time, EventIndices.Slice(FirstEvent, NumEvents));
+		FirstEvent += NumEvents;
+
+		Firings.Reset();
+		RuleEngine.ConsumeFirings(Firings);
+		for (const FPinballRuleFiring& Firing : Firings)
+		{
+			OnFiring(Time, Firing);
+		}
+	}
+	return NumFired;
+}
+
+static void ReplayRuleEventsCommand(const TArray<FString>& Args)
+{
+	FString TablePath;
+	FString Filename;
+	int32 NumRepeats = 1;
+	bool bVerbose = false;
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Table="), TablePath);
+		FParse::Value(*Arg, TEXT("File="), Filename);
+		FParse::Value(*Arg, TEXT("Repeat="), NumRepeats);
+		bVerbose |= (Arg == TEXT("Verbose"));
+	}
+	NumRepeats = FMath::Max(NumRepeats, 1);
+
+	const UDataTable* RuleTable = LoadObject<UDataTable>(nullptr, *TablePath);
+	if (RuleTable == nullptr)
+	{
+		UE_LOG(LogPinballRules, Error, TEXT("ReplayRuleEvents: %s isn't a DataTable"), *TablePath);
+		return;
+	}
+
+	// Relative paths are from the saved directory, where games record their streams
+	if (FPaths::IsRelative(Filename))
+	{
+		Filename = FPaths::Combine(FPaths::ProjectSavedDir(), Filename);
+	}
+
+	TArray<FPinballRecordedRuleEvent> Events;
+	if (!FPinballRuleEngine::LoadEventStream(Filename, Events))
+	{
+		UE_LOG(LogPinballRules, Error, TEXT("ReplayRuleEvents: can't read %s"), *Filename);
+		return;
+	}
+
+	FPinballRuleEngine RuleEngine;
+	if (!RuleEngine.Compile(*RuleTable))
+	{
+		return;
+	}
+
+	// Names are resolved once, as a game posting events by index would
+	TArray<int32> EventIndices;
+	int32 NumUnknownEvents = 0;
+	for (const FPinballRecordedRuleEvent& Event : Events)
+	{
+		EventIndices.Add(RuleEngine.FindEvent(Event.Event));
+		NumUnknownEvents += (EventIndices.Last() == INDEX_NONE) ? 1 : 0;
+	}
+
+	// Only the first run is reported, the others are for timing
+	int64 TotalScore = 0;
+	const int32 NumFired = ReplayRuleEvents(RuleEngine, Events, EventIndices, [&TotalScore, bVerbose](float Time, const FPinballRuleFiring& Firing)
+	{
+		TotalScore += Firing.ScoreReward;
+		if (bVerbose)
+		{
+			UE_LOG(LogPinballRules, Log, TEXT("%8.3f %s: %s %s -> %s%s%s"), Time, *Firing.RuleName.ToString(), *Firing.Mode.ToString(),
+				*Firing.FromState.ToString(), *Firing.ToState.ToString(), Firing.Reward.IsNone() ? TEXT("") : TEXT(", reward "), Firing.Reward.IsNone() ? TEXT("") : *Firing.Reward.ToString());
+		}
+	});
+	TArray<FName> ModeStates;
+	for (int32 ModeIndex = 0; ModeIndex < RuleEngine.GetNumModes(); ++ModeIndex)
+	{
+		ModeStates.Add(RuleEngine.GetModeState(ModeIndex));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Repeat = 1; Repeat < NumRepeats; ++Repeat)
+	{
+		ReplayRuleEvents(RuleEngine, Events, EventIndices, [](float Time, const FPinballRuleFiring& Firing) {});
+	}
+	const double ReplayTime = FPlatformTime::Seconds() - StartTime;
+	const int32 NumTimedRepeats = NumRepeats - 1;
+
+	UE_LOG(LogPinballRules, Log, TEXT("ReplayRuleEvents: %d event(s), %d unknown to the rules, %d rule(s) fired, %lld points"),
+		Events.Num(), NumUnknownEvents, NumFired, TotalScore);
+	if (NumTimedRepeats > 0)
+	{
+		UE_LOG(LogPinballRules, Log, TEXT("ReplayRuleEvents: %.3fms per replay (average of %d), %.1fns per event"),
+			ReplayTime * 1000.0 / NumTimedRepeats, NumTimedRepeats, (Events.Num() > 0) ? ReplayTime * 1.0e9 / (double(Events.Num()) * NumTimedRepeats) : 0.0);
+	}
+	for (int32 ModeIndex = 0; ModeIndex < ModeStates.Num(); ++ModeIndex)
+	{
+		UE_LOG(LogPinballRules, Log, TEXT("ReplayRuleEvents: %s ended in %s"), *RuleEngine.GetModeName(ModeIndex).ToString(), *ModeStates[ModeIndex].ToString());
+	}
+}
+
+static FAutoConsoleCommand ReplayRuleEventsConsoleCommand(
+	TEXT("Pinball.ReplayRuleEvents"),
+	TEXT("Drives a recorded event stream through the rules of a DataTable without a world, and logs the rules fired, the final mode states and the time per event. Usage: Pinball.ReplayRuleEvents Table=Path File=Path [Repeat=N] [Verbose]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ReplayRuleEventsCommand));
+
+//////////////////////////////////////////////////////////////////////////
+// Built in test
+
+namespace PinballRuleTestDefs
+{
+	/** Frame time of the simulated game, exact in binary so frames land on the times of the test events */
+	const float FrameTime = 1.0f / 64.0f;
+
+	const float EndTime = 31.0f;
+
+	struct FTestRule
+	{
+		const TCHAR* Name;
+		const TCHAR* FromState;
+		const TCHAR* Event;
+		int32 Count;
+		const TCHAR* ToState;
+		float TimeLimit;
+		int32 ScoreReward;
+	};
+
+	/**
+	 * Multiball, lit by three targets and started by a ramp, with a jackpot on each ramp while running and a grace period to restart it once it times out
+	 * The ramp at 14 lands on the frame the mode times out, the target at 30 after two time limits ran out in a row
+	 */
+	const FTestRule Rules[] =
+	{
+		{ TEXT("LightMultiball"), TEXT("None"), TEXT("Target"), 3, TEXT("Lit"), 0.0f, 0 },
+		{ TEXT("StartMultiball"), TEXT("Lit"), TEXT("Ramp"), 1, TEXT("Running"), 10.0f, 0 },
+		{ TEXT("Jackpot"), TEXT("Running"), TEXT("Ramp"), 1, TEXT("Running"), 0.0f, 1000 },
+		{ TEXT("EndMultiball"), TEXT("Running"), TEXT("Timeout"), 1, TEXT("GracePeriod"), 2.0f, 0 },
+		{ TEXT("RestartMultiball"), TEXT("GracePeriod"), TEXT("Ramp"), 1, TEXT("Running"), 10.0f, 500 },
+		{ TEXT("EndGracePeriod"), TEXT("GracePeriod"), TEXT("Timeout"), 1, TEXT("None"), 0.0f, 0 },
+	};
+
+	struct FTestEvent
+	{
+		float Time;
+		const TCHAR* Event;
+	};
+
+	const FTestEvent Events[] =
+	{
+		{ 1.0f, TEXT("Target") },
+		{ 2.0f, TEXT("Target") },
+		{ 3.0f, TEXT("Target") },
+		{ 4.0f, TEXT("Ramp") },
+		{ 5.0f, TEXT("Ramp") },
+		{ 14.0f, TEXT("Ramp") },
+		{ 30.0f, TEXT("Target") },
+	};
+
+	const TCHAR* ExpectedModeState = TEXT("None");
+
+	struct FRuleTestResult
+	{
+		const TCHAR* Run;
+		FName ModeState;
+		int32 NumFired;
+		int64 Score;
+	};
+	const int32 ExpectedNumFired = 7;
+	const int64 ExpectedScore = 1500;
+
+	/** Play the test events through the test rules frame by frame, then replay their recording, false with OutError if the test can't run */
+	bool PlayAndReplay(FRuleTestResult& OutPlayed, FRuleTestResult& OutReplayed, FString& OutError);
+}
+
+bool PinballRuleTestDefs::PlayAndReplay(FRuleTestResult& OutPlayed, FRuleTestResult& OutReplayed, FString& OutError)
+{
+	UDataTable* RuleTable = NewObject<UDataTable>(GetTransientPackage());
+	RuleTable->RowStruct = FPinballRuleRow::StaticStruct();
+	for (const FTestRule& TestRule : Rules)
+	{
+		FPinballRuleRow Rule;
+		Rule.Mode = TEXT("Multiball");
+		Rule.FromState = TestRule.FromState;
+		Rule.Event = TestRule.Event;
+		Rule.Count = TestRule.Count;
+		Rule.ToState = TestRule.ToState;
+		Rule.TimeLimit = TestRule.TimeLimit;
+		Rule.ScoreReward = TestRule.ScoreReward;
+		RuleTable->AddRow(TestRule.Name, Rule);
+	}
+
+	FPinballRuleEngine RuleEngine;
+	if (!RuleEngine.Compile(*RuleTable))
+	{
+		OutError = TEXT("the test rules don't compile");
+		return false;
+	}
+
+	// Played as a game would, updated every frame with the events of the frame, and recorded as the rule component does
+	TArray<FPinballRecordedRuleEvent> RecordedEvents;
+	TArray<FPinballRuleFiring> Firings;
+	int32 NumPlayedFired = 0;
+	int64 PlayedScore = 0;
+	int32 NextEvent = 0;
+	TArray<int32> FrameEvents;
+	for (int32 Frame = 1; Frame * FrameTime <= EndTime; ++Frame)
+	{
+		const float Time = Frame * FrameTime;
+		FrameEvents.Reset();
+		for (; NextEvent < UE_ARRAY_COUNT(Events) && Events[NextEvent].Time <= Time; ++NextEvent)
+		{
+			FrameEvents.Add(RuleEngine.FindEvent(Events[NextEvent].Event));
+			FPinballRecordedRuleEvent& RecordedEvent = RecordedEvents.AddDefaulted_GetRef();
+			RecordedEvent.Time = Time;
+			RecordedEvent.Event = Events[NextEvent].Event;
+		}
+
+		NumPlayedFired += RuleEngine.Update(Time, FrameEvents);
+		Firings.Reset();
+		RuleEngine.ConsumeFirings(Firings);
+		for (const FPinballRuleFiring& Firing : Firings)
+		{
+			PlayedScore += Firing.ScoreReward;
+		}
+	}
+	OutPlayed = { TEXT("played"), RuleEngine.GetModeState(0), NumPlayedFired, PlayedScore };
+
+	// Then replayed from its recording, through a saved stream like Pinball.ReplayRuleEvents
+	const FString Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RuleEvents"), TEXT("TestRules.txt"));
+	TArray<FPinballRecordedRuleEvent> LoadedEvents;
+	if (!FPinballRuleEngine::SaveEventStream(Filename, RecordedEvents) || !FPinballRuleEngine::LoadEventStream(Filename, LoadedEvents))
+	{
+		OutError = FString::Printf(TEXT("can't write and read back %s"), *Filename);
+		return false;
+	}
+
+	TArray<int32> EventIndices;
+	for (const FPinballRecordedRuleEvent& Event : LoadedEvents)
+	{
+		EventIndices.Add(RuleEngine.FindEvent(Event.Event));
+	}
+	int64 ReplayedScore = 0;
+	const int32 NumReplayedFired = ReplayRuleEvents(RuleEngine, LoadedEvents, EventIndices, [&ReplayedScore](float Time, const FPinballRuleFiring& Firing)
+	{
+		ReplayedScore += Firing.ScoreReward;
+	});
+	OutReplayed = { TEXT("replayed"), RuleEngine.GetModeState(0), NumReplayedFired, ReplayedScore };
+	return true;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPinballRulesTest, "Pinball.Rules.PlayAndReplay", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FPinballRulesTest::RunTest(const FString& Parameters)
+{
+	using namespace PinballRuleTestDefs;
+
+	FRuleTestResult Played;
+	FRuleTestResult Replayed;
+	FString Error;
+	if (!PlayAndReplay(Played, Replayed, Error))
+	{
+		AddError(Error);
+		return false;
+	}
+
+	for (const FRuleTestResult& Result : { Played, Replayed })
+	{
+		TestEqual(FString::Printf(TEXT("Multiball state once %s"), Result.Run), Result.ModeState.ToString(), FString(ExpectedModeState));
+		TestEqual(FString::Printf(TEXT("Rules fired once %s"), Result.Run), Result.NumFired, ExpectedNumFired);
+		TestEqual(FString::Printf(TEXT("Points once %s"), Result.Run), Result.Score, ExpectedScore);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+static void TestRulesCommand()
+{
+	using namespace PinballRuleTestDefs;
+
+	FRuleTestResult Played;
+	FRuleTestResult Replayed;
+	FString Error;
+	if (!PlayAndReplay(Played, Replayed, Error))
+	{
+		UE_LOG(LogPinballRules, Error, TEXT("TestRules: %s"), *Error);
+		return;
+	}
+
+	bool bPassed = true;
+	for (const FRuleTestResult& Result : { Played, Replayed })
+	{
+		if (Result.ModeState != ExpectedModeState || Result.NumFired != ExpectedNumFired || Result.Score != ExpectedScore)
+		{
+			UE_LOG(LogPinballRules, Error, TEXT("TestRules: %s, Multiball ended in %s with %d rule(s) fired and %lld points, expected %s with %d rule(s) fired and %lld points"),
+				Result.Run, *Result.ModeState.ToString(), Result.NumFired, Result.Score, ExpectedModeState, ExpectedNumFired, ExpectedScore);
+			bPassed = false;
+		}
+	}
+
+	if (bPassed)
+	{
+		UE_LOG(LogPinballRules, Log, TEXT("TestRules: passed, played and replayed the same way, %d rule(s) fired and %lld points"), ExpectedNumFired, ExpectedScore);
+	}
+}
+
+static FAutoConsoleCommand TestRulesConsoleCommand(
+	TEXT("Pinball.TestRules"),
+	TEXT("Plays a built in event stream through built in rules frame by frame, replays its recording, and logs an error if either doesn't end as expected. The same check runs as the Pinball.Rules.PlayAndReplay automation test"),
+	FConsoleCommandDelegate::CreateStatic(&TestRulesCommand));
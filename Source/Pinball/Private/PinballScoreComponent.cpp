@@ -0,0 +1,232 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballScoreComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballScore, Log, All);
+
+namespace PinballScoreComponentDefs
+{
+	/** Sum clamped to the range of int64 instead of wrapping around */
+	int64 AddSaturated(int64 A, int64 B)
+	{
+		if (B > 0 && A > MAX_int64 - B)
+		{
+			return MAX_int64;
+		}
+		if (B < 0 && A < MIN_int64 - B)
+		{
+			return MIN_int64;
+		}
+		return A + B;
+	}
+}
+
+UPinballScoreComponent::UPinballScoreComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Score(0)
+	, NumResolvedHits(0)
+	, Multiplier(1)
+{
+	// Only ticks on frames with hits, after everything that can score
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UPinballScoreComponent::RegisterScore(int32 PointsToAdd)
+{
+	UPinballScoreComponent* Owner = GetScoreOwner();
+	if (Owner != this)
+	{
+		Owner->RegisterScore(PointsToAdd);
+		return;
+	}
+
+	if (QueuedHits.Num() == 0 && IsRegistered())
+	{
+		SetComponentTickEnabled(true);
+	}
+	QueuedHits.Add(FQueuedHit{ PointsToAdd, Multiplier });
+}
+
+void UPinballScoreComponent::ResetScore()
+{
+	QueuedHits.Reset();
+	NumResolvedHits = 0;
+
+	if (Score != 0)
+	{
+		const int64 ScoreDelta = -Score;
+		Score = 0;
+		OnScoreChanged.Broadcast(Score, ScoreDelta);
+	}
+}
+
+void UPinballScoreComponent::PushMultiplier(FName Source, int32 NewMultiplier)
+{
+	FPinballScoreMultiplier* ExistingMultiplier = Multipliers.FindByPredicate([Source](const FPinballScoreMultiplier& Entry)
+	{
+		return Entry.Source == Source;
+	});
+
+	if (ExistingMultiplier != nullptr)
+	{
+		ExistingMultiplier->Multiplier = NewMultiplier;
+	}
+	else
+	{
+		FPinballScoreMultiplier& Entry = Multipliers.AddDefaulted_GetRef();
+		Entry.Source = Source;
+		Entry.Multiplier = NewMultiplier;
+	}
+	UpdateMultiplier();
+}
+
+void UPinballScoreComponent::RemoveMultiplier(FName Source)
+{
+	if (Multipliers.RemoveAll([Source](const FPinballScoreMultiplier& Entry) { return Entry.Source == Source; }) > 0)
+	{
+		UpdateMultiplier();
+	}
+}
+
+void UPinballScoreComponent::ClearMultipliers()
+{
+	Multipliers.Reset();
+	UpdateMultiplier();
+}
+
+void UPinballScoreComponent::ResolveHits()
+{
+	if (QueuedHits.Num() == 0)
+	{
+		return;
+	}
+
+	// Each product fits in 64 bits, only the sums can overflow
+	int64 ScoreDelta = 0;
+	for (const FQueuedHit& Hit : QueuedHits)
+	{
+		ScoreDelta = PinballScoreComponentDefs::AddSaturated(ScoreDelta, int64(Hit.Points) * Hit.Multiplier);
+	}
+	NumResolvedHits += QueuedHits.Num();
+	QueuedHits.Reset();
+
+	const int64 OldScore = Score;
+	Score = FMath::Max<int64>(PinballScoreComponentDefs::AddSaturated(Score, ScoreDelta), 0);
+
+	if (Score != OldScore)
+	{
+		OnScoreChanged.Broadcast(Score, Score - OldScore);
+	}
+}
+
+void UPinballScoreComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	ResolveHits();
+	SetComponentTickEnabled(false);
+}
+
+UPinballScoreComponent* UPinballScoreComponent::GetScoreOwner()
+{
+	if (UPinballScoreComponent* CachedScoreOwner = ScoreOwner.Get())
+	{
+		return CachedScoreOwner;
+	}
+
+	UPinballScoreComponent* NewScoreOwner = this;
+	const UWorld* World = GetWorld();
+	if (AGameModeBase* GameMode = (World != nullptr) ? World->GetAuthGameMode() : nullptr)
+	{
+		if (UPinballScoreComponent* GameModeScore = GameMode->FindComponentByClass<UPinballScoreComponent>())
+		{
+			NewScoreOwner = GameModeScore;
+		}
+	}
+
+	// Without a game mode, such as on clients, hits are kept where they are registered
+	ScoreOwner = NewScoreOwner;
+	return NewScoreOwner;
+}
+
+void UPinballScoreComponent::UpdateMultiplier()
+{
+	int64 NewMultiplier = 1;
+	for (const FPinballScoreMultiplier& Entry : Multipliers)
+	{
+		NewMultiplier = FMath::Clamp<int64>(NewMultiplier * Entry.Multiplier, 0, MAX_int32);
+	}
+
+	if (NewMultiplier != Multiplier)
+	{
+		Multiplier = int32(NewMultiplier);
+		OnMultiplierChanged.Broadcast(Multiplier);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Throughput test
+
+static void BenchmarkScoringCommand(const TArray<FString>& Args)
+{
+	int32 NumHits = 1000000;
+	int32 HitsPerFrame = 32;
+	for (const FString& Arg : Args)
+	{
+		FParse::Value(*Arg, TEXT("Hits="), NumHits);
+		FParse::Value(*Arg, TEXT("HitsPerFrame="), HitsPerFrame);
+	}
+	NumHits = FMath::Max(NumHits, 1);
+	HitsPerFrame = FMath::Max(HitsPerFrame, 1);
+
+	UPinballScoreComponent* ScoreComponent = NewObject<UPinballScoreComponent>(GetTransientPackage());
+	ScoreComponent->PushMultiplier(TEXT("Playfield"), 2);
+	ScoreComponent->PushMultiplier(TEXT("Mode"), 3);
+
+	// Bumper, slingshot and target values, cycling
+	static const int32 HitPoints[] = { 100, 10, 500, 1000, 25000 };
+
+	// Resolved once per frame, as in game
+	const double QueuedStartTime = FPlatformTime::Seconds();
+	for (int32 HitIndex = 0; HitIndex < NumHits; ++HitIndex)
+	{
+		ScoreComponent->RegisterScore(HitPoints[HitIndex % UE_ARRAY_COUNT(HitPoints)]);
+		if ((HitIndex + 1) % HitsPerFrame == 0)
+		{
+			ScoreComponent->ResolveHits();
+		}
+	}
+	ScoreComponent->ResolveHits();
+	const double QueuedTime = FPlatformTime::Seconds() - QueuedStartTime;
+	const int64 QueuedScore = ScoreComponent->GetScore();
+
+	// Resolved after every hit, as when each hit updated the score and the HUD
+	ScoreComponent->ResetScore();
+	const double ImmediateStartTime = FPlatformTime::Seconds();
+	for (int32 HitIndex = 0; HitIndex < NumHits; ++HitIndex)
+	{
+		ScoreComponent->RegisterScore(HitPoints[HitIndex % UE_ARRAY_COUNT(HitPoints)]);
+		ScoreComponent->ResolveHits();
+	}
+	const double ImmediateTime = FPlatformTime::Seconds() - ImmediateStartTime;
+
+	UE_LOG(LogPinballScore, Log, TEXT("BenchmarkScoring: %d hit(s) at x%d, score %lld"), NumHits, ScoreComponent->GetMultiplier(), QueuedScore);
+	UE_LOG(LogPinballScore, Log, TEXT("BenchmarkScoring: queued %d per frame %.1f million hits/s, %d resolve(s); resolved per hit %.1f million hits/s, %d resolve(s)"),
+		HitsPerFrame, NumHits / FMath::Max(QueuedTime, 1.0e-9) / 1.0e6, FMath::DivideAndRoundUp(NumHits, HitsPerFrame),
+		NumHits / FMath::Max(ImmediateTime, 1.0e-9) / 1.0e6, NumHits);
+
+	if (QueuedScore != ScoreComponent->GetScore())
+	{
+		UE_LOG(LogPinballScore, Error, TEXT("BenchmarkScoring: queued and immediate scores differ, %lld and %lld"), QueuedScore, ScoreComponent->GetScore());
+	}
+}
+
+static FAutoConsoleCommand BenchmarkScoringConsoleCommand(
+	TEXT("Pinball.BenchmarkScoring"),
+	TEXT("Logs how many hits per second the score component resolves, queued per frame and one at a time. Usage: Pinball.BenchmarkScoring [Hits=N] [HitsPerFrame=N]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkScoringCommand));
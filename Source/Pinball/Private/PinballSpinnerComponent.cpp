@@ -0,0 +1,49 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballSpinnerComponent.h"
+
+UPinballSpinnerComponent::UPinballSpinnerComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, NumSpins(0)
+{
+}
+
+void UPinballSpinnerComponent::UpdateElement(float DeltaTime)
+{
+	Super::UpdateElement(DeltaTime);
+
+	if (PendingSpinTimes.Num() > 0)
+	{
+		const int32 NumNewSpins = PendingSpinTimes.Num();
+		NumSpins += NumNewSpins;
+
+		// One event per spin at the step it happened in, scored like any other hit, for the ball that last pushed the spinner
+		for (float SpinTime : PendingSpinTimes)
+		{
+			PostElementEvent(EPinballHitType::Spinner, ImpulseBallId, SpinTime);
+		}
+		PendingSpinTimes.Reset();
+		OnSpin.Broadcast(NumNewSpins);
+	}
+}
+
+void UPinballSpinnerComponent::OnBallCrossing(APinballBall* Ball, float CrossingSpeed)
+{
+	ApplyBallImpulse(Ball, CrossingSpeed);
+	WakeFlap();
+}
+
+void UPinballSpinnerComponent::OnStepped()
+{
+	// Kept within a turn of hanging down, counting a spin each time it goes over the top
+	while (Angle > PI)
+	{
+		Angle -= 2.0f * PI;
+		PendingSpinTimes.Add(StepEndTime);
+	}
+	while (Angle < -PI)
+	{
+		Angle += 2.0f * PI;
+		PendingSpinTimes.Add(StepEndTime);
+	}
+}
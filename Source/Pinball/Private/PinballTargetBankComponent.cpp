@@ -0,0 +1,148 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballTargetBankComponent.h"
+
+namespace PinballTargetBankDefs
+{
+	/** Most targets a bank can have, one per bit of its state */
+	const int32 MaxTargets = 64;
+}
+
+UPinballTargetBankComponent::UPinballTargetBankComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+int32 UPinballTargetBankComponent::AddBank(FName Name, int32 NumTargets, bool bResetOnComplete)
+{
+	FPinballTargetBank Bank;
+	Bank.Name = Name;
+	Bank.NumTargets = FMath::Clamp(NumTargets, 1, PinballTargetBankDefs::MaxTargets);
+	Bank.bResetOnComplete = bResetOnComplete;
+	return Banks.Add(Bank);
+}
+
+int32 UPinballTargetBankComponent::FindBank(FName Name) const
+{
+	return Banks.IndexOfByPredicate([Name](const FPinballTargetBank& Bank)
+	{
+		return Bank.Name == Name;
+	});
+}
+
+void UPinballTargetBankComponent::SetTarget(int32 BankIndex, int32 TargetIndex)
+{
+	if (Banks.IsValidIndex(BankIndex) && TargetIndex >= 0 && TargetIndex < Banks[BankIndex].NumTargets)
+	{
+		ChangeBankState(BankIndex, Banks[BankIndex].State | (uint64(1) << TargetIndex));
+	}
+}
+
+void UPinballTargetBankComponent::ClearTarget(int32 BankIndex, int32 TargetIndex)
+{
+	if (Banks.IsValidIndex(BankIndex) && TargetIndex >= 0 && TargetIndex < Banks[BankIndex].NumTargets)
+	{
+		ChangeBankState(BankIndex, Banks[BankIndex].State & ~(uint64(1) << TargetIndex));
+	}
+}
+
+void UPinballTargetBankComponent::ToggleTarget(int32 BankIndex, int32 TargetIndex)
+{
+	if (Banks.IsValidIndex(BankIndex) && TargetIndex >= 0 && TargetIndex < Banks[BankIndex].NumTargets)
+	{
+		ChangeBankState(BankIndex, Banks[BankIndex].State ^ (uint64(1) << TargetIndex));
+	}
+}
+
+bool UPinballTargetBankComponent::IsTargetSet(int32 BankIndex, int32 TargetIndex) const
+{
+	return Banks.IsValidIndex(BankIndex) && TargetIndex >= 0 && TargetIndex < Banks[BankIndex].NumTargets
+		&& (Banks[BankIndex].State & (uint64(1) << TargetIndex)) != 0;
+}
+
+bool UPinballTargetBankComponent::IsBankComplete(int32 BankIndex) const
+{
+	return Banks.IsValidIndex(BankIndex) && Banks[BankIndex].IsComplete();
+}
+
+int32 UPinballTargetBankComponent::GetNumSetTargets(int32 BankIndex) const
+{
+	return Banks.IsValidIndex(BankIndex) ? int32(FPlatformMath::CountBits(Banks[BankIndex].State)) : 0;
+}
+
+int64 UPinballTargetBankComponent::GetBankState(int32 BankIndex) const
+{
+	return Banks.IsValidIndex(BankIndex) ? int64(Banks[BankIndex].State) : 0;
+}
+
+void UPinballTargetBankComponent::SetBankState(int32 BankIndex, int64 NewState)
+{
+	if (Banks.IsValidIndex(BankIndex))
+	{
+		ChangeBankState(BankIndex, uint64(NewState) & Banks[BankIndex].GetMask());
+	}
+}
+
+void UPinballTargetBankComponent::ResetBank(int32 BankIndex)
+{
+	if (Banks.IsValidIndex(BankIndex))
+	{
+		ChangeBankState(BankIndex, 0);
+	}
+}
+
+void UPinballTargetBankComponent::ResetAllBanks()
+{
+	for (int32 BankIndex = 0; BankIndex < Banks.Num(); ++BankIndex)
+	{
+		ChangeBankState(BankIndex, 0);
+	}
+}
+
+void UPinballTargetBankComponent::RotateBank(int32 BankIndex, int32 Steps)
+{
+	if (!Banks.IsValidIndex(BankIndex))
+	{
+		return;
+	}
+
+	// Rotated within the bits of the bank, negative steps rotate the other way
+	const FPinballTargetBank& Bank = Banks[BankIndex];
+	const int32 NumTargets = FMath::Clamp(Bank.NumTargets, 1, PinballTargetBankDefs::MaxTargets);
+	const int32 Shift = ((Steps % NumTargets) + NumTargets) % NumTargets;
+	if (Shift == 0)
+	{
+		return;
+	}
+
+	const uint64 State = Bank.State & Bank.GetMask();
+	ChangeBankState(BankIndex, ((State << Shift) | (State >> (NumTargets - Shift))) & Bank.GetMask());
+}
+
+void UPinballTargetBankComponent::ChangeBankState(int32 BankIndex, uint64 NewState)
+{
+	FPinballTargetBank& Bank = Banks[BankIndex];
+	const uint64 OldState = Bank.State;
+	if (NewState == OldState)
+	{
+		return;
+	}
+
+	// Completion is decided on the state committed here, a listener changing the bank notifies its own transitions
+	const bool bWasComplete = Bank.IsComplete();
+	Bank.State = NewState;
+	const bool bCompleted = !bWasComplete && Bank.IsComplete();
+	OnBankChanged.Broadcast(BankIndex, int64(NewState), int64(NewState ^ OldState));
+
+	if (bCompleted)
+	{
+		OnBankCompleted.Broadcast(BankIndex);
+
+		// Unless listeners moved the bank on already
+		if (Banks.IsValidIndex(BankIndex) && Banks[BankIndex].bResetOnComplete && Banks[BankIndex].State == NewState)
+		{
+			ChangeBankState(BankIndex, 0);
+		}
+	}
+}
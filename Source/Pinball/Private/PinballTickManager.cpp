@@ -0,0 +1,439 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PinballTickManager.h"
+#include "PinballBall.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPinballTickManager, Log, All);
+
+namespace PinballTickManagerDefs
+{
+	const float DefaultNearDistance = 600.0f;
+	const float DefaultFarDistance = 1500.0f;
+	const float DefaultActivitySeconds = 1.0f;
+
+	/** Location of an element, that of its owner for components without one */
+	FVector GetElementLocation(const UObject* Element)
+	{
+		if (const USceneComponent* SceneComponent = Cast<USceneComponent>(Element))
+		{
+			return SceneComponent->GetComponentLocation();
+		}
+		else if (const UActorComponent* Component = Cast<UActorComponent>(Element))
+		{
+			return (Component->GetOwner() != nullptr) ? Component->GetOwner()->GetActorLocation() : FVector::ZeroVector;
+		}
+		else if (const AActor* Actor = Cast<AActor>(Element))
+		{
+			return Actor->GetActorLocation();
+		}
+		return FVector::ZeroVector;
+	}
+}
+
+UPinballTickManager::UPinballTickManager()
+	: bUseSignificance(true)
+	, NearDistance(PinballTickManagerDefs::DefaultNearDistance)
+	, FarDistance(PinballTickManagerDefs::DefaultFarDistance)
+	, ActivitySeconds(PinballTickManagerDefs::DefaultActivitySeconds)
+	, bUpdating(false)
+	, NumAwakeElements(0)
+	, FrameCounter(0)
+	, LastFrameSkippedFraction(0.0f)
+{
+}
+
+UPinballTickManager* UPinballTickManager::Get(const UWorld* World)
+{
+	return (World != nullptr) ? World->GetSubsystem<UPinballTickManager>() : nullptr;
+}
+
+void UPinballTickManager::RegisterElement(UObject* Element)
+{
+	// A new group would move the groups being updated
+	if (bUpdating)
+	{
+		PendingChanges.Emplace(Element, EPendingChange::Register);
+		return;
+	}
+
+	AddElement(Element);
+}
+
+void UPinballTickManager::UnregisterElement(UObject* Element)
+{
+	if (bUpdating)
+	{
+		PendingChanges.Emplace(Element, EPendingChange::Unregister);
+		return;
+	}
+
+	RemoveElement(Element);
+}
+
+void UPinballTickManager::SleepElement(UObject* Element)
+{
+	if (bUpdating)
+	{
+		PendingChanges.Emplace(Element, EPendingChange::Sleep);
+		return;
+	}
+
+	SetElementAwake(Element, false);
+}
+
+void UPinballTickManager::WakeElement(UObject* Element)
+{
+	if (bUpdating)
+	{
+		PendingChanges.Emplace(Element, EPendingChange::Wake);
+		return;
+	}
+
+	SetElementAwake(Element, true);
+}
+
+bool UPinballTickManager::IsElementAwake(const UObject* Element) const
+{
+	const FElementHandle* Handle = Elements.Find(Element);
+	return Handle != nullptr && Handle->AwakeIndex != INDEX_NONE;
+}
+
+void UPinballTickManager::NoteElementActivity(UObject* Element)
+{
+	const FElementHandle* Handle = Elements.Find(Element);
+	if (Handle == nullptr)
+	{
+		return;
+	}
+
+	// Woken elements start as active
+	if (Handle->AwakeIndex != INDEX_NONE)
+	{
+		Groups[Handle->GroupIndex].AwakeElements[Handle->AwakeIndex].LastActivityTime = GetWorld()->GetTimeSeconds();
+	}
+	else
+	{
+		WakeElement(Element);
+	}
+}
+
+EPinballSignificance UPinballTickManager::GetElementSignificance(const UObject* Element) const
+{
+	const FElementHandle* Handle = Elements.Find(Element);
+	return (Handle != nullptr && Handle->AwakeIndex != INDEX_NONE) ? Groups[Handle->GroupIndex].AwakeElements[Handle->AwakeIndex].Significance : EPinballSignificance::High;
+}
+
+void UPinballTickManager::GetStats(TArray<FPinballUpdaterStats>& OutStats) const
+{
+	OutStats.Reset(Groups.Num());
+	for (const FUpdaterGroup& Group : Groups)
+	{
+		FPinballUpdaterStats& Stats = OutStats.AddDefaulted_GetRef();
+		Stats.Class = Group.Class;
+		Stats.NumElements = Group.NumElements;
+		Stats.NumAwake = Group.AwakeElements.Num();
+		Stats.NumUpdatedFrames = Group.NumUpdatedFrames;
+		Stats.NumUpdates = Group.NumUpdates;
+		Stats.NumSkippedUpdates = Group.NumSkippedUpdates;
+		Stats.NumCycles = Group.NumCycles;
+	}
+}
+
+void UPinballTickManager::ResetStats()
+{
+	for (FUpdaterGroup& Group : Groups)
+	{
+		Group.NumUpdatedFrames = 0;
+		Group.NumUpdates = 0;
+		Group.NumSkippedUpdates = 0;
+		Group.NumCycles = 0;
+	}
+}
+
+void UPinballTickManager::Deinitialize()
+{
+	Groups.Reset();
+	Elements.Reset();
+	PendingChanges.Reset();
+	NumAwakeElements = 0;
+
+	Super::Deinitialize();
+}
+
+void UPinballTickManager::Tick(float DeltaTime)
+{
+	// Significance is worked out every frame, so an element a ball comes near is updated on that frame
+	TArray<FVector, TInlineAllocator<8>> BallLocations;
+	if (bUseSignificance)
+	{
+		for (TActorIterator<APinballBall> It(GetWorld()); It; ++It)
+		{
+			if (!It->IsHidden())
+			{
+				BallLocations.Add(It->GetActorLocation());
+			}
+		}
+	}
+	const float Time = GetWorld()->GetTimeSeconds();
+	++FrameCounter;
+
+	int32 NumScheduled = 0;
+	int32 NumSkipped = 0;
+	bUpdating = true;
+	for (FUpdaterGroup& Group : Groups)
+	{
+		const int32 NumAwake = Group.AwakeElements.Num();
+		if (NumAwake == 0)
+		{
+			continue;
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		int32 NumGroupSkipped = 0;
+		FAwakeElement* AwakeElements = Group.AwakeElements.GetData();
+		for (int32 ElementIndex = 0; ElementIndex < NumAwake; ++ElementIndex)
+		{
+			FAwakeElement& Element = AwakeElements[ElementIndex];
+			if (!Element.Object.IsValid())
+			{
+				UE_LOG(LogPinballTickManager, Warning, TEXT("An element of %s was destroyed without being unregistered"), *GetNameSafe(Group.Class));
+				PendingChanges.Emplace(Element.Object, EPendingChange::Unregister);
+				continue;
+			}
+			Element.AccumulatedDeltaTime += DeltaTime;
+
+			const EPinballSignificance Significance = bUseSignificance ? GetSignificance(Element, BallLocations, Time) : EPinballSignificance::High;
+			if (Significance != Element.Significance)
+			{
+				Element.Significance = Significance;
+				Element.Updater->SetElementSignificance(Significance);
+			}
+
+			// Updated every 1, 2 or 4 frames, staggered by index so the updates spread over the frames
+			const uint32 IntervalMask = (1u << uint32(Significance)) - 1;
+			if (((FrameCounter + uint32(ElementIndex)) & IntervalMask) != 0)
+			{
+				++NumGroupSkipped;
+				continue;
+			}
+
+			Element.Updater->UpdateElement(Element.AccumulatedDeltaTime);
+			Element.AccumulatedDeltaTime = 0.0f;
+		}
+		Group.NumCycles += FPlatformTime::Cycles64() - StartCycles;
+		Group.NumUpdates += NumAwake - NumGroupSkipped;
+		Group.NumSkippedUpdates += NumGroupSkipped;
+		++Group.NumUpdatedFrames;
+
+		NumScheduled += NumAwake;
+		NumSkipped += NumGroupSkipped;
+	}
+	bUpdating = false;
+
+	LastFrameSkippedFraction = (NumScheduled > 0) ? float(NumSkipped) / NumScheduled : 0.0f;
+
+	ApplyPendingChanges();
+}
+
+ETickableTickType UPinballTickManager::GetTickableTickType() const
+{
+	// The class default object is never ticked
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UPinballTickManager::IsTickable() const
+{
+	return NumAwakeElements > 0;
+}
+
+UWorld* UPinballTickManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UPinballTickManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPinballTickManager, STATGROUP_Tickables);
+}
+
+void UPinballTickManager::AddElement(UObject* Element)
+{
+	if (Element == nullptr || Elements.Contains(Element))
+	{
+		return;
+	}
+
+	IPinballElementUpdater* Updater = Cast<IPinballElementUpdater>(Element);
+	if (Updater == nullptr)
+	{
+		UE_LOG(LogPinballTickManager, Warning, TEXT("%s doesn't implement IPinballElementUpdater"), *Element->GetPathName());
+		return;
+	}
+
+	const UClass* Class = Element->GetClass();
+	int32 GroupIndex = Groups.IndexOfByPredicate([Class](const FUpdaterGroup& Group) { return Group.Class == Class; });
+	if (GroupIndex == INDEX_NONE)
+	{
+		GroupIndex = Groups.Add(FUpdaterGroup{ Class });
+	}
+	++Groups[GroupIndex].NumElements;
+
+	Elements.Add(Element, FElementHandle{ GroupIndex, INDEX_NONE });
+	WakeElement(Element);
+}
+
+void UPinballTickManager::SetElementAwake(UObject* Element, bool bAwake)
+{
+	FElementHandle* Handle = Elements.Find(Element);
+	if (Handle == nullptr || (Handle->AwakeIndex != INDEX_NONE) == bAwake)
+	{
+		return;
+	}
+
+	if (!bAwake)
+	{
+		RemoveAwakeElement(*Handle);
+		return;
+	}
+
+	FAwakeElement AwakeElement;
+	AwakeElement.Object = Element;
+	AwakeElement.Updater = Cast<IPinballElementUpdater>(Element);
+	AwakeElement.Location = PinballTickManagerDefs::GetElementLocation(Element);
+	AwakeElement.AccumulatedDeltaTime = 0.0f;
+	AwakeElement.LastActivityTime = GetWorld()->GetTimeSeconds();
+	AwakeElement.Significance = EPinballSignificance::High;
+	Handle->AwakeIndex = Groups[Handle->GroupIndex].AwakeElements.Add(AwakeElement);
+	++NumAwakeElements;
+}
+
+void UPinballTickManager::RemoveAwakeElement(FElementHandle& Handle)
+{
+	// The last awake element takes its place, the order elements of a class are updated in doesn't matter
+	TArray<FAwakeElement>& AwakeElements = Groups[Handle.GroupIndex].AwakeElements;
+	const int32 AwakeIndex = Handle.AwakeIndex;
+	AwakeElements.RemoveAtSwap(AwakeIndex, 1, false);
+	if (AwakeElements.IsValidIndex(AwakeIndex))
+	{
+		Elements.FindChecked(AwakeElements[AwakeIndex].Object).AwakeIndex = AwakeIndex;
+	}
+	Handle.AwakeIndex = INDEX_NONE;
+	--NumAwakeElements;
+}
+
+EPinballSignificance UPinballTickManager::GetSignificance(const FAwakeElement& Element, TArrayView<const FVector> BallLocations, float Time) const
+{
+	if (Time - Element.LastActivityTime < ActivitySeconds)
+	{
+		return EPinballSignificance::High;
+	}
+
+	float MinDistanceSquared = MAX_flt;
+	for (const FVector& BallLocation : BallLocations)
+	{
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(BallLocation, Element.Location));
+	}
+
+	if (MinDistanceSquared < FMath::Square(NearDistance))
+	{
+		return EPinballSignificance::High;
+	}
+	return (MinDistanceSquared < FMath::Square(FarDistance)) ? EPinballSignificance::Medium : EPinballSignificance::Low;
+}
+
+void UPinballTickManager::RemoveElement(const TWeakObjectPtr<const UObject>& Element)
+{
+	FElementHandle* Handle = Elements.Find(Element);
+	if (Handle == nullptr)
+	{
+		return;
+	}
+
+	if (Handle->AwakeIndex != INDEX_NONE)
+	{
+		RemoveAwakeElement(*Handle);
+	}
+	--Groups[Handle->GroupIndex].NumElements;
+	Elements.Remove(Element);
+}
+
+void UPinballTickManager::ApplyPendingChanges()
+{
+	// In the order they were made, an element put to sleep then woken in the same update stays awake
+	for (const TPair<TWeakObjectPtr<UObject>, EPendingChange>& PendingChange : PendingChanges)
+	{
+		UObject* Element = PendingChange.Key.Get();
+		if (Element == nullptr)
+		{
+			// Collected since, whatever the change
+			RemoveElement(PendingChange.Key);
+			continue;
+		}
+
+		switch (PendingChange.Value)
+		{
+		case EPendingChange::Register:
+			AddElement(Element);
+			break;
+		case EPendingChange::Sleep:
+			SetElementAwake(Element, false);
+			break;
+		case EPendingChange::Wake:
+			SetElementAwake(Element, true);
+			break;
+		case EPendingChange::Unregister:
+			RemoveElement(PendingChange.Key);
+			break;
+		}
+	}
+	PendingChanges.Reset();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Update cost report
+
+static void ReportTickManagerCommand(const TArray<FString>& Args, UWorld* World)
+{
+	UPinballTickManager* TickManager = UPinballTickManager::Get(World);
+	if (TickManager == nullptr)
+	{
+		return;
+	}
+
+	TArray<FPinballUpdaterStats> AllStats;
+	TickManager->GetStats(AllStats);
+	AllStats.Sort([](const FPinballUpdaterStats& A, const FPinballUpdaterStats& B)
+	{
+		return A.NumCycles > B.NumCycles;
+	});
+
+	UE_LOG(LogPinballTickManager, Log, TEXT("%-32s %8s %8s %12s %12s %10s"), TEXT("Class"), TEXT("Elements"), TEXT("Awake"), TEXT("us/frame"), TEXT("ns/update"), TEXT("Skipped"));
+	int64 NumUpdates = 0;
+	int64 NumSkippedUpdates = 0;
+	for (const FPinballUpdaterStats& Stats : AllStats)
+	{
+		const double Seconds = FPlatformTime::ToSeconds64(Stats.NumCycles);
+		const int64 NumScheduled = Stats.NumUpdates + Stats.NumSkippedUpdates;
+		UE_LOG(LogPinballTickManager, Log, TEXT("%-32s %8d %8d %12.2f %12.1f %9.1f%%"), *GetNameSafe(Stats.Class), Stats.NumElements, Stats.NumAwake,
+			(Stats.NumUpdatedFrames > 0) ? Seconds * 1.0e6 / Stats.NumUpdatedFrames : 0.0,
+			(Stats.NumUpdates > 0) ? Seconds * 1.0e9 / Stats.NumUpdates : 0.0,
+			(NumScheduled > 0) ? 100.0 * Stats.NumSkippedUpdates / NumScheduled : 0.0);
+		NumUpdates += Stats.NumUpdates;
+		NumSkippedUpdates += Stats.NumSkippedUpdates;
+	}
+	UE_LOG(LogPinballTickManager, Log, TEXT("Updates skipped for significance: %.1f%% last frame, %.1f%% overall"), 100.0f * TickManager->GetSkippedUpdateFraction(),
+		(NumUpdates + NumSkippedUpdates > 0) ? 100.0 * NumSkippedUpdates / (NumUpdates + NumSkippedUpdates) : 0.0);
+
+	if (Args.Contains(TEXT("Reset")))
+	{
+		TickManager->ResetStats();
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ReportTickManagerConsoleCommand(
+	TEXT("Pinball.ReportTickManager"),
+	TEXT("Logs the update cost of each class of element of the tick manager, per frame it had awake elements and per element update, and the updates skipped for significance. Usage: Pinball.ReportTickManager [Reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ReportTickManagerCommand));
@@ -0,0 +1,734 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "PolygonClipping.h"
+#include "SplineGeometry.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPolygonClipping, Log, All);
+
+namespace PolygonClippingDefs
+{
+	/** Vertices closer than this are welded into one, so edges that meet or cross share the same vertex */
+	const float WeldDistance = 0.01f;
+
+	/** Distance from an edge at which the winding number on either side of it is measured, must be larger than WeldDistance */
+	const float SideSampleDistance = 0.05f;
+
+	/** Edges whose directions are closer than this, as the sine of the angle between them, are tested for overlap rather than crossing */
+	const float ParallelSineThreshold = 0.0001f;
+
+	/** Loops with a smaller area than this are slivers left over by welding */
+	const float MinLoopArea = 0.01f;
+
+	FORCEINLINE float Cross(const FVector2D& A, const FVector2D& B)
+	{
+		return A.X * B.Y - A.Y * B.X;
+	}
+
+	FORCEINLINE uint64 MakePairKey(int32 A, int32 B)
+	{
+		return ((uint64)(uint32)A << 32) | (uint64)(uint32)B;
+	}
+
+	/** Edge between two welded vertices */
+	struct FClipEdge
+	{
+		FClipEdge(int32 InStartVertex, int32 InEndVertex)
+			: StartVertex(InStartVertex)
+			, EndVertex(InEndVertex)
+		{}
+
+		int32 StartVertex;
+		int32 EndVertex;
+	};
+
+	/** Vertex that splits an edge, Alpha is the fraction along the edge */
+	struct FEdgeSplit
+	{
+		FEdgeSplit(int32 InEdge, float InAlpha, int32 InVertex)
+			: Edge(InEdge)
+			, Alpha(InAlpha)
+			, Vertex(InVertex)
+		{}
+
+		int32 Edge;
+		float Alpha;
+		int32 Vertex;
+	};
+
+	/** Welds vertices closer than WeldDistance, using a hash grid with cells of that size */
+	class FVertexWelder
+	{
+	public:
+		TArray<FVector2D> Vertices;
+
+		int32 AddVertex(const FVector2D& Location)
+		{
+			const FIntPoint Cell(FMath::FloorToInt(Location.X / WeldDistance), FMath::FloorToInt(Location.Y / WeldDistance));
+			for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+			{
+				for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+				{
+					if (const TArray<int32>* CellVertices = Grid.Find(Cell + FIntPoint(OffsetX, OffsetY)))
+					{
+						for (int32 VertexIndex : *CellVertices)
+						{
+							if (FVector2D::DistSquared(Vertices[VertexIndex], Location) <= FMath::Square(WeldDistance))
+							{
+								return VertexIndex;
+							}
+						}
+					}
+				}
+			}
+
+			const int32 VertexIndex = Vertices.Add(Location);
+			Grid.FindOrAdd(Cell).Add(VertexIndex);
+			return VertexIndex;
+		}
+
+	private:
+		TMap<FIntPoint, TArray<int32>> Grid;
+	};
+
+	/** Winding number of a set of edges, bucketed in horizontal bands so a query only visits the edges that span its band */
+	class FWindingLookup
+	{
+	public:
+		FWindingLookup(const TArray<FVector2D>& InVertices, const TArray<FClipEdge>& InEdges)
+			: Vertices(InVertices)
+			, Edges(InEdges)
+			, MinY(BIG_NUMBER)
+			, MaxY(-BIG_NUMBER)
+		{
+			for (const FClipEdge& Edge : Edges)
+			{
+				MinY = FMath::Min3(MinY, Vertices[Edge.StartVertex].Y, Vertices[Edge.EndVertex].Y);
+				MaxY = FMath::Max3(MaxY, Vertices[Edge.StartVertex].Y, Vertices[Edge.EndVertex].Y);
+			}
+
+			NumBands = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)Edges.Num())));
+			BandHeight = FMath::Max((MaxY - MinY) / NumBands, KINDA_SMALL_NUMBER);
+			Bands.SetNum(NumBands);
+			for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
+			{
+				const float StartY = Vertices[Edges[EdgeIndex].StartVertex].Y;
+				const float EndY = Vertices[Edges[EdgeIndex].EndVertex].Y;
+				const int32 LastBand = GetBand(FMath::Max(StartY, EndY));
+				for (int32 Band = GetBand(FMath::Min(StartY, EndY)); Band <= LastBand; ++Band)
+				{
+					Bands[Band].Add(EdgeIndex);
+				}
+			}
+		}
+
+		int32 GetWindingNumber(const FVector2D& Point) const
+		{
+			if (Point.Y < MinY || Point.Y > MaxY)
+			{
+				return 0;
+			}
+
+			int32 WindingNumber = 0;
+			for (int32 EdgeIndex : Bands[GetBand(Point.Y)])
+			{
+				const FVector2D& Start = Vertices[Edges[EdgeIndex].StartVertex];
+				const FVector2D& End = Vertices[Edges[EdgeIndex].EndVertex];
+				if (Start.Y <= Point.Y)
+				{
+					if (End.Y > Point.Y && Cross(End - Start, Point - Start) > 0.0f)
+					{
+						++WindingNumber;
+					}
+				}
+				else if (End.Y <= Point.Y && Cross(End - Start, Point - Start) < 0.0f)
+				{
+					--WindingNumber;
+				}
+			}
+			return WindingNumber;
+		}
+
+	private:
+		int32 GetBand(float Y) const
+		{
+			return FMath::Clamp(FMath::FloorToInt((Y - MinY) / BandHeight), 0, NumBands - 1);
+		}
+
+		const TArray<FVector2D>& Vertices;
+		const TArray<FClipEdge>& Edges;
+		TArray<TArray<int32>> Bands;
+		float MinY;
+		float MaxY;
+		float BandHeight;
+		int32 NumBands;
+	};
+
+	void AddSplit(int32 EdgeIndex, const FClipEdge& Edge, float Alpha, int32 Vertex, TArray<FEdgeSplit>& OutSplits)
+	{
+		if (Vertex != Edge.StartVertex && Vertex != Edge.EndVertex)
+		{
+			OutSplits.Emplace(EdgeIndex, FMath::Clamp(Alpha, 0.0f, 1.0f), Vertex);
+		}
+	}
+
+	/** Splits an edge where the end of a collinear edge lies on it */
+	void AddOverlapSplit(int32 EdgeIndex, const FClipEdge& Edge, const FVector2D& Start, const FVector2D& Delta, float Length, int32 Vertex, const FVector2D& Location, TArray<FEdgeSplit>& OutSplits)
+	{
+		const float Alpha = FVector2D::DotProduct(Location - Start, Delta) / (Length * Length);
+		const float Tolerance = WeldDistance / Length;
+		if (Alpha > Tolerance && Alpha < 1.0f - Tolerance)
+		{
+			AddSplit(EdgeIndex, Edge, Alpha, Vertex, OutSplits);
+		}
+	}
+
+	/** Finds where two edges cross or overlap, and records the vertices that split them */
+	void SplitEdgePair(int32 EdgeIndexA, int32 EdgeIndexB, const TArray<FClipEdge>& Edges, FVertexWelder& Welder, TArray<FEdgeSplit>& OutSplits)
+	{
+		const FClipEdge& EdgeA = Edges[EdgeIndexA];
+		const FClipEdge& EdgeB = Edges[EdgeIndexB];
+
+		// Copies, adding a vertex may reallocate the welder vertices
+		const FVector2D StartA = Welder.Vertices[EdgeA.StartVertex];
+		const FVector2D StartB = Welder.Vertices[EdgeB.StartVertex];
+		const FVector2D EndA = Welder.Vertices[EdgeA.EndVertex];
+		const FVector2D EndB = Welder.Vertices[EdgeB.EndVertex];
+		const FVector2D DeltaA = EndA - StartA;
+		const FVector2D DeltaB = EndB - StartB;
+		const float LengthA = DeltaA.Size();
+		const float LengthB = DeltaB.Size();
+		if (LengthA < KINDA_SMALL_NUMBER || LengthB < KINDA_SMALL_NUMBER)
+		{
+			return;
+		}
+
+		const float Denominator = Cross(DeltaA, DeltaB);
+		if (FMath::Abs(Denominator) > ParallelSineThreshold * LengthA * LengthB)
+		{
+			const FVector2D StartDelta = StartB - StartA;
+			const float AlphaA = Cross(StartDelta, DeltaB) / Denominator;
+			const float AlphaB = Cross(StartDelta, DeltaA) / Denominator;
+
+			// Allow for the weld distance at the ends, so an edge ending on another one splits it
+			const float ToleranceA = WeldDistance / LengthA;
+			const float ToleranceB = WeldDistance / LengthB;
+			if (AlphaA < -ToleranceA || AlphaA > 1.0f + ToleranceA || AlphaB < -ToleranceB || AlphaB > 1.0f + ToleranceB)
+			{
+				return;
+			}
+
+			// Crossings at the end of either edge reuse its end vertex
+			int32 Vertex = INDEX_NONE;
+			if (AlphaA <= ToleranceA)
+			{
+				Vertex = EdgeA.StartVertex;
+			}
+			else if (AlphaA >= 1.0f - ToleranceA)
+			{
+				Vertex = EdgeA.EndVertex;
+			}
+			else if (AlphaB <= ToleranceB)
+			{
+				Vertex = EdgeB.StartVertex;
+			}
+			else if (AlphaB >= 1.0f - ToleranceB)
+			{
+				Vertex = EdgeB.EndVertex;
+			}
+			else
+			{
+				Vertex = Welder.AddVertex(StartA + DeltaA * AlphaA);
+			}
+
+			AddSplit(EdgeIndexA, EdgeA, AlphaA, Vertex, OutSplits);
+			AddSplit(EdgeIndexB, EdgeB, AlphaB, Vertex, OutSplits);
+			return;
+		}
+
+		// Parallel edges only matter when they overlap on the same line, each is split where the other one ends
+		if (FMath::Abs(Cross(DeltaA, StartB - StartA)) > WeldDistance * LengthA)
+		{
+			return;
+		}
+
+		AddOverlapSplit(EdgeIndexA, EdgeA, StartA, DeltaA, LengthA, EdgeB.StartVertex, StartB, OutSplits);
+		AddOverlapSplit(EdgeIndexA, EdgeA, StartA, DeltaA, LengthA, EdgeB.EndVertex, EndB, OutSplits);
+		AddOverlapSplit(EdgeIndexB, EdgeB, StartB, DeltaB, LengthB, EdgeA.StartVertex, StartA, OutSplits);
+		AddOverlapSplit(EdgeIndexB, EdgeB, StartB, DeltaB, LengthB, EdgeA.EndVertex, EndA, OutSplits);
+	}
+
+	/** Whether two segments cross each other, touching at an end doesn't count */
+	bool DoSegmentsCross(const FVector2D& StartA, const FVector2D& EndA, const FVector2D& StartB, const FVector2D& EndB)
+	{
+		const float SideStartB = Cross(EndA - StartA, StartB - StartA);
+		const float SideEndB = Cross(EndA - StartA, EndB - StartA);
+		const float SideStartA = Cross(EndB - StartB, StartA - StartB);
+		const float SideEndA = Cross(EndB - StartB, EndA - StartB);
+		return SideStartB * SideEndB < 0.0f && SideStartA * SideEndA < 0.0f;
+	}
+
+	/** Whether a bridge between two vertices doesn't cross any edge of the polygon or of the holes */
+	bool IsBridgeClear(const FVector2D& BridgeStart, const FVector2D& BridgeEnd, const TArray<FVector2D>& Polygon, const TArray<TArray<FVector2D>>& Holes)
+	{
+		auto CrossesLoop = [&BridgeStart, &BridgeEnd](const TArray<FVector2D>& Loop)
+		{
+			for (int32 VertexIndex = 0; VertexIndex < Loop.Num(); ++VertexIndex)
+			{
+				const FVector2D& EdgeStart = Loop[VertexIndex];
+				const FVector2D& EdgeEnd = Loop[(VertexIndex + 1) % Loop.Num()];
+				if (EdgeStart == BridgeStart || EdgeStart == BridgeEnd || EdgeEnd == BridgeStart || EdgeEnd == BridgeEnd)
+				{
+					continue;
+				}
+				if (DoSegmentsCross(BridgeStart, BridgeEnd, EdgeStart, EdgeEnd))
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+
+		if (CrossesLoop(Polygon))
+		{
+			return false;
+		}
+		for (const TArray<FVector2D>& Hole : Holes)
+		{
+			if (CrossesLoop(Hole))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Distance from a point to a segment */
+	float GetDistanceToSegment(const FVector2D& Point, const FVector2D& Start, const FVector2D& End)
+	{
+		const FVector2D Delta = End - Start;
+		const float LengthSquared = Delta.SizeSquared();
+		const float Alpha = (LengthSquared > SMALL_NUMBER) ? FMath::Clamp(FVector2D::DotProduct(Point - Start, Delta) / LengthSquared, 0.0f, 1.0f) : 0.0f;
+		return FVector2D::Distance(Point, Start + Delta * Alpha);
+	}
+}
+
+void FPolygonClipping::Union(const TArray<TArray<FVector2D>>& Polygons, TArray<FPolygonWithHoles>& OutPolygons)
+{
+	using namespace PolygonClippingDefs;
+
+	OutPolygons.Reset();
+
+	// Weld the vertices and orient every polygon counter clockwise, so the union is wherever the winding number is positive
+	FVertexWelder Welder;
+	TArray<FClipEdge> Edges;
+	TArray<int32> PolygonVertices;
+	for (const TArray<FVector2D>& Polygon : Polygons)
+	{
+		if (Polygon.Num() < 3)
+		{
+			continue;
+		}
+
+		const bool bReverse = FSplineGeometry::GetSignedArea(Polygon) < 0.0f;
+		PolygonVertices.Reset(Polygon.Num());
+		for (int32 VertexIndex = 0; VertexIndex < Polygon.Num(); ++VertexIndex)
+		{
+			const int32 Vertex = Welder.AddVertex(Polygon[bReverse ? Polygon.Num() - 1 - VertexIndex : VertexIndex]);
+			if (PolygonVertices.Num() == 0 || PolygonVertices.Last() != Vertex)
+			{
+				PolygonVertices.Add(Vertex);
+			}
+		}
+		while (PolygonVertices.Num() > 1 && PolygonVertices.Last() == PolygonVertices[0])
+		{
+			PolygonVertices.Pop(false);
+		}
+		if (PolygonVertices.Num() < 3)
+		{
+			continue;
+		}
+
+		for (int32 VertexIndex = 0; VertexIndex < PolygonVertices.Num(); ++VertexIndex)
+		{
+			Edges.Emplace(PolygonVertices[VertexIndex], PolygonVertices[(VertexIndex + 1) % PolygonVertices.Num()]);
+		}
+	}
+
+	if (Edges.Num() == 0)
+	{
+		return;
+	}
+
+	// Bucket the edges in a grid about twice the average edge length, so only nearby edges are tested against each other
+	float TotalLength = 0.0f;
+	for (const FClipEdge& Edge : Edges)
+	{
+		TotalLength += FVector2D::Distance(Welder.Vertices[Edge.StartVertex], Welder.Vertices[Edge.EndVertex]);
+	}
+	const float CellSize = FMath::Max(2.0f * TotalLength / Edges.Num(), 4.0f * WeldDistance);
+
+	TMap<FIntPoint, TArray<int32>> Grid;
+	TSet<uint64> TestedPairs;
+	TArray<FEdgeSplit> Splits;
+	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
+	{
+		const FVector2D& Start = Welder.Vertices[Edges[EdgeIndex].StartVertex];
+		const FVector2D& End = Welder.Vertices[Edges[EdgeIndex].EndVertex];
+		const FIntPoint MinCell(FMath::FloorToInt((FMath::Min(Start.X, End.X) - WeldDistance) / CellSize), FMath::FloorToInt((FMath::Min(Start.Y, End.Y) - WeldDistance) / CellSize));
+		const FIntPoint MaxCell(FMath::FloorToInt((FMath::Max(Start.X, End.X) + WeldDistance) / CellSize), FMath::FloorToInt((FMath::Max(Start.Y, End.Y) + WeldDistance) / CellSize));
+
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+			{
+				TArray<int32>& CellEdges = Grid.FindOrAdd(FIntPoint(CellX, CellY));
+				for (int32 OtherEdgeIndex : CellEdges)
+				{
+					bool bAlreadyTested = false;
+					TestedPairs.Add(MakePairKey(OtherEdgeIndex, EdgeIndex), &bAlreadyTested);
+					if (!bAlreadyTested)
+					{
+						SplitEdgePair(OtherEdgeIndex, EdgeIndex, Edges, Welder, Splits);
+					}
+				}
+				CellEdges.Add(EdgeIndex);
+			}
+		}
+	}
+
+	// Cut the edges into pieces at their splits, identical pieces from stacked outlines are only kept once
+	Splits.Sort([](const FEdgeSplit& A, const FEdgeSplit& B)
+	{
+		return (A.Edge != B.Edge) ? A.Edge < B.Edge : A.Alpha < B.Alpha;
+	});
+
+	TArray<FClipEdge> Pieces;
+	Pieces.Reserve(Edges.Num() + Splits.Num());
+	TSet<uint64> PieceKeys;
+	auto AddPiece = [&Pieces, &PieceKeys](int32 StartVertex, int32 EndVertex)
+	{
+		bool bAlreadyAdded = false;
+		if (StartVertex != EndVertex)
+		{
+			PieceKeys.Add(MakePairKey(StartVertex, EndVertex), &bAlreadyAdded);
+			if (!bAlreadyAdded)
+			{
+				Pieces.Emplace(StartVertex, EndVertex);
+			}
+		}
+	};
+
+	int32 SplitIndex = 0;
+	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
+	{
+		int32 PieceStartVertex = Edges[EdgeIndex].StartVertex;
+		for (; SplitIndex < Splits.Num() && Splits[SplitIndex].Edge == EdgeIndex; ++SplitIndex)
+		{
+			AddPiece(PieceStartVertex, Splits[SplitIndex].Vertex);
+			PieceStartVertex = Splits[SplitIndex].Vertex;
+		}
+		AddPiece(PieceStartVertex, Edges[EdgeIndex].EndVertex);
+	}
+
+	// Keep the pieces on the boundary of the union, with the inside on their left and nothing on their right
+	const TArray<FVector2D>& Vertices = Welder.Vertices;
+	const FWindingLookup WindingLookup(Vertices, Edges);
+	TArray<FClipEdge> BoundaryPieces;
+	TMap<int32, TArray<int32, TInlineAllocator<2>>> OutgoingPieces;
+	for (const FClipEdge& Piece : Pieces)
+	{
+		const FVector2D& Start = Vertices[Piece.StartVertex];
+		const FVector2D& End = Vertices[Piece.EndVertex];
+		const FVector2D Delta = End - Start;
+		const float Length = Delta.Size();
+		if (Length < KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		const FVector2D Middle = (Start + End) * 0.5f;
+		const FVector2D SideOffset = FVector2D(-Delta.Y, Delta.X) / Length * FMath::Min(SideSampleDistance, Length * 0.5f);
+		if (WindingLookup.GetWindingNumber(Middle + SideOffset) > 0 && WindingLookup.GetWindingNumber(Middle - SideOffset) == 0)
+		{
+			OutgoingPieces.FindOrAdd(Piece.StartVertex).Add(BoundaryPieces.Num());
+			BoundaryPieces.Add(Piece);
+		}
+	}
+
+	// Link the boundary pieces into loops, turning as far left as possible where several leave the same vertex so touching loops stay apart
+	TBitArray<> UsedPieces(false, BoundaryPieces.Num());
+	TArray<int32> LoopVertices;
+	TArray<TArray<FVector2D>> Holes;
+	TArray<float> OuterAreas;
+	int32 NumOpenChains = 0;
+	for (int32 FirstPiece = 0; FirstPiece < BoundaryPieces.Num(); ++FirstPiece)
+	{
+		if (UsedPieces[FirstPiece])
+		{
+			continue;
+		}
+
+		const int32 LoopStartVertex = BoundaryPieces[FirstPiece].StartVertex;
+		LoopVertices.Reset();
+		bool bClosed = false;
+		for (int32 Piece = FirstPiece; Piece != INDEX_NONE;)
+		{
+			UsedPieces[Piece] = true;
+			const FClipEdge& Edge = BoundaryPieces[Piece];
+			LoopVertices.Add(Edge.StartVertex);
+			if (Edge.EndVertex == LoopStartVertex)
+			{
+				bClosed = true;
+				break;
+			}
+
+			const FVector2D IncomingDirection = Vertices[Edge.EndVertex] - Vertices[Edge.StartVertex];
+			int32 NextPiece = INDEX_NONE;
+			float BestTurn = -BIG_NUMBER;
+			if (const TArray<int32, TInlineAllocator<2>>* Candidates = OutgoingPieces.Find(Edge.EndVertex))
+			{
+				for (int32 Candidate : *Candidates)
+				{
+					if (UsedPieces[Candidate])
+					{
+						continue;
+					}
+
+					const FVector2D OutgoingDirection = Vertices[BoundaryPieces[Candidate].EndVertex] - Vertices[Edge.EndVertex];
+					const float Turn = FMath::Atan2(Cross(IncomingDirection, OutgoingDirection), FVector2D::DotProduct(IncomingDirection, OutgoingDirection));
+					if (Turn > BestTurn)
+					{
+						BestTurn = Turn;
+						NextPiece = Candidate;
+					}
+				}
+			}
+			Piece = NextPiece;
+		}
+
+		if (!bClosed)
+		{
+			++NumOpenChains;
+			continue;
+		}
+
+		TArray<FVector2D> Loop;
+		Loop.Reserve(LoopVertices.Num());
+		for (int32 Vertex : LoopVertices)
+		{
+			Loop.Add(Vertices[Vertex]);
+		}
+
+		// Splitting leaves vertices in the middle of straight edges
+		RemoveCollinearVertices(Loop, WeldDistance);
+
+		const float Area = FSplineGeometry::GetSignedArea(Loop);
+		if (Loop.Num() < 3 || FMath::Abs(Area) < MinLoopArea)
+		{
+			continue;
+		}
+
+		if (Area > 0.0f)
+		{
+			OutPolygons.AddDefaulted_GetRef().Outer = MoveTemp(Loop);
+			OuterAreas.Add(Area);
+		}
+		else
+		{
+			Holes.Add(MoveTemp(Loop));
+		}
+	}
+
+	if (NumOpenChains > 0)
+	{
+		UE_LOG(LogPolygonClipping, Warning, TEXT("Union: dropped %d boundary chain(s) that didn't close, the input polygons may be degenerate"), NumOpenChains);
+	}
+
+	// Each hole goes to the smallest outer boundary around it, tested just off its first edge on the side of the union
+	for (TArray<FVector2D>& Hole : Holes)
+	{
+		const FVector2D Delta = Hole[1] - Hole[0];
+		const float Length = Delta.Size();
+		const FVector2D TestPoint = (Hole[0] + Hole[1]) * 0.5f + FVector2D(-Delta.Y, Delta.X) / Length * FMath::Min(SideSampleDistance, Length * 0.5f);
+
+		int32 BestPolygon = INDEX_NONE;
+		for (int32 PolygonIndex = 0; PolygonIndex < OutPolygons.Num(); ++PolygonIndex)
+		{
+			if ((BestPolygon == INDEX_NONE || OuterAreas[PolygonIndex] < OuterAreas[BestPolygon]) && IsPointInPolygon(TestPoint, OutPolygons[PolygonIndex].Outer))
+			{
+				BestPolygon = PolygonIndex;
+			}
+		}
+
+		if (BestPolygon != INDEX_NONE)
+		{
+			OutPolygons[BestPolygon].Holes.Add(MoveTemp(Hole));
+		}
+	}
+}
+
+void FPolygonClipping::MakeKeyholePolygon(const FPolygonWithHoles& Polygon, TArray<FVector2D>& OutPolygon)
+{
+	using namespace PolygonClippingDefs;
+
+	OutPolygon = Polygon.Outer;
+	if (OutPolygon.Num() < 3)
+	{
+		return;
+	}
+
+	// Bridge the holes from right to left, starting from their rightmost vertex
+	TArray<int32> HoleOrder;
+	TArray<int32> RightmostVertices;
+	RightmostVertices.SetNum(Polygon.Holes.Num());
+	for (int32 HoleIndex = 0; HoleIndex < Polygon.Holes.Num(); ++HoleIndex)
+	{
+		const TArray<FVector2D>& Hole = Polygon.Holes[HoleIndex];
+		if (Hole.Num() < 3)
+		{
+			continue;
+		}
+
+		RightmostVertices[HoleIndex] = 0;
+		for (int32 VertexIndex = 1; VertexIndex < Hole.Num(); ++VertexIndex)
+		{
+			if (Hole[VertexIndex].X > Hole[RightmostVertices[HoleIndex]].X)
+			{
+				RightmostVertices[HoleIndex] = VertexIndex;
+			}
+		}
+		HoleOrder.Add(HoleIndex);
+	}
+
+	HoleOrder.Sort([&Polygon, &RightmostVertices](int32 A, int32 B)
+	{
+		return Polygon.Holes[A][RightmostVertices[A]].X > Polygon.Holes[B][RightmostVertices[B]].X;
+	});
+
+	TArray<int32> Candidates;
+	for (int32 HoleIndex : HoleOrder)
+	{
+		const TArray<FVector2D>& Hole = Polygon.Holes[HoleIndex];
+		const int32 HoleVertex = RightmostVertices[HoleIndex];
+		const FVector2D& HoleLocation = Hole[HoleVertex];
+
+		// Closest boundary vertex that can be reached without crossing an edge, including the bridges already made
+		Candidates.Reset(OutPolygon.Num());
+		for (int32 VertexIndex = 0; VertexIndex < OutPolygon.Num(); ++VertexIndex)
+		{
+			Candidates.Add(VertexIndex);
+		}
+		Candidates.Sort([&OutPolygon, &HoleLocation](int32 A, int32 B)
+		{
+			return FVector2D::DistSquared(OutPolygon[A], HoleLocation) < FVector2D::DistSquared(OutPolygon[B], HoleLocation);
+		});
+
+		int32 BridgeVertex = Candidates[0];
+		for (int32 Candidate : Candidates)
+		{
+			if (IsBridgeClear(OutPolygon[Candidate], HoleLocation, OutPolygon, Polygon.Holes))
+			{
+				BridgeVertex = Candidate;
+				break;
+			}
+		}
+
+		// Go around the hole from the bridge and come back along it
+		TArray<FVector2D> BridgedPolygon;
+		BridgedPolygon.Reserve(OutPolygon.Num() + Hole.Num() + 2);
+		BridgedPolygon.Append(OutPolygon.GetData(), BridgeVertex + 1);
+		for (int32 VertexOffset = 0; VertexOffset <= Hole.Num(); ++VertexOffset)
+		{
+			BridgedPolygon.Add(Hole[(HoleVertex + VertexOffset) % Hole.Num()]);
+		}
+		BridgedPolygon.Append(OutPolygon.GetData() + BridgeVertex, OutPolygon.Num() - BridgeVertex);
+		OutPolygon = MoveTemp(BridgedPolygon);
+	}
+}
+
+void FPolygonClipping::RemoveCollinearVertices(TArray<FVector2D>& Polygon, float Tolerance)
+{
+	using namespace PolygonClippingDefs;
+
+	const int32 NumVertices = Polygon.Num();
+	if (NumVertices <= 3)
+	{
+		return;
+	}
+
+	// The lowest, leftmost vertex is on the convex hull, so it is always kept
+	int32 FirstVertex = 0;
+	for (int32 VertexIndex = 1; VertexIndex < NumVertices; ++VertexIndex)
+	{
+		const FVector2D& Vertex = Polygon[VertexIndex];
+		if (Vertex.X < Polygon[FirstVertex].X || (Vertex.X == Polygon[FirstVertex].X && Vertex.Y < Polygon[FirstVertex].Y))
+		{
+			FirstVertex = VertexIndex;
+		}
+	}
+
+	auto GetVertex = [&Polygon, FirstVertex, NumVertices](int32 Offset) -> const FVector2D&
+	{
+		return Polygon[(FirstVertex + Offset) % NumVertices];
+	};
+
+	// Every skipped vertex has to stay within tolerance of the line that replaces it, not only the last one
+	auto CanSkipVertices = [&GetVertex, Tolerance](int32 StartOffset, int32 EndOffset)
+	{
+		for (int32 Offset = StartOffset + 1; Offset < EndOffset; ++Offset)
+		{
+			if (GetDistanceToSegment(GetVertex(Offset), GetVertex(StartOffset), GetVertex(EndOffset)) > Tolerance)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	TArray<FVector2D> KeptVertices;
+	KeptVertices.Reserve(NumVertices);
+	KeptVertices.Add(GetVertex(0));
+	for (int32 StartOffset = 0; StartOffset < NumVertices;)
+	{
+		int32 EndOffset = StartOffset + 1;
+		while (EndOffset < NumVertices && CanSkipVertices(StartOffset, EndOffset + 1))
+		{
+			++EndOffset;
+		}
+
+		if (EndOffset < NumVertices)
+		{
+			KeptVertices.Add(GetVertex(EndOffset));
+		}
+		StartOffset = EndOffset;
+	}
+
+	if (KeptVertices.Num() >= 3)
+	{
+		Polygon = MoveTemp(KeptVertices);
+	}
+}
+
+bool FPolygonClipping::IsPointInPolygon(const FVector2D& Point, const TArray<FVector2D>& Polygon)
+{
+	using namespace PolygonClippingDefs;
+
+	int32 WindingNumber = 0;
+	for (int32 VertexIndex = 0; VertexIndex < Polygon.Num(); ++VertexIndex)
+	{
+		const FVector2D& Start = Polygon[VertexIndex];
+		const FVector2D& End = Polygon[(VertexIndex + 1) % Polygon.Num()];
+		if (Start.Y <= Point.Y)
+		{
+			if (End.Y > Point.Y && Cross(End - Start, Point - Start) > 0.0f)
+			{
+				++WindingNumber;
+			}
+		}
+		else if (End.Y <= Point.Y && Cross(End - Start, Point - Start) < 0.0f)
+		{
+			--WindingNumber;
+		}
+	}
+	return WindingNumber != 0;
+}
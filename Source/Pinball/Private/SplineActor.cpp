@@ -3,10 +3,118 @@
 #include "SplineActor.h"
 #include "Components/SplineComponent.h"
 #include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "SplineGeometry.h"
+
+namespace SplineActorDefs
+{
+	/** Matches the conversion the SplineComponent does internally, which isn't exported */
+	EInterpCurveMode ConvertSplinePointTypeToInterpCurveMode(ESplinePointType::Type SplinePointType)
+	{
+		switch (SplinePointType)
+		{
+		case ESplinePointType::Linear:				return CIM_Linear;
+		case ESplinePointType::Curve:				return CIM_CurveAuto;
+		case ESplinePointType::Constant:			return CIM_Constant;
+		case ESplinePointType::CurveClamped:		return CIM_CurveAutoClamped;
+		case ESplinePointType::CurveCustomTangent:	return CIM_CurveUser;
+		default:									return CIM_Unknown;
+		}
+	}
+
+	/** Input keys have to run 0, 1, 2... after points were added or removed in the middle of the spline */
+	void RenumberSplineInputKeys(FSplineCurves& SplineCurves)
+	{
+		for (int32 SplinePointIndex = 0; SplinePointIndex < SplineCurves.Position.Points.Num(); ++SplinePointIndex)
+		{
+			SplineCurves.Position.Points[SplinePointIndex].InVal = SplinePointIndex;
+			SplineCurves.Rotation.Points[SplinePointIndex].InVal = SplinePointIndex;
+			SplineCurves.Scale.Points[SplinePointIndex].InVal = SplinePointIndex;
+		}
+	}
+
+	/** Number of samples taken along each spline segment to measure the error of a simplified segment */
+	const int32 SimplifySamplesPerSegment = 8;
+
+	/**
+	* Distance from a point to the nearest segment of a polyline
+	* Every segment is searched, a curve can come back near a part of the polyline it already passed, so the error reported is never less than the real one
+	*/
+	float GetDistanceToPolyline(const FVector& Point, const TArray<FVector>& Polyline)
+	{
+		float DistanceSquared = MAX_flt;
+		for (int32 SegmentIndex = 0; SegmentIndex + 1 < Polyline.Num(); ++SegmentIndex)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, FMath::PointDistToSegmentSquared(Point, Polyline[SegmentIndex], Polyline[SegmentIndex + 1]));
+		}
+		return FMath::Sqrt(DistanceSquared);
+	}
+
+	/** Default screen sizes of the spline mesh LODs */
+	const float DefaultLODScreenSizes[] = { 0.25f, 0.1f };
+
+	/** Consecutive spline meshes meeting at a larger angle than this, about 10 degrees, are never merged so sharp corners keep their shape */
+	const float LODSharpCornerAngle = PI / 18.0f;
+
+	/** Total bend of a merged spline mesh, a single hermite segment can't follow a longer curve */
+	const float LODMaxMergedTurnAngle = PI / 3.0f;
+
+	/** Spline meshes whose ends are further apart than this aren't consecutive */
+	const float LODJoinTolerance = 0.1f;
+
+	/** Ends of a spline mesh in world space */
+	struct FSplineMeshEnds
+	{
+		FVector StartLocation;
+		FVector StartTangent;
+		FVector EndLocation;
+		FVector EndTangent;
+		float ChordLength;
+
+		/** Angle between the start and end tangents */
+		float TurnAngle;
+	};
+
+	float GetAngleBetween(const FVector& A, const FVector& B)
+	{
+		return FMath::Acos(FMath::Clamp(FVector::DotProduct(A.GetSafeNormal(), B.GetSafeNormal()), -1.0f, 1.0f));
+	}
+
+	/** Triangles drawn by a spline mesh, every spline mesh draws its whole static mesh however long it is */
+	int32 GetNumTriangles(const USplineMeshComponent* SplineMeshComponent)
+	{
+		const UStaticMesh* StaticMesh = SplineMeshComponent->GetStaticMesh();
+		if (StaticMesh == nullptr || !StaticMesh->RenderData.IsValid() || StaticMesh->RenderData->LODResources.Num() == 0)
+		{
+			return 0;
+		}
+		return StaticMesh->RenderData->LODResources[0].GetNumTriangles();
+	}
+
+	/** Largest distance between two polylines following the same path, in both directions */
+	float GetPolylineDeviation(const TArray<FVector>& PolylineA, const TArray<FVector>& PolylineB)
+	{
+		float MaxDistance = 0.0f;
+		for (const FVector& Point : PolylineA)
+		{
+			MaxDistance = FMath::Max(MaxDistance, GetDistanceToPolyline(Point, PolylineB));
+		}
+		for (const FVector& Point : PolylineB)
+		{
+			MaxDistance = FMath::Max(MaxDistance, GetDistanceToPolyline(Point, PolylineA));
+		}
+
+		return MaxDistance;
+	}
+}
 
 ASplineActor::ASplineActor(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bUpdateSplineMeshes(true)
+#if WITH_EDITORONLY_DATA
+	, bPreviewingSplineMeshes(false)
+#endif
 {
 	SetFlags(RF_Transactional);
 
@@ -23,6 +131,8 @@ ASplineActor::ASplineActor(const FObjectInitializer& ObjectInitializer)
 	SplineComponent->SetClosedLoop(true);
 	SplineComponent->bSplineHasBeenEdited = true;
 
+	LODScreenSizes.Append(SplineActorDefs::DefaultLODScreenSizes, UE_ARRAY_COUNT(SplineActorDefs::DefaultLODScreenSizes));
+
 	SceneComponent->SetMobility(EComponentMobility::Movable);
 	SplineComponent->SetMobility(EComponentMobility::Movable);
 
@@ -32,15 +142,44 @@ ASplineActor::ASplineActor(const FObjectInitializer& ObjectInitializer)
 // Sets default values
 ASplineActor::ASplineActor()
 	: bUpdateSplineMeshes(true)
+#if WITH_EDITORONLY_DATA
+	, bPreviewingSplineMeshes(false)
+#endif
 {
 	// turned this off to improve performance
 	PrimaryActorTick.bCanEverTick = false;
+
+	LODScreenSizes.Append(SplineActorDefs::DefaultLODScreenSizes, UE_ARRAY_COUNT(SplineActorDefs::DefaultLODScreenSizes));
 }
 
 // Called when the game starts or when spawned
 void ASplineActor::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Unless construction built them already, for spline meshes added after it
+	if (!LODSplineMeshComponents.ContainsByPredicate([](const USplineMeshComponent* LODMesh) { return LODMesh != nullptr && !LODMesh->IsPendingKill(); }))
+	{
+		BuildSplineMeshLODs();
+	}
+}
+
+void ASplineActor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	if (SplineMeshComponents.Num() == 0)
+	{
+		return;
+	}
+
+	BuildSplineMeshLODs();
+
+	// Made from the spline meshes of the construction script, so thrown away and remade with them when it is re-run
+	for (USplineMeshComponent* LODMesh : LODSplineMeshComponents)
+	{
+		LODMesh->CreationMethod = EComponentCreationMethod::UserConstructionScript;
+	}
 }
 
 void ASplineActor::PreInitializeComponents()
@@ -104,6 +243,8 @@ USplineMeshComponent* ASplineActor::AddPinballSplineMeshComponent(bool bManualAt
 
 void ASplineActor::DestroyAllSplineMeshes()
 {
+	DestroySplineMeshLODs();
+
 	for (int32 SplineMeshIndex = SplineMeshComponents.Num() - 1; SplineMeshIndex >= 0; --SplineMeshIndex)
 	{
 		USplineMeshComponent* SplineMeshComponent = SplineMeshComponents[SplineMeshIndex];
@@ -117,9 +258,627 @@ void ASplineActor::DestroyAllSplineMeshes()
 	SplineMeshComponents.Empty();
 }
 
+void ASplineActor::BuildSplineMeshLODs()
+{
+	using namespace SplineActorDefs;
+
+	DestroySplineMeshLODs();
+
+	// Only the spline meshes that draw something take part
+	TArray<USplineMeshComponent*> SourceMeshes;
+	int32 NumSourceTriangles = 0;
+	for (USplineMeshComponent* SplineMeshComponent : SplineMeshComponents)
+	{
+		if (SplineMeshComponent != nullptr && SplineMeshComponent->GetStaticMesh() != nullptr)
+		{
+			SourceMeshes.Add(SplineMeshComponent);
+			NumSourceTriangles += GetNumTriangles(SplineMeshComponent);
+		}
+	}
+
+	LODTriangleCounts.Add(NumSourceTriangles);
+	LODSplineMeshCounts.Add(SourceMeshes.Num());
+
+	// Screen sizes have to go down from one LOD to the next, or a LOD would never be drawn
+	TArray<float> ScreenSizes;
+	for (float ScreenSize : LODScreenSizes)
+	{
+		if (ScreenSize > 0.0f && (ScreenSizes.Num() == 0 || ScreenSize < ScreenSizes.Last()))
+		{
+			ScreenSizes.Add(ScreenSize);
+		}
+	}
+
+	if (SourceMeshes.Num() == 0 || ScreenSizes.Num() == 0)
+	{
+		return;
+	}
+
+	// The whole actor switches LOD at once, at a 90 degree field of view the screen size is the bounds radius over the distance
+	FBox ActorMeshBounds(ForceInit);
+	for (const USplineMeshComponent* SourceMesh : SourceMeshes)
+	{
+		ActorMeshBounds += SourceMesh->Bounds.GetBox();
+	}
+	const float BoundsRadius = FBoxSphereBounds(ActorMeshBounds).SphereRadius;
+
+	TArray<float> LODDistances;
+	for (float ScreenSize : ScreenSizes)
+	{
+		LODDistances.Add(BoundsRadius / ScreenSize);
+	}
+
+	TArray<FSplineMeshEnds> MeshEnds;
+	MeshEnds.SetNum(SourceMeshes.Num());
+	for (int32 SourceMeshIndex = 0; SourceMeshIndex < SourceMeshes.Num(); ++SourceMeshIndex)
+	{
+		USplineMeshComponent* SourceMesh = SourceMeshes[SourceMeshIndex];
+		const FTransform& MeshTransform = SourceMesh->GetComponentTransform();
+		FSplineMeshEnds& Ends = MeshEnds[SourceMeshIndex];
+		Ends.StartLocation = MeshTransform.TransformPosition(SourceMesh->GetStartPosition());
+		Ends.StartTangent = MeshTransform.TransformVector(SourceMesh->GetStartTangent());
+		Ends.EndLocation = MeshTransform.TransformPosition(SourceMesh->GetEndPosition());
+		Ends.EndTangent = MeshTransform.TransformVector(SourceMesh->GetEndTangent());
+		Ends.ChordLength = FVector::Dist(Ends.StartLocation, Ends.EndLocation);
+		Ends.TurnAngle = GetAngleBetween(Ends.StartTangent, Ends.EndTangent);
+
+		// The full detail meshes are only drawn up to the first LOD
+		SourceMesh->SetCullDistance(LODDistances[0]);
+	}
+
+	// Whether each mesh carries on smoothly into the next one
+	TBitArray<> CanMergeWithNext(false, SourceMeshes.Num());
+	for (int32 SourceMeshIndex = 0; SourceMeshIndex + 1 < SourceMeshes.Num(); ++SourceMeshIndex)
+	{
+		const FSplineMeshEnds& Ends = MeshEnds[SourceMeshIndex];
+		const FSplineMeshEnds& NextEnds = MeshEnds[SourceMeshIndex + 1];
+		CanMergeWithNext[SourceMeshIndex] = SourceMeshes[SourceMeshIndex]->GetStaticMesh() == SourceMeshes[SourceMeshIndex + 1]->GetStaticMesh()
+			&& FVector::Dist(Ends.EndLocation, NextEnds.StartLocation) <= LODJoinTolerance
+			&& GetAngleBetween(Ends.EndTangent, NextEnds.StartTangent) <= LODSharpCornerAngle;
+	}
+
+	for (int32 LODIndex = 1; LODIndex <= LODDistances.Num(); ++LODIndex)
+	{
+		const int32 MaxMergedMeshes = 1 << FMath::Min(LODIndex, 30);
+		const float MinDrawDistance = LODDistances[LODIndex - 1];
+		const float MaxDrawDistance = (LODIndex < LODDistances.Num()) ? LODDistances[LODIndex] : 0.0f;
+		int32 NumLODTriangles = 0;
+		int32 NumLODMeshes = 0;
+
+		for (int32 FirstMesh = 0; FirstMesh < SourceMeshes.Num();)
+		{
+			// Resample the spline at fewer points by merging the following meshes, as long as they don't bend too far
+			int32 LastMesh = FirstMesh;
+			float TurnAngle = MeshEnds[FirstMesh].TurnAngle;
+			float ChordLength = MeshEnds[FirstMesh].ChordLength;
+			while (LastMesh + 1 < SourceMeshes.Num() && LastMesh + 1 - FirstMesh < MaxMergedMeshes && CanMergeWithNext[LastMesh])
+			{
+				const float NextTurnAngle = TurnAngle + GetAngleBetween(MeshEnds[LastMesh].EndTangent, MeshEnds[LastMesh + 1].StartTangent) + MeshEnds[LastMesh + 1].TurnAngle;
+				if (NextTurnAngle > LODMaxMergedTurnAngle)
+				{
+					break;
+				}
+
+				TurnAngle = NextTurnAngle;
+				ChordLength += MeshEnds[LastMesh + 1].ChordLength;
+				++LastMesh;
+			}
+
+			const USplineMeshComponent* FirstSourceMesh = SourceMeshes[FirstMesh];
+			const USplineMeshComponent* LastSourceMesh = SourceMeshes[LastMesh];
+			const FSplineMeshEnds& FirstEnds = MeshEnds[FirstMesh];
+			const FSplineMeshEnds& LastEnds = MeshEnds[LastMesh];
+
+			// Made by the construction script, they go with its other components when it runs again instead of piling up
+			USplineMeshComponent* LODMesh = NewObject<USplineMeshComponent>(this);
+			LODMesh->CreationMethod = IsRunningUserConstructionScript() ? EComponentCreationMethod::UserConstructionScript : EComponentCreationMethod::Instance;
+			LODMesh->OnComponentCreated();
+			LODMesh->SetupAttachment(FirstSourceMesh->GetAttachParent() != nullptr ? FirstSourceMesh->GetAttachParent() : RootComponent);
+			LODMesh->SetRelativeTransform(FirstSourceMesh->GetRelativeTransform());
+			LODMesh->SetMobility(FirstSourceMesh->Mobility);
+			LODMesh->SetStaticMesh(FirstSourceMesh->GetStaticMesh());
+			LODMesh->OverrideMaterials = FirstSourceMesh->OverrideMaterials;
+			LODMesh->CastShadow = FirstSourceMesh->CastShadow;
+			LODMesh->SetForwardAxis(FirstSourceMesh->ForwardAxis, false);
+			LODMesh->SplineUpDir = FirstSourceMesh->SplineUpDir;
+			LODMesh->bSmoothInterpRollScale = FirstSourceMesh->bSmoothInterpRollScale;
+
+			// The coarser LODs only draw, the ball collides with the full detail meshes
+			LODMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			LODMesh->SetGenerateOverlapEvents(false);
+			LODMesh->MinDrawDistance = MinDrawDistance;
+			LODMesh->LDMaxDrawDistance = MaxDrawDistance;
+			LODMesh->CachedMaxDrawDistance = MaxDrawDistance;
+
+			// Scale, roll and offset come from the ends of the first and last merged meshes
+			LODMesh->SplineParams = FirstSourceMesh->SplineParams;
+			LODMesh->SplineParams.EndScale = LastSourceMesh->SplineParams.EndScale;
+			LODMesh->SplineParams.EndRoll = LastSourceMesh->SplineParams.EndRoll;
+			LODMesh->SplineParams.EndOffset = LastSourceMesh->SplineParams.EndOffset;
+
+			// Tangents are over the length of the segment they belong to, so they grow with the merged segment
+			const FTransform& MeshTransform = FirstSourceMesh->GetComponentTransform();
+			const FVector StartTangent = MeshTransform.InverseTransformVector(FirstEnds.StartTangent) * (ChordLength / FMath::Max(FirstEnds.ChordLength, KINDA_SMALL_NUMBER));
+			const FVector EndTangent = MeshTransform.InverseTransformVector(LastEnds.EndTangent) * (ChordLength / FMath::Max(LastEnds.ChordLength, KINDA_SMALL_NUMBER));
+			LODMesh->SetStartAndEnd(FirstSourceMesh->GetStartPosition(), StartTangent, MeshTransform.InverseTransformPosition(LastEnds.EndLocation), EndTangent, false);
+
+			LODMesh->RegisterComponent();
+			LODSplineMeshComponents.Add(LODMesh);
+
+			NumLODTriangles += GetNumTriangles(LODMesh);
+			++NumLODMeshes;
+			FirstMesh = LastMesh + 1;
+		}
+
+		LODTriangleCounts.Add(NumLODTriangles);
+		LODSplineMeshCounts.Add(NumLODMeshes);
+	}
+}
+
+void ASplineActor::DestroySplineMeshLODs()
+{
+	for (int32 LODMeshIndex = LODSplineMeshComponents.Num() - 1; LODMeshIndex >= 0; --LODMeshIndex)
+	{
+		USplineMeshComponent* LODMesh = LODSplineMeshComponents[LODMeshIndex];
+		LODSplineMeshComponents[LODMeshIndex] = nullptr;
+		if (LODMesh != nullptr)
+		{
+			LODMesh->DestroyComponent();
+		}
+	}
+
+	LODSplineMeshComponents.Empty();
+	LODTriangleCounts.Reset();
+	LODSplineMeshCounts.Reset();
+
+	// Without LODs the full detail meshes are drawn at any distance
+	for (USplineMeshComponent* SplineMeshComponent : SplineMeshComponents)
+	{
+		if (SplineMeshComponent != nullptr && SplineMeshComponent->LDMaxDrawDistance > 0.0f)
+		{
+			SplineMeshComponent->SetCullDistance(0.0f);
+		}
+	}
+}
+
+void ASplineActor::GetSplinePoints(TArray<FVector>* OutLocations, TArray<FVector>* OutArriveTangents, TArray<FVector>* OutLeaveTangents, TArray<ESplinePointType::Type>* OutTypes, TArray<FVector>* OutScales, TArray<FQuat>* OutRotations) const
+{
+	const FSplineCurves& SplineCurves = SplineComponent->SplineCurves;
+	const int32 NumSplinePoints = SplineCurves.Position.Points.Num();
+
+	if (OutLocations)		{ OutLocations->Reset(NumSplinePoints); }
+	if (OutArriveTangents)	{ OutArriveTangents->Reset(NumSplinePoints); }
+	if (OutLeaveTangents)	{ OutLeaveTangents->Reset(NumSplinePoints); }
+	if (OutTypes)			{ OutTypes->Reset(NumSplinePoints); }
+	if (OutScales)			{ OutScales->Reset(NumSplinePoints); }
+	if (OutRotations)		{ OutRotations->Reset(NumSplinePoints); }
+
+	for (int32 SplinePointIndex = 0; SplinePointIndex < NumSplinePoints; ++SplinePointIndex)
+	{
+		const FInterpCurvePoint<FVector>& PositionPoint = SplineCurves.Position.Points[SplinePointIndex];
+
+		if (OutLocations)		{ OutLocations->Add(PositionPoint.OutVal); }
+		if (OutArriveTangents)	{ OutArriveTangents->Add(PositionPoint.ArriveTangent); }
+		if (OutLeaveTangents)	{ OutLeaveTangents->Add(PositionPoint.LeaveTangent); }
+		if (OutTypes)			{ OutTypes->Add(SplineComponent->GetSplinePointType(SplinePointIndex)); }
+		if (OutScales)			{ OutScales->Add(SplineCurves.Scale.Points.IsValidIndex(SplinePointIndex) ? SplineCurves.Scale.Points[SplinePointIndex].OutVal : FVector(1.0f)); }
+		if (OutRotations)		{ OutRotations->Add(SplineCurves.Rotation.Points.IsValidIndex(SplinePointIndex) ? SplineCurves.Rotation.Points[SplinePointIndex].OutVal : FQuat::Identity); }
+	}
+}
+
+void ASplineActor::SetSplinePoints(const TArray<FVector>& Locations, const TArray<FVector>& Tangents, const TArray<ESplinePointType::Type>& Types, const TArray<FVector>& Scales, const TArray<FQuat>& Rotations)
+{
+	SetSplinePoints(Locations, Tangents, Tangents, Types, Scales, Rotations);
+}
+
+void ASplineActor::SetSplinePoints(const TArray<FVector>& Locations, const TArray<FVector>& ArriveTangents, const TArray<FVector>& LeaveTangents, const TArray<ESplinePointType::Type>& Types, const TArray<FVector>& Scales,
+	const TArray<FQuat>& Rotations)
+{
+	check(ArriveTangents.Num() == Locations.Num() && LeaveTangents.Num() == Locations.Num() && Types.Num() == Locations.Num());
+	check(Scales.Num() == 0 || Scales.Num() == Locations.Num());
+	check(Rotations.Num() == 0 || Rotations.Num() == Locations.Num());
+
+	// Without rotations given, the authored ones are kept for the indices that still exist
+	TArray<FQuat> CurrentRotations;
+	if (Rotations.Num() == 0)
+	{
+		GetSplinePoints(nullptr, nullptr, nullptr, nullptr, nullptr, &CurrentRotations);
+	}
+
+	FSplineCurves& SplineCurves = SplineComponent->SplineCurves;
+	SplineCurves.Position.Points.Reset(Locations.Num());
+	SplineCurves.Rotation.Points.Reset(Locations.Num());
+	SplineCurves.Scale.Points.Reset(Locations.Num());
+
+	// Fill the curves directly, the same way AddSplinePoint would but without updating the spline for every point
+	for (int32 SplinePointIndex = 0; SplinePointIndex < Locations.Num(); ++SplinePointIndex)
+	{
+		const float InputKey = SplinePointIndex;
+		const FVector Scale = (Scales.Num() > 0) ? Scales[SplinePointIndex] : FVector(1.0f);
+		const FQuat Rotation = (Rotations.Num() > 0) ? Rotations[SplinePointIndex] : (CurrentRotations.IsValidIndex(SplinePointIndex) ? CurrentRotations[SplinePointIndex] : FQuat::Identity);
+
+		SplineCurves.Position.Points.Emplace(InputKey, Locations[SplinePointIndex], ArriveTangents[SplinePointIndex], LeaveTangents[SplinePointIndex], SplineActorDefs::ConvertSplinePointTypeToInterpCurveMode(Types[SplinePointIndex]));
+		SplineCurves.Rotation.Points.Emplace(InputKey, Rotation, FQuat::Identity, FQuat::Identity, CIM_CurveAuto);
+		SplineCurves.Scale.Points.Emplace(InputKey, Scale, FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+	}
+
+	SplineComponent->bSplineHasBeenEdited = true;
+	SplineComponent->UpdateSpline();
+}
+
+void ASplineActor::InsertSplinePoints(int32 InsertIndex, const TArray<FVector>& Locations, const TArray<FVector>& Tangents, const TArray<ESplinePointType::Type>& Types)
+{
+	check(Tangents.Num() == Locations.Num() && Types.Num() == Locations.Num());
+
+	FSplineCurves& SplineCurves = SplineComponent->SplineCurves;
+	InsertIndex = FMath::Clamp(InsertIndex, 0, SplineCurves.Position.Points.Num());
+
+	TArray<FInterpCurvePoint<FVector>> NewPositionPoints;
+	TArray<FInterpCurvePoint<FQuat>> NewRotationPoints;
+	TArray<FInterpCurvePoint<FVector>> NewScalePoints;
+	NewPositionPoints.Reserve(Locations.Num());
+	NewRotationPoints.Reserve(Locations.Num());
+	NewScalePoints.Reserve(Locations.Num());
+
+	for (int32 NewPointIndex = 0; NewPointIndex < Locations.Num(); ++NewPointIndex)
+	{
+		const float InputKey = InsertIndex + NewPointIndex;
+		NewPositionPoints.Emplace(InputKey, Locations[NewPointIndex], Tangents[NewPointIndex], Tangents[NewPointIndex], SplineActorDefs::ConvertSplinePointTypeToInterpCurveMode(Types[NewPointIndex]));
+		NewRotationPoints.Emplace(InputKey, FQuat::Identity, FQuat::Identity, FQuat::Identity, CIM_CurveAuto);
+		NewScalePoints.Emplace(InputKey, FVector(1.0f), FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+	}
+
+	// One insertion per curve, then fix up the keys of everything after the new points
+	SplineCurves.Position.Points.Insert(NewPositionPoints, InsertIndex);
+	SplineCurves.Rotation.Points.Insert(NewRotationPoints, InsertIndex);
+	SplineCurves.Scale.Points.Insert(NewScalePoints, InsertIndex);
+	SplineActorDefs::RenumberSplineInputKeys(SplineCurves);
+
+	SplineComponent->bSplineHasBeenEdited = true;
+	SplineComponent->UpdateSpline();
+}
+
+void ASplineActor::RemoveSplinePoints(const TArray<int32>& SplinePointIndices)
+{
+	FSplineCurves& SplineCurves = SplineComponent->SplineCurves;
+	const int32 NumSplinePoints = SplineCurves.Position.Points.Num();
+
+	TBitArray<> RemovePoint(false, NumSplinePoints);
+	for (int32 SplinePointIndex : SplinePointIndices)
+	{
+		if (SplinePointIndex >= 0 && SplinePointIndex < NumSplinePoints)
+		{
+			RemovePoint[SplinePointIndex] = true;
+		}
+	}
+
+	// Compact all three curves in a single pass
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < NumSplinePoints; ++ReadIndex)
+	{
+		if (!RemovePoint[ReadIndex])
+		{
+			if (WriteIndex != ReadIndex)
+			{
+				SplineCurves.Position.Points[WriteIndex] = SplineCurves.Position.Points[ReadIndex];
+				SplineCurves.Rotation.Points[WriteIndex] = SplineCurves.Rotation.Points[ReadIndex];
+				SplineCurves.Scale.Points[WriteIndex] = SplineCurves.Scale.Points[ReadIndex];
+			}
+			++WriteIndex;
+		}
+	}
+
+	SplineCurves.Position.Points.SetNum(WriteIndex);
+	SplineCurves.Rotation.Points.SetNum(WriteIndex);
+	SplineCurves.Scale.Points.SetNum(WriteIndex);
+	SplineActorDefs::RenumberSplineInputKeys(SplineCurves);
+
+	SplineComponent->bSplineHasBeenEdited = true;
+	SplineComponent->UpdateSpline();
+}
+
+void ASplineActor::ResetSplinePointsToDefault()
+{
+	const ASplineActor* DefaultSplineActor = Cast<ASplineActor>(GetArchetype());
+	if (DefaultSplineActor == nullptr || DefaultSplineActor->SplineComponent == nullptr || SplineComponent == nullptr)
+	{
+		return;
+	}
+
+	TArray<FVector> Locations;
+	TArray<FVector> ArriveTangents;
+	TArray<FVector> LeaveTangents;
+	TArray<ESplinePointType::Type> Types;
+	TArray<FVector> Scales;
+	TArray<FQuat> Rotations;
+	DefaultSplineActor->GetSplinePoints(&Locations, &ArriveTangents, &LeaveTangents, &Types, &Scales, &Rotations);
+
+	SetSplinePoints(Locations, ArriveTangents, LeaveTangents, Types, Scales, Rotations);
+}
+
+FSplineSimplifyResult ASplineActor::SimplifySplinePoints(float Tolerance)
+{
+	FSplineSimplifyResult Result;
+
+	const FInterpCurveVector& PositionCurve = SplineComponent->SplineCurves.Position;
+	const int32 NumSplinePoints = PositionCurve.Points.Num();
+	const bool bClosedLoop = SplineComponent->IsClosedLoop();
+	const int32 NumSegments = bClosedLoop ? NumSplinePoints : NumSplinePoints - 1;
+	const int32 MinNumSplinePoints = bClosedLoop ? 3 : 2;
+
+	Result.NumPointsBefore = Result.NumPointsAfter = NumSplinePoints;
+	if (NumSplinePoints <= MinNumSplinePoints || Tolerance <= 0.0f)
+	{
+		return Result;
+	}
+
+	TArray<FVector> Locations;
+	TArray<FVector> ArriveTangents;
+	TArray<FVector> LeaveTangents;
+	TArray<FVector> Scales;
+	TArray<FQuat> Rotations;
+	GetSplinePoints(&Locations, &ArriveTangents, &LeaveTangents, nullptr, &Scales, &Rotations);
+
+	// Sample the current spline once, every candidate segment is measured against these
+	const int32 SamplesPerSegment = SplineActorDefs::SimplifySamplesPerSegment;
+	TArray<FVector> Samples;
+	Samples.SetNumUninitialized(NumSegments * SamplesPerSegment + 1);
+	for (int32 SampleIndex = 0; SampleIndex < Samples.Num(); ++SampleIndex)
+	{
+		Samples[SampleIndex] = PositionCurve.Eval((float)SampleIndex / SamplesPerSegment);
+	}
+
+	// Hermite segment from StartIndex to EndIndex, keeping the original tangent directions scaled by the number of segments spanned
+	TArray<FVector> SegmentSamples;
+	TArray<FVector> OriginalSamples;
+	auto GetSegmentError = [&](int32 StartIndex, int32 EndIndex)
+	{
+		const int32 Span = EndIndex - StartIndex;
+		const int32 EndPointIndex = EndIndex % NumSplinePoints;
+		const FVector StartTangent = LeaveTangents[StartIndex] * Span;
+		const FVector EndTangent = ArriveTangents[EndPointIndex] * Span;
+
+		const int32 NumSegmentSamples = Span * SamplesPerSegment;
+		SegmentSamples.SetNumUninitialized(NumSegmentSamples + 1);
+		for (int32 SampleIndex = 0; SampleIndex <= NumSegmentSamples; ++SampleIndex)
+		{
+			SegmentSamples[SampleIndex] = FMath::CubicInterp(Locations[StartIndex], StartTangent, Locations[EndPointIndex], EndTangent, (float)SampleIndex / NumSegmentSamples);
+		}
+
+		OriginalSamples.Reset(NumSegmentSamples + 1);
+		OriginalSamples.Append(&Samples[StartIndex * SamplesPerSegment], NumSegmentSamples + 1);
+
+		return SplineActorDefs::GetPolylineDeviation(OriginalSamples, SegmentSamples);
+	};
+
+	// Greedily extend every segment over as many of the following points as the tolerance allows
+	TArray<int32> KeptPointIndices;
+	TArray<int32> KeptPointSpans;
+	KeptPointIndices.Add(0);
+	int32 StartIndex = 0;
+	while (StartIndex < NumSegments)
+	{
+		int32 EndIndex = StartIndex + 1;
+		float SegmentError = 0.0f;
+		for (int32 CandidateEndIndex = StartIndex + 2; CandidateEndIndex <= NumSegments; ++CandidateEndIndex)
+		{
+			const float CandidateError = GetSegmentError(StartIndex, CandidateEndIndex);
+			if (CandidateError > Tolerance)
+			{
+				break;
+			}
+			EndIndex = CandidateEndIndex;
+			SegmentError = CandidateError;
+		}
+
+		Result.MaxError = FMath::Max(Result.MaxError, SegmentError);
+		KeptPointSpans.Add(EndIndex - StartIndex);
+		if (EndIndex < NumSplinePoints)
+		{
+			KeptPointIndices.Add(EndIndex);
+		}
+		StartIndex = EndIndex;
+	}
+
+	if (KeptPointIndices.Num() < MinNumSplinePoints || KeptPointIndices.Num() == NumSplinePoints)
+	{
+		// Nothing to remove, leave the spline untouched
+		Result.MaxError = 0.0f;
+		return Result;
+	}
+
+	// KeptPointSpans[i] is the number of original segments between kept point i and the next one
+	const int32 NumKeptPoints = KeptPointIndices.Num();
+	TArray<FVector> NewLocations;
+	TArray<FVector> NewArriveTangents;
+	TArray<FVector> NewLeaveTangents;
+	TArray<FVector> NewScales;
+	TArray<FQuat> NewRotations;
+	NewLocations.Reserve(NumKeptPoints);
+	NewArriveTangents.Reserve(NumKeptPoints);
+	NewLeaveTangents.Reserve(NumKeptPoints);
+	NewScales.Reserve(NumKeptPoints);
+	NewRotations.Reserve(NumKeptPoints);
+	for (int32 KeptIndex = 0; KeptIndex < NumKeptPoints; ++KeptIndex)
+	{
+		const int32 PointIndex = KeptPointIndices[KeptIndex];
+		const int32 ArriveSpan = (KeptIndex > 0) ? KeptPointSpans[KeptIndex - 1] : (bClosedLoop ? KeptPointSpans.Last() : KeptPointSpans[0]);
+		const int32 LeaveSpan = KeptPointSpans.IsValidIndex(KeptIndex) ? KeptPointSpans[KeptIndex] : KeptPointSpans.Last();
+
+		NewLocations.Add(Locations[PointIndex]);
+		NewArriveTangents.Add(ArriveTangents[PointIndex] * ArriveSpan);
+		NewLeaveTangents.Add(LeaveTangents[PointIndex] * LeaveSpan);
+		NewScales.Add(Scales[PointIndex]);
+		NewRotations.Add(Rotations[PointIndex]);
+	}
+
+	TArray<ESplinePointType::Type> NewTypes;
+	NewTypes.Init(ESplinePointType::CurveCustomTangent, NumKeptPoints);
+	SetSplinePoints(NewLocations, NewArriveTangents, NewLeaveTangents, NewTypes, NewScales, NewRotations);
+
+	Result.NumPointsAfter = NumKeptPoints;
+	return Result;
+}
+
+void ASplineActor::SetSplinePointsFromOffset(const USplineComponent* SourceSpline, float Distance)
+{
+	if (SourceSpline == nullptr)
+	{
+		return;
+	}
+
+	FSplineCurvePoints OffsetPoints;
+	FSplineGeometry::OffsetSpline(SourceSpline->SplineCurves.Position, SourceSpline->IsClosedLoop(), Distance, OffsetPoints);
+
+	TArray<ESplinePointType::Type> Types;
+	Types.Init(ESplinePointType::CurveCustomTangent, OffsetPoints.Num());
+
+	SplineComponent->SetClosedLoop(OffsetPoints.bClosedLoop, false);
+	SetSplinePoints(OffsetPoints.Locations, OffsetPoints.ArriveTangents, OffsetPoints.LeaveTangents, Types, TArray<FVector>());
+}
+
+FVector2D ASplineActor::FindSplineMeshInputKeys(const USplineMeshComponent* SplineMeshComponent) const
+{
+	const FTransform& MeshTransform = SplineMeshComponent->GetComponentTransform();
+	const FVector StartLocation = MeshTransform.TransformPosition(SplineMeshComponent->GetStartPosition());
+	const FVector EndLocation = MeshTransform.TransformPosition(SplineMeshComponent->GetEndPosition());
+
+	FVector2D InputKeys(SplineComponent->FindInputKeyClosestToWorldLocation(StartLocation), SplineComponent->FindInputKeyClosestToWorldLocation(EndLocation));
+
+	// The last segment of a closed loop ends at the first point, which is found as key 0 rather than at the loop key
+	if (SplineComponent->IsClosedLoop() && InputKeys.Y <= InputKeys.X)
+	{
+		InputKeys.Y += SplineComponent->GetNumberOfSplinePoints();
+	}
+
+	return InputKeys;
+}
+
 #if WITH_EDITOR
 void ASplineActor::PreEditUndo()
 {
+	EndSplineMeshPreview();
 	DestroyAllSplineMeshes();
 }
+
+void ASplineActor::BeginSplineMeshPreview()
+{
+	if (SplineComponent == nullptr)
+	{
+		return;
+	}
+
+	// Remember which part of the spline each mesh covers, the spline is about to change so this can't be found later
+	PreviewSplineMeshInputKeys.SetNum(SplineMeshComponents.Num());
+	for (int32 SplineMeshIndex = 0; SplineMeshIndex < SplineMeshComponents.Num(); ++SplineMeshIndex)
+	{
+		const USplineMeshComponent* SplineMeshComponent = SplineMeshComponents[SplineMeshIndex];
+		PreviewSplineMeshInputKeys[SplineMeshIndex] = (SplineMeshComponent != nullptr) ? FindSplineMeshInputKeys(SplineMeshComponent) : FVector2D(-1.0f, -1.0f);
+	}
+
+	PreviewSavedCollision.Init(ECollisionEnabled::NoCollision, SplineMeshComponents.Num());
+	PreviewTouchedSplineMeshes.Init(false, SplineMeshComponents.Num());
+	bPreviewingSplineMeshes = true;
+}
+
+void ASplineActor::UpdateSplineMeshPreview(const TArray<int32>& MovedSplinePointIndices)
+{
+	if (!bPreviewingSplineMeshes || SplineComponent == nullptr || PreviewSplineMeshInputKeys.Num() != SplineMeshComponents.Num())
+	{
+		return;
+	}
+
+	const int32 NumSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+	if (NumSplinePoints < 2)
+	{
+		return;
+	}
+
+	const bool bClosedLoop = SplineComponent->IsClosedLoop();
+
+	// Moving a point changes the auto tangents of its neighbours too, so the two segments on either side of it are affected
+	TBitArray<> DirtySegments(false, NumSplinePoints);
+	for (int32 MovedSplinePointIndex : MovedSplinePointIndices)
+	{
+		for (int32 SegmentIndex = MovedSplinePointIndex - 2; SegmentIndex <= MovedSplinePointIndex + 1; ++SegmentIndex)
+		{
+			if (bClosedLoop)
+			{
+				DirtySegments[(SegmentIndex + NumSplinePoints) % NumSplinePoints] = true;
+			}
+			else if (SegmentIndex >= 0 && SegmentIndex < NumSplinePoints)
+			{
+				DirtySegments[SegmentIndex] = true;
+			}
+		}
+	}
+
+	for (int32 SplineMeshIndex = 0; SplineMeshIndex < SplineMeshComponents.Num(); ++SplineMeshIndex)
+	{
+		USplineMeshComponent* SplineMeshComponent = SplineMeshComponents[SplineMeshIndex];
+		const FVector2D& InputKeys = PreviewSplineMeshInputKeys[SplineMeshIndex];
+		if (SplineMeshComponent == nullptr || InputKeys.X < 0.0f)
+		{
+			continue;
+		}
+
+		// Is any segment covered by this mesh affected?
+		bool bIsDirty = false;
+		const int32 FirstSegment = FMath::FloorToInt(InputKeys.X);
+		const int32 LastSegment = FMath::Max(FirstSegment, FMath::CeilToInt(InputKeys.Y) - 1);
+		for (int32 SegmentIndex = FirstSegment; SegmentIndex <= LastSegment && !bIsDirty; ++SegmentIndex)
+		{
+			bIsDirty = DirtySegments[FMath::Clamp(SegmentIndex % NumSplinePoints, 0, NumSplinePoints - 1)];
+		}
+
+		if (!bIsDirty)
+		{
+			continue;
+		}
+
+		// Collision would be stale while previewing, so turn it off until the construction script rebuilds the mesh
+		if (!PreviewTouchedSplineMeshes[SplineMeshIndex])
+		{
+			PreviewTouchedSplineMeshes[SplineMeshIndex] = true;
+			PreviewSavedCollision[SplineMeshIndex] = SplineMeshComponent->GetCollisionEnabled();
+			SplineMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		}
+
+		// Tangents on the spline are per unit of input key, the spline mesh wants them over the whole range it covers
+		const float InputKeySpan = InputKeys.Y - InputKeys.X;
+		const FTransform& MeshTransform = SplineMeshComponent->GetComponentTransform();
+		const FVector StartLocation = MeshTransform.InverseTransformPosition(SplineComponent->GetLocationAtSplineInputKey(InputKeys.X, ESplineCoordinateSpace::World));
+		const FVector EndLocation = MeshTransform.InverseTransformPosition(SplineComponent->GetLocationAtSplineInputKey(InputKeys.Y, ESplineCoordinateSpace::World));
+		const FVector StartTangent = MeshTransform.InverseTransformVector(SplineComponent->GetTangentAtSplineInputKey(InputKeys.X, ESplineCoordinateSpace::World) * InputKeySpan);
+		const FVector EndTangent = MeshTransform.InverseTransformVector(SplineComponent->GetTangentAtSplineInputKey(InputKeys.Y, ESplineCoordinateSpace::World) * InputKeySpan);
+
+		// Only update rendering, rebuilding the collision is what makes the full update slow
+		SplineMeshComponent->SetStartAndEnd(StartLocation, StartTangent, EndLocation, EndTangent, false);
+		SplineMeshComponent->UpdateBounds();
+		SplineMeshComponent->MarkRenderStateDirty();
+	}
+}
+
+void ASplineActor::EndSplineMeshPreview()
+{
+	if (!bPreviewingSplineMeshes)
+	{
+		return;
+	}
+
+	bPreviewingSplineMeshes = false;
+
+	for (int32 SplineMeshIndex = 0; SplineMeshIndex < SplineMeshComponents.Num() && SplineMeshIndex < PreviewTouchedSplineMeshes.Num(); ++SplineMeshIndex)
+	{
+		USplineMeshComponent* SplineMeshComponent = SplineMeshComponents[SplineMeshIndex];
+		if (SplineMeshComponent != nullptr && PreviewTouchedSplineMeshes[SplineMeshIndex])
+		{
+			SplineMeshComponent->SetCollisionEnabled(PreviewSavedCollision[SplineMeshIndex]);
+		}
+	}
+
+	PreviewSplineMeshInputKeys.Empty();
+	PreviewSavedCollision.Empty();
+	PreviewTouchedSplineMeshes.Empty();
+}
 #endif
@@ -0,0 +1,468 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "SplineGeometry.h"
+#include "Algo/Reverse.h"
+
+namespace SplineGeometryDefs
+{
+	/** Samples per spline segment used to find self intersections of an offset spline */
+	const int32 IntersectionSamplesPerSegment = 8;
+
+	/** Points whose arrive and leave directions differ by more than about 1 degree are treated as sharp corners */
+	const float CornerCosThreshold = 0.9998f;
+
+	/** Outer corners whose miter would be longer than this many times the offset distance are beveled */
+	const float MiterLimit = 4.0f;
+
+	/** Offsetting inwards past the radius of a curve would reverse its tangents, they are kept at least this fraction of their length */
+	const float MinTangentScale = 0.01f;
+
+	/** Distance from a key at which the curvature on either side of it is measured */
+	const float CurvatureKeyOffset = 0.001f;
+
+	FORCEINLINE float Cross(const FVector2D& A, const FVector2D& B)
+	{
+		return A.X * B.Y - A.Y * B.X;
+	}
+
+	/** Normal to the right of the direction of travel */
+	FORCEINLINE FVector2D GetRightNormal(const FVector2D& Direction)
+	{
+		return FVector2D(Direction.Y, -Direction.X);
+	}
+
+	/** Signed curvature in the XY plane, positive when turning left */
+	float GetCurvature(const FInterpCurveVector& Curve, float Key)
+	{
+		const FVector2D FirstDerivative(Curve.EvalDerivative(Key, FVector::ZeroVector));
+		const FVector2D SecondDerivative(Curve.EvalSecondDerivative(Key, FVector::ZeroVector));
+		const float Speed = FirstDerivative.Size();
+		if (Speed < KINDA_SMALL_NUMBER)
+		{
+			return 0.0f;
+		}
+		return Cross(FirstDerivative, SecondDerivative) / (Speed * Speed * Speed);
+	}
+
+	/** Self intersection of a sampled spline, positions are in samples from the start of the spline */
+	struct FSelfIntersection
+	{
+		float StartPosition;
+		float EndPosition;
+		FVector2D Location;
+	};
+
+	/** Intersection of two segments, with the fraction along each of them */
+	bool IntersectSegments(const FVector2D& StartA, const FVector2D& EndA, const FVector2D& StartB, const FVector2D& EndB, float& OutAlphaA, float& OutAlphaB)
+	{
+		const FVector2D DeltaA = EndA - StartA;
+		const FVector2D DeltaB = EndB - StartB;
+		const float Denominator = Cross(DeltaA, DeltaB);
+		if (FMath::Abs(Denominator) < SMALL_NUMBER)
+		{
+			// Parallel segments, overlapping ones don't make a loop worth cutting
+			return false;
+		}
+
+		const FVector2D StartDelta = StartB - StartA;
+		OutAlphaA = Cross(StartDelta, DeltaB) / Denominator;
+		OutAlphaB = Cross(StartDelta, DeltaA) / Denominator;
+		return OutAlphaA >= 0.0f && OutAlphaA <= 1.0f && OutAlphaB >= 0.0f && OutAlphaB <= 1.0f;
+	}
+}
+
+void FSplineGeometry::OffsetSpline(const FInterpCurveVector& Curve, bool bClosedLoop, float Distance, FSplineCurvePoints& OutPoints)
+{
+	using namespace SplineGeometryDefs;
+
+	const int32 NumPoints = Curve.Points.Num();
+	OutPoints.Reset(NumPoints);
+	OutPoints.bClosedLoop = bClosedLoop;
+
+	if (NumPoints < 2)
+	{
+		for (const FInterpCurvePoint<FVector>& Point : Curve.Points)
+		{
+			OutPoints.Add(Point.OutVal, Point.ArriveTangent, Point.LeaveTangent);
+		}
+		return;
+	}
+
+	// Closed loops offset outwards whichever way they wind
+	float OffsetDistance = Distance;
+	if (bClosedLoop)
+	{
+		TArray<FVector2D> KeyPolygon;
+		KeyPolygon.Reserve(NumPoints);
+		for (const FInterpCurvePoint<FVector>& Point : Curve.Points)
+		{
+			KeyPolygon.Add(FVector2D(Point.OutVal));
+		}
+		if (GetSignedArea(KeyPolygon) < 0.0f)
+		{
+			OffsetDistance = -Distance;
+		}
+	}
+
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		const FInterpCurvePoint<FVector>& Point = Curve.Points[PointIndex];
+		const bool bHasArriveSegment = bClosedLoop || PointIndex > 0;
+		const bool bHasLeaveSegment = bClosedLoop || PointIndex < NumPoints - 1;
+
+		// Directions on either side of the point, open ends only have one
+		FVector2D ArriveDirection = FVector2D(Point.ArriveTangent).GetSafeNormal();
+		FVector2D LeaveDirection = FVector2D(Point.LeaveTangent).GetSafeNormal();
+		if (ArriveDirection.IsZero() || !bHasArriveSegment)
+		{
+			ArriveDirection = LeaveDirection;
+		}
+		if (LeaveDirection.IsZero() || !bHasLeaveSegment)
+		{
+			LeaveDirection = ArriveDirection;
+		}
+
+		// The offset curve q = p + d * n moves at a speed of (1 + d * curvature) relative to the original curve
+		const float ArriveKey = (PointIndex == 0) ? NumPoints - CurvatureKeyOffset : PointIndex - CurvatureKeyOffset;
+		const float ArriveCurvature = bHasArriveSegment ? GetCurvature(Curve, ArriveKey) : 0.0f;
+		const float LeaveCurvature = bHasLeaveSegment ? GetCurvature(Curve, PointIndex + CurvatureKeyOffset) : 0.0f;
+		const FVector ArriveTangent = Point.ArriveTangent * FMath::Max(MinTangentScale, 1.0f + OffsetDistance * ArriveCurvature);
+		const FVector LeaveTangent = Point.LeaveTangent * FMath::Max(MinTangentScale, 1.0f + OffsetDistance * LeaveCurvature);
+
+		const FVector2D ArriveNormal = GetRightNormal(ArriveDirection);
+		const FVector2D LeaveNormal = GetRightNormal(LeaveDirection);
+		const FVector2D Location(Point.OutVal);
+
+		if (FVector2D::DotProduct(ArriveDirection, LeaveDirection) >= CornerCosThreshold)
+		{
+			const FVector2D Normal = (ArriveNormal + LeaveNormal).GetSafeNormal();
+			OutPoints.Add(FVector(Location + Normal * OffsetDistance, Point.OutVal.Z), ArriveTangent, LeaveTangent);
+			continue;
+		}
+
+		// Sharp corner, the miter point is where the two offset sides meet
+		const bool bOuterCorner = Cross(ArriveDirection, LeaveDirection) * OffsetDistance > 0.0f;
+		const float MiterDenominator = 1.0f + FVector2D::DotProduct(ArriveNormal, LeaveNormal);
+		const float MiterLength = (MiterDenominator > KINDA_SMALL_NUMBER) ? FMath::Sqrt(2.0f / MiterDenominator) : BIG_NUMBER;
+
+		if (MiterLength <= MiterLimit || (!bOuterCorner && MiterDenominator > KINDA_SMALL_NUMBER))
+		{
+			const FVector2D MiterOffset = (ArriveNormal + LeaveNormal) / MiterDenominator;
+			OutPoints.Add(FVector(Location + MiterOffset * OffsetDistance, Point.OutVal.Z), ArriveTangent, LeaveTangent);
+		}
+		else
+		{
+			// Bevel with a straight segment between the ends of the two offset sides
+			const FVector BevelStart(Location + ArriveNormal * OffsetDistance, Point.OutVal.Z);
+			const FVector BevelEnd(Location + LeaveNormal * OffsetDistance, Point.OutVal.Z);
+			OutPoints.Add(BevelStart, ArriveTangent, BevelEnd - BevelStart);
+			OutPoints.Add(BevelEnd, BevelEnd - BevelStart, LeaveTangent);
+		}
+	}
+
+	RemoveSelfIntersections(OutPoints, IntersectionSamplesPerSegment);
+}
+
+void FSplineGeometry::RemoveSelfIntersections(FSplineCurvePoints& Points, int32 SamplesPerSegment)
+{
+	using namespace SplineGeometryDefs;
+
+	const int32 NumPoints = Points.Num();
+	if (NumPoints < 2)
+	{
+		return;
+	}
+
+	TArray<FVector2D> Samples;
+	SampleSplinePoints(Points, SamplesPerSegment, Samples);
+
+	const int32 NumSamples = Samples.Num();
+	const int32 NumSampleSegments = Points.bClosedLoop ? NumSamples : NumSamples - 1;
+	if (NumSampleSegments < 3)
+	{
+		return;
+	}
+
+	// Bucket the sample segments in a grid about the size of a segment, so only nearby segments are tested against each other
+	FBox2D Bounds(Samples);
+	float TotalLength = 0.0f;
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSampleSegments; ++SegmentIndex)
+	{
+		TotalLength += FVector2D::Distance(Samples[SegmentIndex], Samples[(SegmentIndex + 1) % NumSamples]);
+	}
+	const float CellSize = FMath::Max(2.0f * TotalLength / NumSampleSegments, KINDA_SMALL_NUMBER);
+
+	TMap<FIntPoint, TArray<int32>> Grid;
+	TSet<uint64> TestedPairs;
+	TArray<FSelfIntersection> Intersections;
+
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSampleSegments; ++SegmentIndex)
+	{
+		const FVector2D& Start = Samples[SegmentIndex];
+		const FVector2D& End = Samples[(SegmentIndex + 1) % NumSamples];
+
+		const FIntPoint MinCell(FMath::FloorToInt((FMath::Min(Start.X, End.X) - Bounds.Min.X) / CellSize), FMath::FloorToInt((FMath::Min(Start.Y, End.Y) - Bounds.Min.Y) / CellSize));
+		const FIntPoint MaxCell(FMath::FloorToInt((FMath::Max(Start.X, End.X) - Bounds.Min.X) / CellSize), FMath::FloorToInt((FMath::Max(Start.Y, End.Y) - Bounds.Min.Y) / CellSize));
+
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+			{
+				TArray<int32>& Cell = Grid.FindOrAdd(FIntPoint(CellX, CellY));
+				for (int32 OtherSegmentIndex : Cell)
+				{
+					// Neighboring segments always touch
+					const bool bAdjacent = (SegmentIndex - OtherSegmentIndex <= 1) || (Points.bClosedLoop && OtherSegmentIndex == 0 && SegmentIndex == NumSampleSegments - 1);
+					if (bAdjacent)
+					{
+						continue;
+					}
+
+					bool bAlreadyTested = false;
+					TestedPairs.Add(((uint64)OtherSegmentIndex << 32) | (uint64)SegmentIndex, &bAlreadyTested);
+					if (bAlreadyTested)
+					{
+						continue;
+					}
+
+					float OtherAlpha, Alpha;
+					if (IntersectSegments(Samples[OtherSegmentIndex], Samples[(OtherSegmentIndex + 1) % NumSamples], Start, End, OtherAlpha, Alpha))
+					{
+						FSelfIntersection& Intersection = Intersections.AddDefaulted_GetRef();
+						Intersection.StartPosition = OtherSegmentIndex + OtherAlpha;
+						Intersection.EndPosition = SegmentIndex + Alpha;
+						Intersection.Location = Start + (End - Start) * Alpha;
+
+						// On a closed loop, cut out the shorter side of the intersection
+						if (Points.bClosedLoop && Intersection.EndPosition - Intersection.StartPosition > NumSamples * 0.5f)
+						{
+							Swap(Intersection.StartPosition, Intersection.EndPosition);
+							Intersection.EndPosition += NumSamples;
+						}
+					}
+				}
+				Cell.Add(SegmentIndex);
+			}
+		}
+	}
+
+	if (Intersections.Num() == 0)
+	{
+		return;
+	}
+
+	// Keep the largest loops, the smaller ones inside them go away with them
+	Intersections.Sort([](const FSelfIntersection& A, const FSelfIntersection& B)
+	{
+		return (A.EndPosition - A.StartPosition) > (B.EndPosition - B.StartPosition);
+	});
+
+	auto IsInside = [NumSamples](float Position, const FSelfIntersection& Intersection)
+	{
+		return (Position > Intersection.StartPosition && Position < Intersection.EndPosition)
+			|| (Position + NumSamples > Intersection.StartPosition && Position + NumSamples < Intersection.EndPosition);
+	};
+	auto GetSegment = [SamplesPerSegment, NumPoints](float Position)
+	{
+		return FMath::FloorToInt(Position / SamplesPerSegment) % NumPoints;
+	};
+
+	TArray<FSelfIntersection> Cuts;
+	for (const FSelfIntersection& Intersection : Intersections)
+	{
+		bool bOverlaps = false;
+		for (const FSelfIntersection& Cut : Cuts)
+		{
+			// Cuts can't overlap, and each spline segment can only hold one end of a cut so its tangents can be trimmed exactly
+			if (IsInside(Intersection.StartPosition, Cut) || IsInside(Intersection.EndPosition, Cut) || IsInside(Cut.StartPosition, Intersection)
+				|| GetSegment(Intersection.StartPosition) == GetSegment(Cut.EndPosition) || GetSegment(Intersection.EndPosition) == GetSegment(Cut.StartPosition)
+				|| GetSegment(Intersection.StartPosition) == GetSegment(Cut.StartPosition) || GetSegment(Intersection.EndPosition) == GetSegment(Cut.EndPosition))
+			{
+				bOverlaps = true;
+				break;
+			}
+		}
+
+		// A cut that leaves nothing of the spline on the other side is not a loop
+		if (!bOverlaps && GetSegment(Intersection.StartPosition) != (GetSegment(Intersection.EndPosition) + 1) % NumPoints)
+		{
+			Cuts.Add(Intersection);
+		}
+	}
+
+	Cuts.Sort([](const FSelfIntersection& A, const FSelfIntersection& B)
+	{
+		return A.StartPosition < B.StartPosition;
+	});
+
+	// Rebuild the points, trimming the segments the cuts start and end in so the remaining curve is unchanged
+	FSplineCurvePoints NewPoints;
+	NewPoints.bClosedLoop = Points.bClosedLoop;
+	NewPoints.Reset(NumPoints + Cuts.Num());
+
+	TArray<FVector> ArriveTangents = Points.ArriveTangents;
+	TArray<FVector> LeaveTangents = Points.LeaveTangents;
+	TArray<FVector> CutArriveTangents;
+	TArray<FVector> CutLeaveTangents;
+	CutArriveTangents.SetNum(Cuts.Num());
+	CutLeaveTangents.SetNum(Cuts.Num());
+
+	auto GetSegmentDerivative = [&Points, NumPoints](int32 SegmentIndex, float Alpha)
+	{
+		const int32 NextIndex = (SegmentIndex + 1) % NumPoints;
+		return FMath::CubicInterpDerivative(Points.Locations[SegmentIndex], Points.LeaveTangents[SegmentIndex], Points.Locations[NextIndex], Points.ArriveTangents[NextIndex], Alpha);
+	};
+
+	for (int32 CutIndex = 0; CutIndex < Cuts.Num(); ++CutIndex)
+	{
+		const FSelfIntersection& Cut = Cuts[CutIndex];
+		const int32 StartSegment = GetSegment(Cut.StartPosition);
+		const int32 EndSegment = GetSegment(Cut.EndPosition);
+		const float StartAlpha = FMath::Frac(Cut.StartPosition / SamplesPerSegment);
+		const float EndAlpha = FMath::Frac(Cut.EndPosition / SamplesPerSegment);
+
+		// The part of a hermite segment between 0 and Alpha has its tangents scaled by Alpha
+		LeaveTangents[StartSegment] = Points.LeaveTangents[StartSegment] * StartAlpha;
+		CutArriveTangents[CutIndex] = GetSegmentDerivative(StartSegment, StartAlpha) * StartAlpha;
+		CutLeaveTangents[CutIndex] = GetSegmentDerivative(EndSegment, EndAlpha) * (1.0f - EndAlpha);
+		const int32 AfterEndPoint = (EndSegment + 1) % NumPoints;
+		ArriveTangents[AfterEndPoint] = Points.ArriveTangents[AfterEndPoint] * (1.0f - EndAlpha);
+	}
+
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		const float PointPosition = PointIndex * SamplesPerSegment;
+
+		bool bCutOut = false;
+		for (const FSelfIntersection& Cut : Cuts)
+		{
+			// A point exactly at the end of a cut is replaced by the intersection point
+			if (IsInside(PointPosition, Cut) || FMath::IsNearlyEqual(FMath::Fmod(Cut.EndPosition, (float)NumSamples), PointPosition))
+			{
+				bCutOut = true;
+				break;
+			}
+		}
+
+		if (!bCutOut)
+		{
+			NewPoints.Add(Points.Locations[PointIndex], ArriveTangents[PointIndex], LeaveTangents[PointIndex]);
+		}
+
+		// The intersection point replaces the cut out part, right after the segment it starts in
+		for (int32 CutIndex = 0; CutIndex < Cuts.Num(); ++CutIndex)
+		{
+			if (GetSegment(Cuts[CutIndex].StartPosition) == PointIndex)
+			{
+				const float Z = Points.Locations[PointIndex].Z;
+				NewPoints.Add(FVector(Cuts[CutIndex].Location, Z), CutArriveTangents[CutIndex], CutLeaveTangents[CutIndex]);
+			}
+		}
+	}
+
+	if (NewPoints.Num() >= 2)
+	{
+		Points = MoveTemp(NewPoints);
+	}
+}
+
+void FSplineGeometry::SampleSplinePoints(const FSplineCurvePoints& Points, int32 SamplesPerSegment, TArray<FVector2D>& OutSamples)
+{
+	const int32 NumPoints = Points.Num();
+	const int32 NumSegments = Points.bClosedLoop ? NumPoints : NumPoints - 1;
+	SamplesPerSegment = FMath::Max(SamplesPerSegment, 1);
+
+	OutSamples.Reset(FMath::Max(NumSegments, 0) * SamplesPerSegment + 1);
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		const int32 NextIndex = (SegmentIndex + 1) % NumPoints;
+		for (int32 SampleIndex = 0; SampleIndex < SamplesPerSegment; ++SampleIndex)
+		{
+			const float Alpha = (float)SampleIndex / SamplesPerSegment;
+			OutSamples.Add(FVector2D(FMath::CubicInterp(Points.Locations[SegmentIndex], Points.LeaveTangents[SegmentIndex], Points.Locations[NextIndex], Points.ArriveTangents[NextIndex], Alpha)));
+		}
+	}
+
+	if (!Points.bClosedLoop && NumPoints > 0)
+	{
+		OutSamples.Add(FVector2D(Points.Locations.Last()));
+	}
+}
+
+void FSplineGeometry::MakeThickWallPolygon(const FInterpCurveVector& Curve, bool bClosedLoop, float Thickness, int32 SamplesPerSegment, TArray<FVector2D>& OutPolygon)
+{
+	OutPolygon.Reset();
+
+	const float HalfThickness = FMath::Abs(Thickness) * 0.5f;
+	FSplineCurvePoints OuterPoints;
+	FSplineCurvePoints InnerPoints;
+	OffsetSpline(Curve, bClosedLoop, HalfThickness, OuterPoints);
+	OffsetSpline(Curve, bClosedLoop, -HalfThickness, InnerPoints);
+
+	TArray<FVector2D> OuterSamples;
+	TArray<FVector2D> InnerSamples;
+	SampleSplinePoints(OuterPoints, SamplesPerSegment, OuterSamples);
+	SampleSplinePoints(InnerPoints, SamplesPerSegment, InnerSamples);
+	if (OuterSamples.Num() < 2 || InnerSamples.Num() < 2)
+	{
+		return;
+	}
+
+	if (!bClosedLoop)
+	{
+		// Right side forwards, then the left side back to the start, the ends are closed by straight caps
+		OutPolygon.Reserve(OuterSamples.Num() + InnerSamples.Num());
+		OutPolygon.Append(OuterSamples);
+		for (int32 SampleIndex = InnerSamples.Num() - 1; SampleIndex >= 0; --SampleIndex)
+		{
+			OutPolygon.Add(InnerSamples[SampleIndex]);
+		}
+
+		if (GetSignedArea(OutPolygon) < 0.0f)
+		{
+			Algo::Reverse(OutPolygon);
+		}
+		return;
+	}
+
+	// Counter clockwise outside, clockwise hole
+	if (GetSignedArea(OuterSamples) < 0.0f)
+	{
+		Algo::Reverse(OuterSamples);
+	}
+	if (GetSignedArea(InnerSamples) > 0.0f)
+	{
+		Algo::Reverse(InnerSamples);
+	}
+
+	// Bridge from the first outer sample to the closest inner one
+	int32 BridgeIndex = 0;
+	float BridgeDistanceSquared = BIG_NUMBER;
+	for (int32 SampleIndex = 0; SampleIndex < InnerSamples.Num(); ++SampleIndex)
+	{
+		const float DistanceSquared = FVector2D::DistSquared(OuterSamples[0], InnerSamples[SampleIndex]);
+		if (DistanceSquared < BridgeDistanceSquared)
+		{
+			BridgeDistanceSquared = DistanceSquared;
+			BridgeIndex = SampleIndex;
+		}
+	}
+
+	OutPolygon.Reserve(OuterSamples.Num() + InnerSamples.Num() + 2);
+	OutPolygon.Append(OuterSamples);
+	OutPolygon.Add(OuterSamples[0]);
+	for (int32 SampleOffset = 0; SampleOffset <= InnerSamples.Num(); ++SampleOffset)
+	{
+		OutPolygon.Add(InnerSamples[(BridgeIndex + SampleOffset) % InnerSamples.Num()]);
+	}
+}
+
+float FSplineGeometry::GetSignedArea(const TArray<FVector2D>& Polygon)
+{
+	float DoubleArea = 0.0f;
+	for (int32 VertexIndex = 0; VertexIndex < Polygon.Num(); ++VertexIndex)
+	{
+		DoubleArea += SplineGeometryDefs::Cross(Polygon[VertexIndex], Polygon[(VertexIndex + 1) % Polygon.Num()]);
+	}
+	return DoubleArea * 0.5f;
+}
@@ -6,6 +6,8 @@
 #include "Runtime/Engine/Classes/Kismet/BlueprintFunctionLibrary.h"
 #include "GeometryBlueprintLibrary.generated.h"
 
+class USplineComponent;
+
 /**
  * Sa
  */
@@ -19,5 +21,18 @@ public:
 	// Just calls the same function defined in PaperGeomTools
 	UFUNCTION(BlueprintCallable, Category = GeometryUtilities)
 	static bool TriangulatePoly(TArray<FVector2D>& OutTris, const TArray<FVector2D>& InPolyVerts, bool bKeepColinearVertices);
+
+	// Outline of a wall of the given thickness centered on the spline as one polygon, in the local space of the spline, ready for TriangulatePoly
+	UFUNCTION(BlueprintCallable, Category = GeometryUtilities)
+	static bool MakeThickWallPolygon(TArray<FVector2D>& OutPolygon, const USplineComponent* Spline, float Thickness, int32 SamplesPerSegment = 8);
+
+	// Samples a spline into a polyline in the world XY plane, straight segments only add their start point, a closed loop doesn't repeat its first point at the end
+	UFUNCTION(BlueprintCallable, Category = GeometryUtilities)
+	static bool GetSplineOutline(TArray<FVector2D>& OutOutline, const USplineComponent* Spline, int32 SamplesPerSegment = 8);
+
+	// Union of the outlines of closed splines in the world XY plane, as one polygon ready for TriangulatePoly with any holes bridged to the outside
+	// Returns false if the union isn't a single piece, OutPolygon is then the largest piece
+	UFUNCTION(BlueprintCallable, Category = GeometryUtilities)
+	static bool UnionSplineOutlines(TArray<FVector2D>& OutPolygon, const TArray<USplineComponent*>& Splines, int32 SamplesPerSegment = 8);
 	
 };
@@ -4,8 +4,28 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "PhysicsEngine/BodyInstance.h"
 #include "PinballBall.generated.h"
 
+class FPinballForceFieldSet;
+class USplineComponent;
+
+/** How a ball is moved, only dynamic and sleeping balls are simulated */
+UENUM(BlueprintType)
+enum class EPinballBallState : uint8
+{
+	/** Simulated by physics */
+	Dynamic,
+	/** Held in place out of the simulation, such as in a kicker hole */
+	Captured,
+	/** Simulated but asleep, such as resting in a lock, dynamic again once something wakes it */
+	Sleeping,
+	/** Moved along a path out of the simulation, such as a kicker eject or a channel run */
+	KinematicPath,
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPinballBallStateChangedSignature, EPinballBallState, NewState);
+
 UCLASS(config=Game)
 class APinballBall : public APawn
 {
@@ -22,8 +42,105 @@ public:
 	UPROPERTY(EditAnywhere, Category=Ball)
 	float RollTorque;
 
+	/** Called when the ball changes state, such as when it leaves a path back to dynamics */
+	UPROPERTY(BlueprintAssignable, Category = Ball)
+	FPinballBallStateChangedSignature OnBallStateChanged;
+
 public:
 	/** Returns Ball subobject **/
 	FORCEINLINE class UStaticMeshComponent* GetBall() const { return Ball; }
 
+	/** Puts a pooled ball on the table, moving it with physics from the given velocity */
+	void ActivatePooledBall(const FTransform& Transform, const FVector& Velocity);
+
+	/** Takes a ball off the table back into the pool, hidden, without collision or physics */
+	void DeactivatePooledBall();
+
+	/** Whether the ball came from the pool of the game mode, and goes back to it when drained */
+	bool IsPooled() const
+	{
+		return bPooled;
+	}
+
+	/** Id of the ball in hit events, given by the game mode when it spawns the ball, 0 for the ball the player starts with */
+	uint8 GetBallId() const
+	{
+		return BallId;
+	}
+
+	/** Whether the ball is on the table, pooled balls are only while activated */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Ball)
+	bool IsInPlay() const
+	{
+		return !bPooled || bPooledBallActive;
+	}
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Ball)
+	EPinballBallState GetBallState() const
+	{
+		return BallState;
+	}
+
+	/** Takes the ball out of the simulation, held at a location until it is moved along a path or released */
+	UFUNCTION(BlueprintCallable, Category = Ball)
+	void CaptureBall(FVector Location);
+
+	/** Puts the ball to sleep where it rests, it stays in the simulation and is dynamic again once hit */
+	UFUNCTION(BlueprintCallable, Category = Ball)
+	void SleepBall();
+
+	/**
+	 * Takes the ball out of the simulation and moves it along a path at a constant speed
+	 * At the end of the path the ball is released with exactly the given velocity, or along the end of the path at the same speed if it is zero
+	 */
+	UFUNCTION(BlueprintCallable, Category = Ball)
+	void MoveBallAlongPath(const USplineComponent* Path, float Speed, FVector ReleaseVelocity);
+
+	/** Returns the ball to the simulation where it is, with exactly the given velocity and no spin */
+	UFUNCTION(BlueprintCallable, Category = Ball)
+	void ReleaseBall(FVector Velocity);
+
+	/** Balls in play in a state, for profiling */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Ball, meta = (WorldContext = "WorldContextObject"))
+	static int32 GetNumBallsInState(const UObject* WorldContextObject, EPinballBallState State);
+
+	//~ Begin AActor Interface
+	virtual void Tick(float DeltaSeconds) override;
+	//~ End AActor Interface
+
+private:
+	friend class APinballGameMode;
+
+	void SetBallState(EPinballBallState NewState);
+
+	/** Stops simulating the ball, still overlapping triggers as it is moved */
+	void StopSimulating();
+
+	/** Accelerates the ball by the force fields, in each physics substep */
+	void ApplyForceFields(float DeltaTime, FBodyInstance* BodyInstance);
+
+	FCalculateCustomPhysics OnCalculateCustomPhysics;
+
+	/** Fields of the world for the physics step of this frame, only rebuilt on the game thread before it */
+	const FPinballForceFieldSet* ForceFields;
+
+	EPinballBallState BallState;
+
+	/** Collision of the ball while it is simulated, restored when it is released */
+	TEnumAsByte<ECollisionEnabled::Type> SimulatedCollision;
+
+	UPROPERTY(Transient)
+	const USplineComponent* Path;
+
+	float PathSpeed;
+
+	float PathDistance;
+
+	FVector PathReleaseVelocity;
+
+	uint8 BallId;
+
+	uint8 bPooled : 1;
+
+	uint8 bPooledBallActive : 1;
 };
@@ -0,0 +1,125 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "PinballEventBus.generated.h"
+
+/** What a ball hit */
+UENUM(BlueprintType)
+enum class EPinballHitType : uint8
+{
+	Bumper,
+	Slingshot,
+	Target,
+	Rollover,
+	Spinner,
+	Gate,
+	Kicker,
+	Ramp,
+	Drain,
+	Custom,
+};
+
+/** A ball hitting a table element, small enough for thousands to be queued in a frame */
+USTRUCT(BlueprintType)
+struct FPinballHitEvent
+{
+	GENERATED_BODY()
+
+	FPinballHitEvent()
+		: Time(0.0f)
+		, ElementId(INDEX_NONE)
+		, BallId(0)
+		, Type(EPinballHitType::Custom)
+	{}
+
+	/** World time of the physics sub-step the hit happened in */
+	UPROPERTY(BlueprintReadOnly, Category = Event)
+	float Time;
+
+	/** Id the element was given when it registered with the game mode */
+	UPROPERTY(BlueprintReadOnly, Category = Event)
+	int32 ElementId;
+
+	/** Id the game mode gave the ball when it spawned it */
+	UPROPERTY(BlueprintReadOnly, Category = Event)
+	uint8 BallId;
+
+	UPROPERTY(BlueprintReadOnly, Category = Event)
+	EPinballHitType Type;
+};
+
+/**
+ * Fixed capacity ring of hit events, any thread can post to it without locking and the game thread drains it once a frame
+ * Events posted while the ring is full are dropped and counted
+ */
+class PINBALL_API FPinballEventBus
+{
+public:
+	FPinballEventBus();
+
+	/** Sets the capacity, rounded up to a power of two, and drops the queued events and the counts, not safe while other threads post */
+	void Init(int32 InCapacity);
+
+	/** Queues an event, returns false if the ring was full, safe from any thread */
+	bool Post(const FPinballHitEvent& Event);
+
+	/** Appends the queued events to OutEvents in the order they were posted, returns how many there were, only from the game thread */
+	int32 Drain(TArray<FPinballHitEvent>& OutEvents);
+
+	int32 GetCapacity() const
+	{
+		return Slots.Num();
+	}
+
+	/** Events queued and not drained yet */
+	int32 GetDepth() const
+	{
+		return int32(EnqueuePosition.Load(EMemoryOrder::Relaxed) - DequeuePosition);
+	}
+
+	/** Deepest the ring has been when drained */
+	int32 GetHighWaterMark() const
+	{
+		return HighWaterMark;
+	}
+
+	int64 GetNumDropped() const
+	{
+		return NumDropped.Load(EMemoryOrder::Relaxed);
+	}
+
+	int64 GetNumDrained() const
+	{
+		return NumDrained;
+	}
+
+private:
+	struct FSlot
+	{
+		/** Position the slot can next be written at, or one past the position it was written at once the event is in */
+		TAtomic<uint32> Sequence;
+		FPinballHitEvent Event;
+	};
+
+	TArray<FSlot> Slots;
+
+	uint32 Mask;
+
+	/** Written by every posting thread */
+	TAtomic<uint32> EnqueuePosition;
+
+	TAtomic<int64> NumDropped;
+
+	/** Keeps the consumer side off the cache line the posting threads write */
+	uint8 Padding[PLATFORM_CACHE_LINE_SIZE];
+
+	/** Only read and written by the game thread */
+	uint32 DequeuePosition;
+
+	int32 HighWaterMark;
+
+	int64 NumDrained;
+};
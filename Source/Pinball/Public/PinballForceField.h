@@ -0,0 +1,120 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PinballForceField.generated.h"
+
+class UPinballForceFieldComponent;
+
+UENUM(BlueprintType)
+enum class EPinballForceFieldType : uint8
+{
+	/** Towards the center of the field, away from it for a negative strength, such as a magnet */
+	Radial,
+	/** Along the direction of the field, such as wind */
+	Directional,
+	/** Around the axis of the field, such as a whirlpool */
+	Vortex,
+};
+
+/** How the strength of a field fades out to its radius */
+UENUM(BlueprintType)
+enum class EPinballForceFalloff : uint8
+{
+	/** Full strength up to the radius */
+	None,
+	Linear,
+	/** Fades out faster away from the center */
+	Quadratic,
+};
+
+/** A force field in world space */
+struct FPinballForceField
+{
+	EPinballForceFieldType Type;
+	EPinballForceFalloff Falloff;
+	FVector Location;
+	/** Direction of directional fields, axis of vortex fields */
+	FVector Direction;
+	/** Acceleration at the center, in cm/s^2 */
+	float Strength;
+	/** Unbounded if not positive */
+	float Radius;
+};
+
+/**
+ * Active force fields laid out to evaluate four at a time
+ * Each type and falloff is made of weights rather than branches, so every field is evaluated the same way
+ */
+class PINBALL_API FPinballForceFieldSet
+{
+public:
+	FPinballForceFieldSet();
+
+	void Reset();
+
+	void Add(const FPinballForceField& Field);
+
+	int32 Num() const
+	{
+		return NumFields;
+	}
+
+	/** Acceleration of each location from every field */
+	void Evaluate(const FVector* Locations, int32 NumLocations, FVector* OutAccelerations) const;
+
+	/** Evaluate one field at a time, for comparison */
+	void EvaluateScalar(const FVector* Locations, int32 NumLocations, FVector* OutAccelerations) const;
+
+private:
+	typedef TArray<float, TAlignedHeapAllocator<16>> FFieldArray;
+
+	int32 NumFields;
+
+	/** Padded to a multiple of four with fields of no radius and strength */
+	FFieldArray LocationX, LocationY, LocationZ;
+	FFieldArray RadiusSquared, InvRadius, Strength;
+	/** Weight of the acceleration towards the center */
+	FFieldArray RadialWeight;
+	/** Acceleration along the field, zero for fields that aren't directional */
+	FFieldArray DirectionX, DirectionY, DirectionZ;
+	/** Axis to accelerate around, zero for fields that aren't vortices */
+	FFieldArray AxisX, AxisY, AxisZ;
+	/** Falloff = Constant + Linear * F + Quadratic * F^2, F going from 1 at the center to 0 at the radius */
+	FFieldArray ConstantFalloff, LinearFalloff, QuadraticFalloff;
+};
+
+/** Force field components of a world, evaluated by every dynamic ball in each physics substep */
+UCLASS()
+class PINBALL_API UPinballForceFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UPinballForceFieldSubsystem();
+
+	static UPinballForceFieldSubsystem* Get(const UWorld* World);
+
+	void RegisterField(UPinballForceFieldComponent* Field);
+
+	void UnregisterField(UPinballForceFieldComponent* Field);
+
+	/** Rebuilds the fields before the next physics step, such as when one moved or changed strength */
+	void MarkFieldsDirty()
+	{
+		bFieldsDirty = true;
+	}
+
+	/** Rebuilds the fields if needed, on the game thread before physics, and returns them */
+	const FPinballForceFieldSet& UpdateFields();
+
+private:
+	UPROPERTY(Transient)
+	TArray<UPinballForceFieldComponent*> FieldComponents;
+
+	FPinballForceFieldSet Fields;
+
+	bool bFieldsDirty;
+};
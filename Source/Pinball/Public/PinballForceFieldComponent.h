@@ -0,0 +1,57 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "PinballForceField.h"
+#include "PinballForceFieldComponent.generated.h"
+
+/**
+ * Accelerates the balls within its radius, natively in each physics substep rather than through overlap events
+ * Directional fields push along the forward vector of the component, vortices turn around its up vector
+ */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballForceFieldComponent : public USceneComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = ForceField)
+	EPinballForceFieldType Type;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = ForceField)
+	EPinballForceFalloff Falloff;
+
+	/** Acceleration at the center, in cm/s^2 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = ForceField)
+	float Strength;
+
+	/** Balls further than this aren't affected, unbounded if not positive */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = ForceField)
+	float Radius;
+
+	UFUNCTION(BlueprintCallable, Category = ForceField)
+	void SetStrength(float NewStrength);
+
+	UFUNCTION(BlueprintCallable, Category = ForceField)
+	void SetRadius(float NewRadius);
+
+	/** The field in world space */
+	FPinballForceField GetForceField() const;
+
+	//~ Begin UActorComponent Interface
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void Activate(bool bReset = false) override;
+	virtual void Deactivate() override;
+	//~ End UActorComponent Interface
+
+protected:
+	//~ Begin USceneComponent Interface
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
+	//~ End USceneComponent Interface
+
+private:
+	void MarkFieldsDirty();
+};
@@ -4,14 +4,160 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameMode.h"
+#include "PinballEventBus.h"
 #include "PinballGameMode.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPinballHitEventsSignature, const TArray<FPinballHitEvent>&, Events);
+DECLARE_MULTICAST_DELEGATE_OneParam(FPinballNativeHitEventsSignature, TArrayView<const FPinballHitEvent>);
+
+class APinballBall;
+
+/** Time taken to put balls on the table and take them off it */
+struct FPinballBallPoolStats
+{
+	FPinballBallPoolStats()
+		: NumAcquired(0)
+		, NumReleased(0)
+		, NumSpawned(0)
+		, AcquireSeconds(0.0)
+		, MaxAcquireSeconds(0.0)
+		, ReleaseSeconds(0.0)
+		, MaxReleaseSeconds(0.0)
+	{}
+
+	int32 NumAcquired;
+	int32 NumReleased;
+	/** Balls spawned because the pool was empty or off */
+	int32 NumSpawned;
+	double AcquireSeconds;
+	double MaxAcquireSeconds;
+	double ReleaseSeconds;
+	double MaxReleaseSeconds;
+};
+
 UCLASS(minimalapi)
 class APinballGameMode : public AGameMode
 {
 	GENERATED_UCLASS_BODY()
 
-};
+	/** Score of the game, the score components of parts register their hits with it */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Score)
+	class UPinballScoreComponent* ScoreComponent;
+
+	/** Hit events the event bus can hold between two frames, more are dropped */
+	UPROPERTY(EditDefaultsOnly, Category = Events, meta = (ClampMin = "2"))
+	int32 EventBusCapacity;
+
+	/** Hit events posted since the last frame, broadcast once a frame when there are any */
+	UPROPERTY(BlueprintAssignable, Category = Events)
+	FPinballHitEventsSignature OnHitEvents;
+
+	/** Same as OnHitEvents, for native listeners */
+	FPinballNativeHitEventsSignature OnNativeHitEvents;
+
+	/** Ring table elements post their hits to, from any thread */
+	FPinballEventBus& GetEventBus()
+	{
+		return EventBus;
+	}
+
+	/** Gives a table element the id its hit events refer to it by */
+	UFUNCTION(BlueprintCallable, Category = Events)
+	int32 RegisterElement(UObject* Element);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Events)
+	UObject* GetElement(int32 ElementId) const;
+
+	/**
+	 * Queues a hit event, returns false if the bus was full
+	 * @param	Time	World time of the physics sub-step the hit happened in, the current world time if negative
+	 */
+	UFUNCTION(BlueprintCallable, Category = Events)
+	bool PostHitEvent(int32 ElementId, EPinballHitType Type, uint8 BallId, float Time = -1.0f);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Events)
+	int32 GetEventQueueDepth() const
+	{
+		return EventBus.GetDepth();
+	}
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Events)
+	int32 GetEventQueueHighWaterMark() const
+	{
+		return EventBus.GetHighWaterMark();
+	}
 
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Events)
+	int64 GetNumDroppedEvents() const
+	{
+		return EventBus.GetNumDropped();
+	}
 
+	/** Whether multiball balls come from a pool created with the game mode, rather than being spawned and destroyed */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Balls)
+	bool bUseBallPool;
 
+	/** Balls created up front for the pool, more are spawned if a game needs them */
+	UPROPERTY(EditDefaultsOnly, Category = Balls, meta = (ClampMin = "0"))
+	int32 BallPoolSize;
+
+	/** Class of the extra balls, the default pawn class if it is a ball and this isn't set */
+	UPROPERTY(EditDefaultsOnly, Category = Balls)
+	TSubclassOf<APinballBall> ExtraBallClass;
+
+	/** Puts an extra ball on the table, such as for multiball, it isn't possessed by anyone */
+	UFUNCTION(BlueprintCallable, Category = Balls)
+	APinballBall* AcquireBall(const FTransform& Transform, FVector Velocity);
+
+	/** Takes a drained extra ball off the table, back into the pool if it came from it */
+	UFUNCTION(BlueprintCallable, Category = Balls)
+	void ReleaseBall(APinballBall* Ball);
+
+	/** Pooled balls not on the table */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Balls)
+	int32 GetNumFreeBalls() const
+	{
+		return FreeBalls.Num();
+	}
+
+	const FPinballBallPoolStats& GetBallPoolStats() const
+	{
+		return BallPoolStats;
+	}
+
+	void ResetBallPoolStats()
+	{
+		BallPoolStats = FPinballBallPoolStats();
+	}
+
+	//~ Begin AActor Interface
+	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void Tick(float DeltaSeconds) override;
+	//~ End AActor Interface
+
+private:
+	FPinballEventBus EventBus;
+
+	/** Registered table elements, indexed by id */
+	UPROPERTY(Transient)
+	TArray<UObject*> Elements;
+
+	/** Events drained this frame, kept to not reallocate every frame */
+	TArray<FPinballHitEvent> DrainedEvents;
+
+	/** Spawns a ball off the table, ready to be pooled */
+	APinballBall* SpawnPooledBall();
+
+	/** Gives a spawned ball the next id for its hit events, wrapping past 255 and skipping 0 */
+	void AssignBallId(APinballBall* Ball);
+
+	/** Pooled balls off the table, the last one is the next used */
+	UPROPERTY(Transient)
+	TArray<APinballBall*> FreeBalls;
+
+	FPinballBallPoolStats BallPoolStats;
+
+	/** Id of the next ball spawned */
+	uint8 NextBallId;
+};
@@ -0,0 +1,41 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PinballHingeComponent.h"
+#include "PinballGateComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPinballGatePassedSignature);
+
+/**
+ * A one way gate, opened by balls crossing it along the X axis of the box and bouncing back the ones crossing the other way
+ * Posts a gate event on the bus for each ball let through
+ */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballGateComponent : public UPinballHingeComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** How far the flap opens at most, in degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Gate, meta = (ClampMin = "0.0", ClampMax = "180.0"))
+	float MaxOpenAngle;
+
+	/** Restitution of the flap on its stops */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Gate, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float StopRestitution;
+
+	/** Restitution of the balls bounced back by the closed side */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Gate, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float BlockedRestitution;
+
+	UPROPERTY(BlueprintAssignable, Category = Gate)
+	FPinballGatePassedSignature OnGatePassed;
+
+protected:
+	//~ Begin UPinballHingeComponent Interface
+	virtual void OnBallCrossing(APinballBall* Ball, float CrossingSpeed) override;
+	virtual void OnStepped() override;
+	//~ End UPinballHingeComponent Interface
+};
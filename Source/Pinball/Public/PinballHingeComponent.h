@@ -0,0 +1,114 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/BoxComponent.h"
+#include "PinballEventBus.h"
+#include "PinballTickManager.h"
+#include "PinballHingeComponent.generated.h"
+
+class APinballBall;
+
+/**
+ * A flap turning around the Y axis of the box, such as a spinner or a gate, simulated as one damped angle rather than a constrained body
+ * Balls crossing the box along its X axis give the flap an angular impulse worked out from their velocity, the angle is then stepped at a fixed rate
+ * so the same crossings always turn the flap the same way, whatever the frame rate. The flap sleeps in the tick manager once it hangs still
+ */
+UCLASS(Abstract)
+class PINBALL_API UPinballHingeComponent : public UBoxComponent, public IPinballElementUpdater
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Component turned with the flap, the first one attached to the box if not set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Hinge)
+	USceneComponent* FlapComponent;
+
+	/** Distance from the hinge to where the ball hits the flap */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hinge, meta = (ClampMin = "1.0"))
+	float FlapLength;
+
+	/** Moment of inertia of the flap over that of the ball at the flap length, lighter flaps spin faster */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hinge, meta = (ClampMin = "0.0"))
+	float FlapInertiaRatio;
+
+	/** Restitution of the hits of the ball on the flap */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hinge, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Restitution;
+
+	/** Angular velocity lost per second, as a fraction */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hinge, meta = (ClampMin = "0.0"))
+	float Damping;
+
+	/** Angular acceleration bringing the flap back to hang down, in rad/s^2 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Hinge, meta = (ClampMin = "0.0"))
+	float RestoringStiffness;
+
+	/** Angle of the flap, 0 when it hangs down, in radians */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Hinge)
+	float GetFlapAngle() const
+	{
+		return Angle;
+	}
+
+	/** In radians per second */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Hinge)
+	float GetFlapAngularVelocity() const
+	{
+		return AngularVelocity;
+	}
+
+	//~ Begin IPinballElementUpdater Interface
+	virtual void UpdateElement(float DeltaTime) override;
+	//~ End IPinballElementUpdater Interface
+
+	//~ Begin UActorComponent Interface
+	virtual void OnRegister() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~ End UActorComponent Interface
+
+protected:
+	/** Called when a ball enters the box, with its velocity along the X axis of the box */
+	virtual void OnBallCrossing(APinballBall* Ball, float CrossingSpeed) {}
+
+	/** Called after each step of the angle, to keep it in range */
+	virtual void OnStepped() {}
+
+	/**
+	 * Angular impulse of a ball hitting the flap at the flap length, given the speed of the ball along the X axis
+	 * The ball is remembered as the one turning the flap, for the events of the turns it causes
+	 * @return	Change in angular velocity of the flap
+	 */
+	float ApplyBallImpulse(const APinballBall* Ball, float CrossingSpeed);
+
+	/** Queues an event on the bus of the game mode, for the given ball, at the given world time or the current one if negative */
+	void PostElementEvent(EPinballHitType Type, uint8 BallId, float Time = -1.0f);
+
+	/** Wakes the flap in the tick manager */
+	void WakeFlap();
+
+	float Angle;
+
+	float AngularVelocity;
+
+	/** World time at the end of the step being made, for events happening in OnStepped */
+	float StepEndTime;
+
+	/** Id of the ball that last gave the flap an impulse */
+	uint8 ImpulseBallId;
+
+private:
+	UFUNCTION()
+	void OnBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Time not yet stepped */
+	float StepTimeRemainder;
+
+	/** Relative rotation of the flap component when it hangs down */
+	FQuat FlapRestRotation;
+
+	/** Id of the owner in the game mode, for events */
+	int32 ElementId;
+};
@@ -0,0 +1,121 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "PinballLightBankComponent.generated.h"
+
+/** State of one light of a light bank */
+USTRUCT(BlueprintType)
+struct FPinballLight
+{
+	GENERATED_BODY()
+
+	FPinballLight()
+		: Color(FLinearColor::White)
+		, Intensity(1.0f)
+		, bOn(false)
+	{}
+
+	/** Name gameplay finds the light by, usually the label of the indicator it replaces */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Light)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Light)
+	FLinearColor Color;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Light)
+	float Intensity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Light)
+	bool bOn;
+};
+
+/**
+ * Draws every playfield light as one instance, with the colour and brightness of each light in its per instance custom data
+ * The custom data uses the same layout as batched parts (EPinballPartCustomData), brightness being the intensity of a light that is on and 0 otherwise
+ * Light changes are only recorded when they are made, and all the lights changed in a frame are uploaded together at the end of it
+ */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballLightBankComponent : public UInstancedStaticMeshComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** One entry per instance */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Lights)
+	TArray<FPinballLight> Lights;
+
+	/** Adds a light as a new instance, with a transform relative to this component, returns its index */
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	int32 AddLight(const FTransform& LightTransform, FName LightName, FLinearColor Color, float Intensity = 1.0f, bool bOn = false);
+
+	/** Removes a light and its instance, the lights after it move down one index */
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	bool RemoveLight(int32 LightIndex);
+
+	/** Index of the light with this name, or INDEX_NONE */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Lights)
+	int32 FindLight(FName LightName) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Lights)
+	int32 GetNumLights() const
+	{
+		return Lights.Num();
+	}
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Lights)
+	bool IsLightOn(int32 LightIndex) const;
+
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	void SetLightOn(int32 LightIndex, bool bOn);
+
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	void SetLightIntensity(int32 LightIndex, float Intensity);
+
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	void SetLightColor(int32 LightIndex, FLinearColor Color);
+
+	/** Sets everything about a light at once */
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	void SetLight(int32 LightIndex, bool bOn, float Intensity, FLinearColor Color);
+
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	void SetAllLightsOn(bool bOn);
+
+	/** Uploads the lights changed since the last upload now, rather than at the end of the frame */
+	UFUNCTION(BlueprintCallable, Category = Lights)
+	void FlushLights();
+
+	/** Number of times light data has been uploaded, at most once per frame */
+	int32 GetNumLightUploads() const
+	{
+		return NumLightUploads;
+	}
+
+	//~ Begin UActorComponent Interface
+	virtual void OnRegister() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+#if WITH_EDITOR
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~ End UObject Interface
+#endif
+
+private:
+	/** Records a change to a light, it is uploaded at the end of the frame */
+	void MarkLightDirty(int32 LightIndex);
+
+	/** Writes the custom data of the dirty lights, or all of them, and marks the render state dirty once */
+	void UploadLights(bool bAllLights);
+
+	/** Lights changed since the last upload */
+	TBitArray<> DirtyLights;
+
+	int32 NumDirtyLights;
+
+	int32 NumLightUploads;
+};
@@ -0,0 +1,152 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "PinballLightShow.generated.h"
+
+class UPinballLightBankComponent;
+
+/** State a light is set to at a time of a light show */
+USTRUCT(BlueprintType)
+struct FPinballLightShowKeyframe
+{
+	GENERATED_BODY()
+
+	FPinballLightShowKeyframe()
+		: Time(0.0f)
+		, bOn(true)
+		, Intensity(1.0f)
+		, Color(FLinearColor::White)
+	{}
+
+	/** Seconds from the start of the show */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Keyframe)
+	float Time;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Keyframe)
+	bool bOn;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Keyframe)
+	float Intensity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Keyframe)
+	FLinearColor Color;
+};
+
+/** The same keyframes played on a group of lights, each light starting a delay after the previous one */
+USTRUCT(BlueprintType)
+struct FPinballLightShowTrack
+{
+	GENERATED_BODY()
+
+	FPinballLightShowTrack()
+		: LightDelay(0.0f)
+	{}
+
+	/** Names of the lights in the light bank, in the order the delay runs through them */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Track)
+	TArray<FName> LightNames;
+
+	/** Seconds between the keyframes of a light and those of the next one, for chases */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Track)
+	float LightDelay;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Track)
+	TArray<FPinballLightShowKeyframe> Keyframes;
+};
+
+/** A light show as authored, compiled against a light bank before being played */
+UCLASS(BlueprintType)
+class PINBALL_API UPinballLightShow : public UDataAsset
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Seconds before the show ends or loops, the time of its last keyframe if that is later */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = LightShow)
+	float Duration;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = LightShow)
+	TArray<FPinballLightShowTrack> Tracks;
+};
+
+/** Value a key sets its light to */
+struct FPinballLightShowValue
+{
+	FLinearColor Color;
+	float Intensity;
+	int32 LightIndex;
+	bool bOn;
+};
+
+/** A light show flattened into keys sorted by time, with light names resolved to light bank indices */
+struct PINBALL_API FPinballCompiledLightShow
+{
+	FPinballCompiledLightShow()
+		: Duration(0.0f)
+	{}
+
+	/** Time of each key, kept apart from the values so finding the keys due in a frame only reads times */
+	TArray<float> KeyTimes;
+
+	TArray<FPinballLightShowValue> KeyValues;
+
+	float Duration;
+
+	/**
+	 * Compiles a show for the lights of a bank, lights the bank doesn't have are skipped
+	 * @return	Number of light names that weren't found
+	 */
+	static int32 Compile(const UPinballLightShow& Show, const UPinballLightBankComponent& LightBank, FPinballCompiledLightShow& OutCompiledShow);
+};
+
+/** Plays compiled light shows, all the active shows being evaluated in one loop per frame */
+class PINBALL_API FPinballLightSequencer
+{
+public:
+	FPinballLightSequencer()
+		: NextHandle(0)
+	{}
+
+	/** Starts a show, returns a handle to stop it with */
+	int32 Play(const TSharedRef<const FPinballCompiledLightShow>& Show, bool bLoop, float PlayRate = 1.0f);
+
+	void Stop(int32 Handle);
+
+	void StopAll()
+	{
+		ActiveShows.Reset();
+	}
+
+	bool IsPlaying(int32 Handle) const;
+
+	int32 GetNumActiveShows() const
+	{
+		return ActiveShows.Num();
+	}
+
+	/**
+	 * Advances every active show and sets the lights of the keys that became due, shows played later override earlier ones on the same frame
+	 * @return	Number of keys applied
+	 */
+	int32 Advance(float DeltaTime, UPinballLightBankComponent& LightBank);
+
+private:
+	struct FActiveShow
+	{
+		TSharedRef<const FPinballCompiledLightShow> Show;
+		float Time;
+		float PlayRate;
+		/** Next key to apply */
+		int32 Cursor;
+		int32 Handle;
+		bool bLoop;
+	};
+
+	/** In the order they were played */
+	TArray<FActiveShow> ActiveShows;
+
+	int32 NextHandle;
+};
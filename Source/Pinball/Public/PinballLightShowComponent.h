@@ -0,0 +1,53 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "UObject/ObjectKey.h"
+#include "PinballLightShow.h"
+#include "PinballLightShowComponent.generated.h"
+
+class UPinballLightBankComponent;
+
+/** Plays light shows on a light bank, replacing light effects made of per light delays and timers */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballLightShowComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Bank the shows play on, the first one of the owner if not set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = LightShow)
+	UPinballLightBankComponent* LightBank;
+
+	/**
+	 * Starts a show, compiled for the light bank the first time it is played
+	 * @return	Handle to stop the show with, or INDEX_NONE if there is no light bank
+	 */
+	UFUNCTION(BlueprintCallable, Category = LightShow)
+	int32 PlayLightShow(UPinballLightShow* Show, bool bLoop = false, float PlayRate = 1.0f);
+
+	UFUNCTION(BlueprintCallable, Category = LightShow)
+	void StopLightShow(int32 Handle);
+
+	UFUNCTION(BlueprintCallable, Category = LightShow)
+	void StopAllLightShows();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = LightShow)
+	bool IsLightShowPlaying(int32 Handle) const;
+
+	//~ Begin UActorComponent Interface
+	virtual void OnRegister() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+private:
+	FPinballLightSequencer Sequencer;
+
+	/** Shows compiled for the light bank */
+	TMap<TObjectKey<UPinballLightShow>, TSharedRef<const FPinballCompiledLightShow>> CompiledShows;
+
+	/** Bank the shows were compiled for */
+	TWeakObjectPtr<UPinballLightBankComponent> CompiledLightBank;
+};
@@ -0,0 +1,154 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "PinballPartBatchActor.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UPrimitiveComponent;
+class UStaticMeshComponent;
+
+/** Per instance custom data floats of batched parts, read in the part materials with PerInstanceCustomData */
+namespace EPinballPartCustomData
+{
+	enum Type
+	{
+		ColorR,
+		ColorG,
+		ColorB,
+		State,
+		Num
+	};
+}
+
+/** One instance of a batched part */
+USTRUCT()
+struct FPinballPartInstance
+{
+	GENERATED_BODY()
+
+	FPinballPartInstance()
+		: ComponentIndex(INDEX_NONE)
+		, InstanceIndex(INDEX_NONE)
+	{}
+
+	/** Index in PartComponents */
+	UPROPERTY(VisibleAnywhere, Category = Part)
+	int32 ComponentIndex;
+
+	UPROPERTY(VisibleAnywhere, Category = Part)
+	int32 InstanceIndex;
+};
+
+/** A table part that used to be its own actor, now one instance per static mesh it was made of */
+USTRUCT()
+struct FPinballBatchedPart
+{
+	GENERATED_BODY()
+
+	/** Label of the actor the part came from */
+	UPROPERTY(VisibleAnywhere, Category = Part)
+	FName Name;
+
+	/** Tags of the actor the part came from */
+	UPROPERTY(VisibleAnywhere, Category = Part)
+	TArray<FName> Tags;
+
+	UPROPERTY(VisibleAnywhere, Category = Part)
+	TArray<FPinballPartInstance> Instances;
+};
+
+/** Estimate of what a world draws, every visible mesh section is one draw call and instanced components draw each section once */
+struct FPinballDrawCallStats
+{
+	FPinballDrawCallStats()
+		: NumPrimitives(0)
+		, NumInstances(0)
+		, NumDrawCalls(0)
+	{}
+
+	int32 NumPrimitives;
+	int32 NumInstances;
+	int32 NumDrawCalls;
+};
+
+/**
+ * Draws many identical static table parts, such as posts, rails and indicator lights, with one hierarchical instanced static mesh per mesh and material set
+ * Parts are still addressed one by one, by name, tag or the instance hit, and have per instance custom data for their colour and state
+ */
+UCLASS()
+class PINBALL_API APinballPartBatchActor : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** One component per distinct static mesh, materials and collision */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Parts)
+	TArray<UHierarchicalInstancedStaticMeshComponent*> PartComponents;
+
+	UPROPERTY(VisibleAnywhere, Category = Parts)
+	TArray<FPinballBatchedPart> Parts;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Parts)
+	int32 GetNumParts() const
+	{
+		return Parts.Num();
+	}
+
+	/** Index of the part made from the actor with this label, or INDEX_NONE */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Parts)
+	int32 FindPart(FName PartName) const;
+
+	/** Indices of the parts made from actors with this tag */
+	UFUNCTION(BlueprintCallable, Category = Parts)
+	void FindPartsWithTag(FName Tag, TArray<int32>& OutPartIndices) const;
+
+	/** Index of the part an instance belongs to, for example from the component and item of a hit result, or INDEX_NONE */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Parts)
+	int32 FindPartByInstance(const UPrimitiveComponent* Component, int32 InstanceIndex) const;
+
+	/** World transform of the first instance of a part */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Parts)
+	FTransform GetPartTransform(int32 PartIndex) const;
+
+	/**
+	* Sets one custom data float on every instance of a part
+	* Pass false for bMarkRenderStateDirty when setting several values in a row, and call MarkPartsRenderStateDirty once at the end
+	*/
+	UFUNCTION(BlueprintCallable, Category = Parts)
+	void SetPartCustomData(int32 PartIndex, int32 CustomDataIndex, float Value, bool bMarkRenderStateDirty = true);
+
+	UFUNCTION(BlueprintCallable, Category = Parts)
+	void SetPartColor(int32 PartIndex, FLinearColor Color, bool bMarkRenderStateDirty = true);
+
+	UFUNCTION(BlueprintCallable, Category = Parts)
+	void SetPartState(int32 PartIndex, float State, bool bMarkRenderStateDirty = true);
+
+	/** Sends the custom data changed without marking the render state dirty to the renderer */
+	UFUNCTION(BlueprintCallable, Category = Parts)
+	void MarkPartsRenderStateDirty();
+
+#if WITH_EDITOR
+	/**
+	* Adds a part made of static mesh components to the batch, each becomes an instance with the same world transform
+	* Meshes are added to the component with the same mesh, materials and collision, or a new one
+	* @return	Index of the new part
+	*/
+	int32 AddPart(FName PartName, const TArray<FName>& PartTags, const TArray<UStaticMeshComponent*>& MeshComponents);
+#endif
+
+	/** Estimates the draw calls of every visible primitive in a world */
+	static FPinballDrawCallStats EstimateDrawCalls(const UWorld* World);
+
+private:
+	/** Finds or adds the part component for a static mesh component */
+	UHierarchicalInstancedStaticMeshComponent* FindOrAddPartComponent(const UStaticMeshComponent* MeshComponent, int32& OutComponentIndex);
+
+	/** Fills InstanceParts from Parts, if it is out of date */
+	void UpdateInstancePartLookup() const;
+
+	/** Part of each instance of each part component, built from Parts when first needed */
+	mutable TArray<TArray<int32>> InstanceParts;
+};
@@ -0,0 +1,88 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "PinballRuleEngine.h"
+#include "PinballRuleComponent.generated.h"
+
+struct FPinballHitEvent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FPinballRuleFiredSignature, FName, Mode, FName, FromState, FName, ToState, FName, Reward);
+
+/**
+ * Runs the special modes of the table from a DataTable of rules
+ * Hits from the game mode event bus are posted as the name of their hit type, and as the first tag of the element hit the rules listen to
+ * Events are resolved once a frame after the hits are drained, time limits running out first, the same order recorded streams are replayed in
+ */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballRuleComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** DataTable of FPinballRuleRow */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rules)
+	class UDataTable* RuleTable;
+
+	/** Whether the events posted during play are saved to Saved/RuleEvents, for Pinball.ReplayRuleEvents */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Rules)
+	bool bRecordEvents;
+
+	/** Called once a frame for each rule that fired, after its score reward went to the game mode */
+	UPROPERTY(BlueprintAssignable, Category = Rules)
+	FPinballRuleFiredSignature OnRuleFired;
+
+	/** Queues an event, its rules fire on the next update of the rules, this frame if the component hasn't ticked yet */
+	UFUNCTION(BlueprintCallable, Category = Rules)
+	void PostRuleEvent(FName Event);
+
+	/** State a mode is in, None when it isn't running */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Rules)
+	FName GetModeState(FName Mode) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Rules)
+	bool IsModeRunning(FName Mode) const
+	{
+		return !GetModeState(Mode).IsNone();
+	}
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Rules)
+	float GetModeTimeRemaining(FName Mode) const;
+
+	//~ Begin UActorComponent Interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+private:
+	void OnHitEvents(TArrayView<const FPinballHitEvent> Events);
+
+	/** Queues an event by index for the next update */
+	void PostRuleEventIndex(int32 EventIndex);
+
+	/** Rule event of an element hit, INDEX_NONE if the rules don't listen to it */
+	int32 GetElementEvent(int32 ElementId);
+
+	FPinballRuleEngine RuleEngine;
+
+	/** Rule event of each registered element, cached the first time it is hit */
+	TArray<int32> ElementEvents;
+
+	/** Rule event of each hit type */
+	TArray<int32> HitTypeEvents;
+
+	/** Events posted since the last update */
+	TArray<int32> PendingEvents;
+
+	TArray<FPinballRuleFiring> Firings;
+
+	TArray<FPinballRecordedRuleEvent> RecordedEvents;
+
+	FDelegateHandle HitEventsHandle;
+
+	/** World time the rules started at, rule time being from then */
+	float StartTime;
+};
@@ -0,0 +1,244 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "PinballRuleEngine.generated.h"
+
+/**
+ * One transition of a special mode, a DataTable of these defines every mode of the table
+ * A mode isn't running while in the None state, so rules from None start it and rules to None end it
+ */
+USTRUCT(BlueprintType)
+struct FPinballRuleRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	FPinballRuleRow()
+		: Count(1)
+		, TimeLimit(0.0f)
+		, ScoreReward(0)
+	{}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	FName Mode;
+
+	/** State of the mode the rule applies in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	FName FromState;
+
+	/** Event that fires the rule, Timeout for the time limit of FromState running out */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	FName Event;
+
+	/** Times the event has to happen while the mode is in FromState for the rule to fire */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule, meta = (ClampMin = "1"))
+	int32 Count;
+
+	/** Other mode that has to be in RequiredState for the rule to fire, None for no condition */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	FName RequiredMode;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	FName RequiredState;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	FName ToState;
+
+	/** Seconds the mode can stay in ToState before its Timeout event, 0 for no limit */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule, meta = (ClampMin = "0"))
+	float TimeLimit;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	int32 ScoreReward;
+
+	/** Reward gameplay gives when the rule fires, such as ExtraBall or BallSave, also posted as an event for other rules */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rule)
+	FName Reward;
+};
+
+/** A rule that fired, for gameplay to hand out its rewards */
+struct FPinballRuleFiring
+{
+	FName RuleName;
+	FName Mode;
+	FName FromState;
+	FName ToState;
+	FName Reward;
+	int32 ScoreReward;
+};
+
+/** An event of a recorded stream, Time being seconds from the start of the game */
+struct FPinballRecordedRuleEvent
+{
+	float Time;
+	FName Event;
+};
+
+/**
+ * Special modes compiled from a DataTable of rules into a flat transition table
+ * Transitions are grouped by event, so an event only visits the rules listening to it however many modes there are
+ * Time limits are deadlines in game time, a state entered on a timeout has its time limit from when the previous one ran out,
+ * so the same events at the same times fire the same rules however often the engine is updated in between
+ */
+class PINBALL_API FPinballRuleEngine
+{
+public:
+	FPinballRuleEngine()
+		: TimeoutEvent(INDEX_NONE)
+		, CurrentTime(0.0f)
+		, EventTime(0.0f)
+		, EventSerial(0)
+	{}
+
+	/** Compiles the rules of a DataTable of FPinballRuleRow and resets every mode, returns false if the table isn't one */
+	bool Compile(const UDataTable& RuleTable);
+
+	/** Puts every mode back in the None state, at time 0 */
+	void Reset();
+
+	/** Index of an event the rules listen to, or INDEX_NONE if none do, to post events without looking their name up */
+	int32 FindEvent(FName EventName) const
+	{
+		const int32* EventIndex = EventIndices.Find(EventName);
+		return (EventIndex != nullptr) ? *EventIndex : INDEX_NONE;
+	}
+
+	FName GetEventName(int32 EventIndex) const
+	{
+		return EventNames.IsValidIndex(EventIndex) ? EventNames[EventIndex] : NAME_None;
+	}
+
+	/** Fires the rules listening to an event whose conditions hold, returns the number of rules fired */
+	int32 PostEvent(int32 EventIndex);
+
+	int32 PostEvent(FName EventName)
+	{
+		return PostEvent(FindEvent(EventName));
+	}
+
+	/**
+	 * Moves to a game time, posting Timeout to the modes whose time ran out by then in the order they did, then posts the events that happened at that time
+	 * Games and replays both go through this, so a time limit running out on the frame of an event is resolved the same way in both
+	 * @return	Number of rules fired
+	 */
+	int32 Update(float Time, TArrayView<const int32> EventIndices);
+
+	/** Appends the rules fired since the last call to OutFirings and forgets them */
+	void ConsumeFirings(TArray<FPinballRuleFiring>& OutFirings);
+
+	int32 FindMode(FName ModeName) const
+	{
+		return ModeNames.IndexOfByKey(ModeName);
+	}
+
+	int32 GetNumModes() const
+	{
+		return ModeNames.Num();
+	}
+
+	int32 GetNumRules() const
+	{
+		return Transitions.Num();
+	}
+
+	FName GetModeName(int32 ModeIndex) const
+	{
+		return ModeNames.IsValidIndex(ModeIndex) ? ModeNames[ModeIndex] : NAME_None;
+	}
+
+	/** State a mode is in, None when it isn't running */
+	FName GetModeState(int32 ModeIndex) const
+	{
+		return ModeNames.IsValidIndex(ModeIndex) ? ModeStateNames[ModeIndex][ModeStates[ModeIndex]] : NAME_None;
+	}
+
+	/** Seconds before the Timeout event of a mode, 0 if its state has no time limit */
+	float GetModeTimeRemaining(int32 ModeIndex) const
+	{
+		return TimedModes.Contains(ModeIndex) ? FMath::Max(ModeDeadlines[ModeIndex] - CurrentTime, 0.0f) : 0.0f;
+	}
+
+	float GetTime() const
+	{
+		return CurrentTime;
+	}
+
+	/** Reads a stream of events, one "Time Event" line each, sorted by time, events at the same time being posted in the same update */
+	static bool LoadEventStream(const FString& Filename, TArray<FPinballRecordedRuleEvent>& OutEvents);
+
+	static bool SaveEventStream(const FString& Filename, const TArray<FPinballRecordedRuleEvent>& Events);
+
+private:
+	struct FTransition
+	{
+		FName RuleName;
+		FName Reward;
+		int32 Mode;
+		int32 FromState;
+		int32 ToState;
+		int32 Count;
+		int32 RequiredMode;
+		int32 RequiredState;
+		int32 RewardEvent;
+		int32 ScoreReward;
+		float TimeLimit;
+	};
+
+	/** Fires the rules of an event, only those of one mode for its timeout */
+	int32 ProcessEvent(int32 EventIndex, int32 OnlyMode);
+
+	/** Fires the rules of the reward events posted by the rules that just fired */
+	int32 ProcessPendingEvents();
+
+	/** Index of a state of a mode, added if new */
+	static int32 FindOrAddState(TArray<FName>& StateNames, FName StateName);
+
+	int32 FindOrAddEvent(FName EventName);
+
+	/** Transitions sorted by event, those of event N being from EventFirstTransition[N] to EventFirstTransition[N + 1] */
+	TArray<FTransition> Transitions;
+	TArray<int32> EventFirstTransition;
+
+	/** Transitions of each mode, whose counts are reset when the mode changes state */
+	TArray<TArray<int32>> ModeTransitions;
+
+	TArray<FName> ModeNames;
+
+	/** Names of the states of each mode, None first */
+	TArray<TArray<FName>> ModeStateNames;
+
+	TMap<FName, int32> EventIndices;
+	TArray<FName> EventNames;
+
+	int32 TimeoutEvent;
+
+	/** State of each mode */
+	TArray<int32> ModeStates;
+
+	/** Game time the time limit of each mode runs out at, while it is in TimedModes */
+	TArray<float> ModeDeadlines;
+
+	/** Game time of the last update */
+	float CurrentTime;
+
+	/** Game time of the event being processed, the deadline that ran out for timeouts */
+	float EventTime;
+
+	/** Event each mode last changed state on */
+	TArray<uint32> ModeEventSerials;
+
+	uint32 EventSerial;
+
+	/** Modes with a time limit running */
+	TArray<int32> TimedModes;
+
+	/** Times the event of each transition happened in its FromState */
+	TArray<int32> TransitionCounts;
+
+	/** Rewards posted as events, processed after the event that fired them */
+	TArray<int32> PendingEvents;
+
+	TArray<FPinballRuleFiring> Firings;
+};
@@ -0,0 +1,118 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "PinballScoreComponent.generated.h"
+
+/** A multiplier applied to every hit while it is on the stack, such as a lit 2X or a mode */
+USTRUCT(BlueprintType)
+struct FPinballScoreMultiplier
+{
+	GENERATED_BODY()
+
+	FPinballScoreMultiplier()
+		: Multiplier(1)
+	{}
+
+	/** What pushed the multiplier, used to remove it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Score)
+	FName Source;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Score)
+	int32 Multiplier;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPinballScoreChangedSignature, int64, NewScore, int64, ScoreDelta);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPinballMultiplierChangedSignature, int32, NewMultiplier);
+
+/**
+ * Keeps the score with 64 bit precision, hits being queued as they happen and resolved together at the end of the frame
+ * Parts use it like the Blueprint score component: RegisterScore on their own score component forwards the hit to the score component of the game mode
+ */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballScoreComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Broadcast at most once a frame, after the hits of the frame are resolved, when they changed the score */
+	UPROPERTY(BlueprintAssignable, Category = Score)
+	FPinballScoreChangedSignature OnScoreChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = Score)
+	FPinballMultiplierChangedSignature OnMultiplierChanged;
+
+	/** Scores a hit, multiplied by the multipliers on the stack when it happens */
+	UFUNCTION(BlueprintCallable, Category = Score)
+	void RegisterScore(int32 PointsToAdd);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Score)
+	int64 GetScore() const
+	{
+		return Score;
+	}
+
+	/** Sets the score back to 0 and drops the queued hits */
+	UFUNCTION(BlueprintCallable, Category = Score)
+	void ResetScore();
+
+	/** Pushes a multiplier, or changes it if its source already has one on the stack */
+	UFUNCTION(BlueprintCallable, Category = Score)
+	void PushMultiplier(FName Source, int32 Multiplier);
+
+	UFUNCTION(BlueprintCallable, Category = Score)
+	void RemoveMultiplier(FName Source);
+
+	UFUNCTION(BlueprintCallable, Category = Score)
+	void ClearMultipliers();
+
+	/** Product of the multipliers on the stack */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Score)
+	int32 GetMultiplier() const
+	{
+		return Multiplier;
+	}
+
+	/** Adds the queued hits to the score now, rather than at the end of the frame */
+	UFUNCTION(BlueprintCallable, Category = Score)
+	void ResolveHits();
+
+	/** Number of hits resolved since the score was reset */
+	int64 GetNumResolvedHits() const
+	{
+		return NumResolvedHits;
+	}
+
+	//~ Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+protected:
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Score)
+	int64 Score;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Score)
+	TArray<FPinballScoreMultiplier> Multipliers;
+
+private:
+	/** The score component hits are queued on, the one of the game mode if there is one */
+	UPinballScoreComponent* GetScoreOwner();
+
+	void UpdateMultiplier();
+
+	struct FQueuedHit
+	{
+		int32 Points;
+		int32 Multiplier;
+	};
+
+	TArray<FQueuedHit> QueuedHits;
+
+	TWeakObjectPtr<UPinballScoreComponent> ScoreOwner;
+
+	int64 NumResolvedHits;
+
+	int32 Multiplier;
+};
@@ -0,0 +1,44 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PinballHingeComponent.h"
+#include "PinballSpinnerComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPinballSpinSignature, int32, NumSpins);
+
+/** A spinner, turned by balls crossing it either way, posting a spinner event on the bus each time the flap goes over the top */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballSpinnerComponent : public UPinballHingeComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	/** Called once an update the flap went over the top, with the number of times it did */
+	UPROPERTY(BlueprintAssignable, Category = Spinner)
+	FPinballSpinSignature OnSpin;
+
+	/** Times the flap went over the top since play began */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Spinner)
+	int32 GetNumSpins() const
+	{
+		return NumSpins;
+	}
+
+	//~ Begin IPinballElementUpdater Interface
+	virtual void UpdateElement(float DeltaTime) override;
+	//~ End IPinballElementUpdater Interface
+
+protected:
+	//~ Begin UPinballHingeComponent Interface
+	virtual void OnBallCrossing(APinballBall* Ball, float CrossingSpeed) override;
+	virtual void OnStepped() override;
+	//~ End UPinballHingeComponent Interface
+
+private:
+	int32 NumSpins;
+
+	/** World time of each spin during the steps of the current update */
+	TArray<float, TInlineAllocator<4>> PendingSpinTimes;
+};
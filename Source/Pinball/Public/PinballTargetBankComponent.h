@@ -0,0 +1,120 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "PinballTargetBankComponent.generated.h"
+
+/** A set of targets, drop targets or lanes completed together, with the state of each target in one bit */
+USTRUCT(BlueprintType)
+struct FPinballTargetBank
+{
+	GENERATED_BODY()
+
+	FPinballTargetBank()
+		: NumTargets(0)
+		, bResetOnComplete(false)
+		, State(0)
+	{}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = TargetBank)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = TargetBank, meta = (ClampMin = "1", ClampMax = "64"))
+	int32 NumTargets;
+
+	/** Whether all the targets are cleared as soon as the bank is completed, like drop targets popping back up */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = TargetBank)
+	bool bResetOnComplete;
+
+	/** Bit N is set when target N is */
+	uint64 State;
+
+	/** Bits of the targets of the bank */
+	uint64 GetMask() const
+	{
+		return (NumTargets >= 64) ? ~uint64(0) : ((uint64(1) << FMath::Max(NumTargets, 0)) - 1);
+	}
+
+	/** Whether every target is set, a bank without targets, such as one just added in the editor, is never complete */
+	bool IsComplete() const
+	{
+		return NumTargets > 0 && State == GetMask();
+	}
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FPinballTargetBankChangedSignature, int32, BankIndex, int64, NewState, int64, ChangedTargets);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPinballTargetBankCompletedSignature, int32, BankIndex);
+
+/**
+ * Keeps the state of every target bank of the table as bitsets, so setting, clearing and checking completion never go through the targets
+ * Blueprints are only told about changes, once per operation that changes a bank
+ */
+UCLASS(ClassGroup = Pinball, meta = (BlueprintSpawnableComponent))
+class PINBALL_API UPinballTargetBankComponent : public UActorComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = TargetBank)
+	TArray<FPinballTargetBank> Banks;
+
+	/** Called when targets of a bank are set or cleared, ChangedTargets has a bit for each of them */
+	UPROPERTY(BlueprintAssignable, Category = TargetBank)
+	FPinballTargetBankChangedSignature OnBankChanged;
+
+	/** Called when the last target of a bank is set, before the bank is reset if it resets on completion */
+	UPROPERTY(BlueprintAssignable, Category = TargetBank)
+	FPinballTargetBankCompletedSignature OnBankCompleted;
+
+	/** Adds a bank of up to 64 targets, returns its index */
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	int32 AddBank(FName Name, int32 NumTargets, bool bResetOnComplete = false);
+
+	/** Index of the bank with this name, or INDEX_NONE */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = TargetBank)
+	int32 FindBank(FName Name) const;
+
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	void SetTarget(int32 BankIndex, int32 TargetIndex);
+
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	void ClearTarget(int32 BankIndex, int32 TargetIndex);
+
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	void ToggleTarget(int32 BankIndex, int32 TargetIndex);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = TargetBank)
+	bool IsTargetSet(int32 BankIndex, int32 TargetIndex) const;
+
+	/** Whether every target of the bank is set */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = TargetBank)
+	bool IsBankComplete(int32 BankIndex) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = TargetBank)
+	int32 GetNumSetTargets(int32 BankIndex) const;
+
+	/** Bit N is set when target N is */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = TargetBank)
+	int64 GetBankState(int32 BankIndex) const;
+
+	/** Sets the state of every target of a bank at once, bits past the targets of the bank are ignored */
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	void SetBankState(int32 BankIndex, int64 NewState);
+
+	/** Clears every target of a bank */
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	void ResetBank(int32 BankIndex);
+
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	void ResetAllBanks();
+
+	/** Moves the state of each target to the next one, the last wrapping around to the first, as flipper lane change does with lit lanes */
+	UFUNCTION(BlueprintCallable, Category = TargetBank)
+	void RotateBank(int32 BankIndex, int32 Steps = 1);
+
+private:
+	/** Sets the state of a bank and notifies the transition, if there is one */
+	void ChangeBankState(int32 BankIndex, uint64 NewState);
+};
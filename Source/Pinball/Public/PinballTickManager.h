@@ -0,0 +1,204 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "PinballTickManager.generated.h"
+
+/** How much an element matters to what the player sees, elements of lower significance are updated less often */
+UENUM(BlueprintType)
+enum class EPinballSignificance : uint8
+{
+	/** Near a ball or recently active, updated every frame */
+	High,
+	/** Updated every other frame */
+	Medium,
+	/** Far from every ball, updated every fourth frame */
+	Low,
+};
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class PINBALL_API UPinballElementUpdater : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/** A table element updated by the tick manager, instead of ticking on its own */
+class PINBALL_API IPinballElementUpdater
+{
+	GENERATED_BODY()
+
+public:
+	/** Called once a frame while the element is awake, along with every other awake element of its class */
+	virtual void UpdateElement(float DeltaTime) = 0;
+
+	/** Called when the significance of the element changes, for it to lower or restore the fidelity of its animation */
+	virtual void SetElementSignificance(EPinballSignificance Significance) {}
+};
+
+/** Update cost of the elements of one class */
+struct FPinballUpdaterStats
+{
+	const UClass* Class;
+	int32 NumElements;
+	int32 NumAwake;
+	/** Frames the class had awake elements in */
+	int64 NumUpdatedFrames;
+	int64 NumUpdates;
+	/** Updates skipped because the elements weren't significant enough */
+	int64 NumSkippedUpdates;
+	uint64 NumCycles;
+};
+
+/**
+ * Updates the registered table elements in one tick, class by class, so a table of hundreds of elements doesn't pay for hundreds of tick functions
+ * Sleeping elements aren't in the arrays that are updated at all, elements sleep when they have nothing to do and are woken by what wakes them, such as a hit
+ * Awake elements far from every ball and not active lately are updated less often, with the time of the skipped updates added to their next one
+ */
+UCLASS(config = Game)
+class PINBALL_API UPinballTickManager : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UPinballTickManager();
+
+	/** Whether elements are updated less often when they aren't significant */
+	UPROPERTY(Config)
+	bool bUseSignificance;
+
+	/** Elements closer than this to a ball are of high significance */
+	UPROPERTY(Config)
+	float NearDistance;
+
+	/** Elements closer than this to a ball are of medium significance, further ones of low significance */
+	UPROPERTY(Config)
+	float FarDistance;
+
+	/** Seconds an element stays of high significance after it was active */
+	UPROPERTY(Config)
+	float ActivitySeconds;
+
+	static UPinballTickManager* Get(const UWorld* World);
+
+	/** Adds an element, awake, it should be unregistered before it is destroyed, elements collected while registered are dropped */
+	void RegisterElement(UObject* Element);
+
+	void UnregisterElement(UObject* Element);
+
+	/** Stops updating an element until it is woken */
+	void SleepElement(UObject* Element);
+
+	void WakeElement(UObject* Element);
+
+	bool IsElementAwake(const UObject* Element) const;
+
+	/** Notes that something happened to an element, such as a hit, which makes it significant for a while and wakes it */
+	void NoteElementActivity(UObject* Element);
+
+	/** Significance of an element when it was last updated, High while asleep */
+	EPinballSignificance GetElementSignificance(const UObject* Element) const;
+
+	/** Fraction of the updates of the awake elements skipped last frame */
+	float GetSkippedUpdateFraction() const
+	{
+		return LastFrameSkippedFraction;
+	}
+
+	bool IsElementRegistered(const UObject* Element) const
+	{
+		return Elements.Contains(Element);
+	}
+
+	/** Cost of each class of element since the stats were reset */
+	void GetStats(TArray<FPinballUpdaterStats>& OutStats) const;
+
+	void ResetStats();
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+private:
+	struct FAwakeElement
+	{
+		/** Weak, the manager doesn't keep elements alive and skips the ones collected without being unregistered */
+		TWeakObjectPtr<UObject> Object;
+		IPinballElementUpdater* Updater;
+		/** Where the element was when it was woken, table elements don't move */
+		FVector Location;
+		/** Time since the last update, given to the next one */
+		float AccumulatedDeltaTime;
+		float LastActivityTime;
+		EPinballSignificance Significance;
+	};
+
+	/** Elements of one class, the awake ones packed at the front of the update order */
+	struct FUpdaterGroup
+	{
+		const UClass* Class;
+		TArray<FAwakeElement> AwakeElements;
+		int32 NumElements;
+		int64 NumUpdatedFrames;
+		int64 NumUpdates;
+		int64 NumSkippedUpdates;
+		uint64 NumCycles;
+	};
+
+	struct FElementHandle
+	{
+		int32 GroupIndex;
+		/** Index in the awake elements of the group, INDEX_NONE while asleep */
+		int32 AwakeIndex;
+	};
+
+	enum class EPendingChange : uint8
+	{
+		Register,
+		Sleep,
+		Wake,
+		Unregister,
+	};
+
+	void AddElement(UObject* Element);
+
+	void SetElementAwake(UObject* Element, bool bAwake);
+
+	/** Takes an awake element out of the update order of its group */
+	void RemoveAwakeElement(FElementHandle& Handle);
+
+	/** Significance of an element for the balls in play */
+	EPinballSignificance GetSignificance(const FAwakeElement& Element, TArrayView<const FVector> BallLocations, float Time) const;
+
+	void RemoveElement(const TWeakObjectPtr<const UObject>& Element);
+
+	/** Applies the changes made by elements while they were being updated */
+	void ApplyPendingChanges();
+
+	TArray<FUpdaterGroup> Groups;
+
+	TMap<TWeakObjectPtr<const UObject>, FElementHandle> Elements;
+
+	/** Whether elements are being updated, changes to the groups and their update arrays wait until they all are */
+	bool bUpdating;
+
+	TArray<TPair<TWeakObjectPtr<UObject>, EPendingChange>> PendingChanges;
+
+	int32 NumAwakeElements;
+
+	/** Staggers the updates of elements of lower significance over frames */
+	uint32 FrameCounter;
+
+	float LastFrameSkippedFraction;
+};
@@ -0,0 +1,38 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Polygon with holes, the outer boundary is counter clockwise and the holes are clockwise */
+struct FPolygonWithHoles
+{
+	TArray<FVector2D> Outer;
+	TArray<TArray<FVector2D>> Holes;
+};
+
+/**
+ * Boolean operations on simple polygons, used to merge overlapping wall outlines
+ */
+class PINBALL_API FPolygonClipping
+{
+public:
+	/**
+	 * Union of any number of polygons, in any winding order
+	 * Edges are split where they cross or overlap, and the pieces with the union on their left and nothing on their right are linked back into loops
+	 * Polygons that only touch at a corner stay separate
+	 */
+	static void Union(const TArray<TArray<FVector2D>>& Polygons, TArray<FPolygonWithHoles>& OutPolygons);
+
+	/**
+	 * Joins the holes of a polygon to its outer boundary with zero width bridges, so it can be used as a single polygon by TriangulatePoly
+	 * Each hole is bridged from its rightmost vertex to the closest vertex of the boundary it can see
+	 */
+	static void MakeKeyholePolygon(const FPolygonWithHoles& Polygon, TArray<FVector2D>& OutPolygon);
+
+	/** Removes the vertices of a closed polygon that are within Tolerance of a straight line between the vertices that are kept */
+	static void RemoveCollinearVertices(TArray<FVector2D>& Polygon, float Tolerance);
+
+	/** Whether the point is inside the polygon, using the non-zero winding rule */
+	static bool IsPointInPolygon(const FVector2D& Point, const TArray<FVector2D>& Polygon);
+};
@@ -4,11 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Components/SplineComponent.h"
 #include "SplineActor.generated.h"
 
-class USplineComponent;
 class USplineMeshComponent;
 
+/** Outcome of simplifying the points of a spline */
+struct FSplineSimplifyResult
+{
+	FSplineSimplifyResult()
+		: NumPointsBefore(0)
+		, NumPointsAfter(0)
+		, MaxError(0.0f)
+	{}
+
+	int32 NumPointsBefore;
+	int32 NumPointsAfter;
+
+	/** Largest distance between the original and the simplified spline */
+	float MaxError;
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class PINBALL_API ASplineActor : public AActor
 {
@@ -21,6 +37,9 @@ public:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called after the construction script, builds the spline mesh LODs from the spline meshes it made
+	virtual void OnConstruction(const FTransform& Transform) override;
+
 	virtual void PreInitializeComponents() override;
 	
 	/** Spline that represents our shape */
@@ -31,7 +50,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Spline)
 	USplineMeshComponent* AddPinballSplineMeshComponent(bool bManualAttachment, const FTransform& RelativeTransform, const UObject* ComponentTemplateContex);
 
-	/** Remove all previous spline meshes*/
+	/** Remove all previous spline meshes, including their LODs */
 	UFUNCTION(BlueprintCallable, Category = Spline)
 	void DestroyAllSplineMeshes();
 
@@ -47,7 +66,115 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Spline)
 	bool bResetSplineToDefault;
 
+	/**
+	* Screen sizes below which each coarser LOD of the spline meshes is drawn, from the most to the least detailed
+	* LOD N merges up to 2^N consecutive spline meshes into one, and never merges across a sharp corner
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline|LOD")
+	TArray<float> LODScreenSizes;
+
+	/** Triangles drawn at each LOD, LOD 0 being the spline meshes made by the construction script */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline|LOD")
+	TArray<int32> LODTriangleCounts;
+
+	/** Spline meshes drawn at each LOD */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline|LOD")
+	TArray<int32> LODSplineMeshCounts;
+
+	/** Spline meshes of the coarser LODs, made by BuildSplineMeshLODs */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spline|LOD")
+	TArray<USplineMeshComponent*> LODSplineMeshComponents;
+
+	/**
+	* Builds the coarser LODs of the spline meshes, done after every run of the construction script so the editor shows the LODs the game draws, and when play begins if there are none yet
+	* Each LOD is a separate set of spline meshes shown by draw distance, collision stays on the full detail spline meshes
+	*/
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void BuildSplineMeshLODs();
+
+	/** Removes the coarser LODs of the spline meshes, the full detail spline meshes are drawn at any distance again */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void DestroySplineMeshLODs();
+
+	/**
+	* Reads every point of the spline in a single pass, in local space
+	* Any of the output arrays may be null if the caller isn't interested in them
+	*/
+	void GetSplinePoints(TArray<FVector>* OutLocations, TArray<FVector>* OutArriveTangents, TArray<FVector>* OutLeaveTangents, TArray<ESplinePointType::Type>* OutTypes, TArray<FVector>* OutScales, TArray<FQuat>* OutRotations = nullptr) const;
+
+	/**
+	* Replaces all the points of the spline, in local space, and updates the spline once at the end
+	* Unlike adding the points one at a time with the SplineComponent functions, this doesn't re-parameterize the spline for every point
+	* Tangents are kept as given for CurveCustomTangent points, the other point types calculate their own when the spline is updated
+	* @param Scales	Scale of each point, may be empty in which case all points get a scale of 1
+	* @param Rotations	Rotation of each point, may be empty in which case points keep the rotation of the point at their index, new points get none
+	*/
+	void SetSplinePoints(const TArray<FVector>& Locations, const TArray<FVector>& Tangents, const TArray<ESplinePointType::Type>& Types, const TArray<FVector>& Scales, const TArray<FQuat>& Rotations = TArray<FQuat>());
+
+	/** Same as above, with separate arrive and leave tangents for each point */
+	void SetSplinePoints(const TArray<FVector>& Locations, const TArray<FVector>& ArriveTangents, const TArray<FVector>& LeaveTangents, const TArray<ESplinePointType::Type>& Types, const TArray<FVector>& Scales,
+		const TArray<FQuat>& Rotations = TArray<FQuat>());
+
+	/** Inserts points into the spline before InsertIndex, in local space, and updates the spline once at the end */
+	void InsertSplinePoints(int32 InsertIndex, const TArray<FVector>& Locations, const TArray<FVector>& Tangents, const TArray<ESplinePointType::Type>& Types);
+
+	/** Removes the points at the given indices from the spline and updates the spline once at the end */
+	void RemoveSplinePoints(const TArray<int32>& SplinePointIndices);
+
+	/** Replaces the spline points with the ones of our archetype, usually the blueprint default */
+	void ResetSplinePointsToDefault();
+
+	/**
+	* Removes as many spline points as possible while keeping the spline within Tolerance of its current shape, and updates the spline once at the end
+	* Kept points become CurveCustomTangent points, with their tangents rescaled to the segments they now span
+	*/
+	FSplineSimplifyResult SimplifySplinePoints(float Tolerance);
+
+	/**
+	* Replaces the points of this spline with the parallel offset of SourceSpline, which may be our own SplineComponent
+	* The offset is built in the local space of SourceSpline, positive distances offset outwards for closed loops and to the right for open splines
+	*/
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void SetSplinePointsFromOffset(const USplineComponent* SourceSpline, float Distance);
+
 #if WITH_EDITOR
 	virtual void PreEditUndo() override;
+
+	/**
+	* Starts a lightweight preview of spline point edits, used while dragging points in the editor
+	* Re-running the construction script is too slow to do every frame, so instead the existing spline meshes are bent to follow the spline
+	* Collision is disabled on previewed meshes, the construction script is expected to rebuild them when the edit is finished
+	*/
+	void BeginSplineMeshPreview();
+
+	/** Bends the spline meshes adjacent to the moved spline points to match the current spline */
+	void UpdateSplineMeshPreview(const TArray<int32>& MovedSplinePointIndices);
+
+	/** Ends the preview and restores collision on the previewed meshes */
+	void EndSplineMeshPreview();
+
+	/** Whether or not a spline mesh preview is in progress */
+	bool IsPreviewingSplineMeshes() const
+	{
+		return bPreviewingSplineMeshes;
+	}
+#endif
+
+protected:
+	/** Finds the input keys on SplineComponent where a spline mesh starts (X) and ends (Y) */
+	FVector2D FindSplineMeshInputKeys(const USplineMeshComponent* SplineMeshComponent) const;
+
+private:
+#if WITH_EDITORONLY_DATA
+	/** Spline input keys covered by each entry of SplineMeshComponents, captured when the preview started */
+	TArray<FVector2D> PreviewSplineMeshInputKeys;
+
+	/** Collision setting of each previewed spline mesh before we disabled it, ECollisionEnabled::NoCollision entries are untouched */
+	TArray<TEnumAsByte<ECollisionEnabled::Type>> PreviewSavedCollision;
+
+	/** Whether we have touched each spline mesh during the current preview */
+	TBitArray<> PreviewTouchedSplineMeshes;
+
+	bool bPreviewingSplineMeshes;
 #endif
 };
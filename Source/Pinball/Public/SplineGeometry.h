@@ -0,0 +1,70 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+
+/** Points of a hermite spline with explicit tangents, one key per point, in the local space of the spline */
+struct FSplineCurvePoints
+{
+	FSplineCurvePoints()
+		: bClosedLoop(false)
+	{}
+
+	TArray<FVector> Locations;
+	TArray<FVector> ArriveTangents;
+	TArray<FVector> LeaveTangents;
+	bool bClosedLoop;
+
+	int32 Num() const
+	{
+		return Locations.Num();
+	}
+
+	void Reset(int32 NewSize = 0)
+	{
+		Locations.Reset(NewSize);
+		ArriveTangents.Reset(NewSize);
+		LeaveTangents.Reset(NewSize);
+	}
+
+	void Add(const FVector& Location, const FVector& ArriveTangent, const FVector& LeaveTangent)
+	{
+		Locations.Add(Location);
+		ArriveTangents.Add(ArriveTangent);
+		LeaveTangents.Add(LeaveTangent);
+	}
+};
+
+/**
+ * Geometry operations on splines in their XY plane, used to build rails and wall outlines
+ */
+class PINBALL_API FSplineGeometry
+{
+public:
+	/**
+	 * Builds the parallel offset of a spline at Distance, in the XY plane
+	 * Positive distances offset outwards for closed loops, and to the right of the direction of travel for open splines
+	 * Sharp corners get a miter join, or a bevel when the miter would be too long, and the loops created by offsetting
+	 * inwards further than the radius of a curve are cut out
+	 */
+	static void OffsetSpline(const FInterpCurveVector& Curve, bool bClosedLoop, float Distance, FSplineCurvePoints& OutPoints);
+
+	/**
+	 * Builds a single polygon outlining a wall of the given thickness centered on the spline, ready for triangulation
+	 * Closed loops produce a ring, joined to its inner side by a zero width bridge so it stays one polygon
+	 * The polygon is counter clockwise
+	 */
+	static void MakeThickWallPolygon(const FInterpCurveVector& Curve, bool bClosedLoop, float Thickness, int32 SamplesPerSegment, TArray<FVector2D>& OutPolygon);
+
+	/** Samples a spline into a polyline in the XY plane, a closed loop doesn't repeat its first point at the end */
+	static void SampleSplinePoints(const FSplineCurvePoints& Points, int32 SamplesPerSegment, TArray<FVector2D>& OutSamples);
+
+	/** Area of a polygon, positive if it is counter clockwise */
+	static float GetSignedArea(const TArray<FVector2D>& Polygon);
+
+private:
+	/** Cuts out the parts of the spline between self intersections, keeping the rest of the curve exactly as it was */
+	static void RemoveSelfIntersections(FSplineCurvePoints& Points, int32 SamplesPerSegment);
+};
@@ -17,7 +17,8 @@ public class PinballEditor : ModuleRules
 			"RenderCore",
 			"Slate",
 			"SlateCore",
-			"EditorStyle"
+			"EditorStyle",
+			"DesktopPlatform"
 		}
 		);
 
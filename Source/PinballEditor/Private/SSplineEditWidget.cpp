@@ -4,11 +4,24 @@
 #include "SplineActor.h"
 #include "Components/SplineComponent.h"
 #include "ScopedTransaction.h"
+#include "SplinePointsChange.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
 #include "Classes/EditorStyleSettings.h"
+#include "HAL/IConsoleManager.h"
 
 
 #define LOCTEXT_NAMESPACE "SSplineEditWidget"
 
+DEFINE_LOG_CATEGORY_STATIC(LogSplineEditWidget, Log, All);
+
+static TAutoConsoleVariable<float> CVarSplineEditMaxRedrawsPerSecond(
+	TEXT("Pinball.SplineEditMaxRedrawsPerSecond"),
+	60.0f,
+	TEXT("Most times a second the level viewports are redrawn while dragging spline points in the spline edit widget, unlimited if not positive. Defaults to a typical display refresh rate."),
+	ECVF_Default);
 
 namespace SSplineEditWidgetDefs
 {
@@ -28,6 +41,11 @@ namespace SSplineEditWidgetDefs
 	const float SplineHoverTolerance = 5.0f;// 2.0f;
 	const float WireThickness = 5.0f;
 
+	/** Default and range of the distance simplifying a spline may move it, in unreal units */
+	const float DefaultSimplifyTolerance = 1.0f;
+	const float MinSimplifyTolerance = 0.01f;
+	const float MaxSimplifyTolerance = 100.0f;
+
 	/** Blend color for spline points that are currently selected by the user */
 	const FLinearColor& GetSplinePointSelectionColor()
 	{
@@ -45,6 +63,10 @@ namespace SSplineEditWidgetDefs
 
 	/** Blend color for splines that the user is NOT hovering over with the mouse */
 	const FLinearColor SplineColor = FColor::White;
+
+	/** Color and thickness for the splines of other selected actors */
+	const FLinearColor OverlaySplineColor = FLinearColor(1.0f, 1.0f, 1.0f, 0.35f);
+	const float OverlaySplineThickness = 2.0f;
 }
 
 // Types of spline point that are useful for pinball spline actors
@@ -58,6 +80,14 @@ void SSplineEditWidget::Construct( const FArguments& InArgs )
 {
 	SplineActor = InArgs._SplineActor.Get();
 
+	for (ASplineActor* OverlaySplineActor : InArgs._OverlaySplineActors)
+	{
+		if (OverlaySplineActor != nullptr && OverlaySplineActor != SplineActor)
+		{
+			OverlaySplineActors.Add(OverlaySplineActor);
+		}
+	}
+
 	// Start with default zoom of 1
 	ZoomFactor = FVector2D(1,1);
 
@@ -85,6 +115,10 @@ void SSplineEditWidget::Construct( const FArguments& InArgs )
 	bPanningWithMouse = false;
 	DragPointDistance = 0.0f;
 	MousePanDistance = 0.0f;
+	bPendingDragChangeNotification = false;
+	bPendingViewportRedraw = false;
+	LastViewportRedrawTime = 0.0;
+	SimplifyTolerance = SSplineEditWidgetDefs::DefaultSimplifyTolerance;
 
 	// Register to be notified when properties are edited
 	FCoreUObjectDelegates::FOnObjectPropertyChanged::FDelegate OnPropertyChangedDelegate = FCoreUObjectDelegates::FOnObjectPropertyChanged::FDelegate::CreateRaw(this, &SSplineEditWidget::OnPropertyChanged);
@@ -97,117 +131,245 @@ SSplineEditWidget::~SSplineEditWidget()
 	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnPropertyChangedHandle);
 }
 
+void SSplineEditWidget::SetSimplifyTolerance(float NewTolerance)
+{
+	SimplifyTolerance = FMath::Clamp(NewTolerance, SSplineEditWidgetDefs::MinSimplifyTolerance, SSplineEditWidgetDefs::MaxSimplifyTolerance);
+}
+
+void SSplineEditWidget::SimplifySpline()
+{
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
+	{
+		return;
+	}
+
+	TArray<ASplineActor*> SplineActorsToSimplify;
+	SplineActorsToSimplify.Add(SplineActor);
+	SimplifySplines(SplineActorsToSimplify, SimplifyTolerance);
+
+	// Point indices don't match anymore
+	ClearSelectedSplinePointIndices();
+
+	GEditor->RedrawLevelEditingViewports(true);
+
+	Rebuild2dSplineData(false, false);
+}
+
+void SSplineEditWidget::SimplifySplines(const TArray<ASplineActor*>& SplineActorsToSimplify, float Tolerance)
+{
+	const FScopedTransaction Transaction(LOCTEXT("SimplifySpline", "Simplify Spline"));
+
+	FSplineSimplifyResult TotalResult;
+	for (ASplineActor* SplineActorToSimplify : SplineActorsToSimplify)
+	{
+		if (SplineActorToSimplify == nullptr || SplineActorToSimplify->SplineComponent == nullptr)
+		{
+			continue;
+		}
+
+		FSplineSimplifyResult Result;
+		{
+			const FScopedSplinePointsChange SplinePointsChange(SplineActorToSimplify);
+			Result = SplineActorToSimplify->SimplifySplinePoints(Tolerance);
+		}
+
+		// Notify of change so any ConstructionScript is re-run, within the transaction like the other spline edits
+		SplineActorToSimplify->PostEditMove(false);
+
+		TotalResult.NumPointsBefore += Result.NumPointsBefore;
+		TotalResult.NumPointsAfter += Result.NumPointsAfter;
+		TotalResult.MaxError = FMath::Max(TotalResult.MaxError, Result.MaxError);
+
+		UE_LOG(LogSplineEditWidget, Log, TEXT("Simplified %s from %d to %d spline points, max error %.3f (tolerance %.3f)"),
+			*SplineActorToSimplify->GetName(), Result.NumPointsBefore, Result.NumPointsAfter, Result.MaxError, Tolerance);
+	}
+
+	FFormatNamedArguments Arguments;
+	Arguments.Add(TEXT("NumPointsBefore"), TotalResult.NumPointsBefore);
+	Arguments.Add(TEXT("NumPointsAfter"), TotalResult.NumPointsAfter);
+	Arguments.Add(TEXT("MaxError"), FText::AsNumber(TotalResult.MaxError));
+	FNotificationInfo Info(FText::Format(LOCTEXT("SimplifySplineResult", "Simplified spline from {NumPointsBefore} to {NumPointsAfter} points, max error {MaxError}"), Arguments));
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
 void SSplineEditWidget::Rebuild2dSplineData(bool bRecalculatePositionOffset, bool bRecalcuateZoomFactor)
 {
-	if (SplineActor != nullptr)
+	ESplineDataRebuildFlags RebuildFlags = ESplineDataRebuildFlags::SplineData | ESplineDataRebuildFlags::Projection;
+	if (bRecalculatePositionOffset)
+	{
+		RebuildFlags |= ESplineDataRebuildFlags::PositionOffset;
+	}
+	if (bRecalcuateZoomFactor)
+	{
+		RebuildFlags |= ESplineDataRebuildFlags::ZoomFactor;
+	}
+
+	Rebuild2dSplineData(RebuildFlags);
+}
+
+void SSplineEditWidget::Rebuild2dSplineData(ESplineDataRebuildFlags RebuildFlags)
+{
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
 	{
-		int32 SplinePointCount = SplineActor->SplineComponent->GetNumberOfSplinePoints();
-		if (SplinePointCount != SplinePoints.Num())
+		return;
+	}
+
+	// Single pass over the raw curve data, this is the only place we read from the spline component
+	if (EnumHasAnyFlags(RebuildFlags, ESplineDataRebuildFlags::SplineData))
+	{
+		const FInterpCurveVector& PositionCurve = SplineActor->SplineComponent->SplineCurves.Position;
+		const int32 SplinePointCount = PositionCurve.Points.Num();
+
+		if (SplinePointCount != SplinePointDataCache.Num())
 		{
 			// Clear the list of selected points if the number of spline points changed
 			// Indices might have changed
 			ClearSelectedSplinePointIndices();
+		}
+
+		InvalidateSelectedSplinePointValues();
 
+		SplinePointDataCache.Locations.SetNumUninitialized(SplinePointCount);
+		SplinePointDataCache.Tangents.SetNumUninitialized(SplinePointCount);
+		SplinePointDataCache.Bounds = FBox2D(ForceInit);
+
+		for (int32 SplinePointIndex = 0; SplinePointIndex < SplinePointCount; ++SplinePointIndex)
+		{
+			const FInterpCurvePoint<FVector>& CurvePoint = PositionCurve.Points[SplinePointIndex];
+			SplinePointDataCache.Locations[SplinePointIndex] = CurvePoint.OutVal;
+			SplinePointDataCache.Tangents[SplinePointIndex] = CurvePoint.LeaveTangent;
+			SplinePointDataCache.Bounds += FVector2D(CurvePoint.OutVal.X, CurvePoint.OutVal.Y);
 		}
+	}
 
-		SplinePoints.Empty();
+	// Other selected splines are brought into the local space of the spline being edited, so they line up with it
+	if (EnumHasAnyFlags(RebuildFlags, ESplineDataRebuildFlags::SplineData))
+	{
+		OverlaySplines.Reset();
 
-		// Should we auto-set the appropriate zoom level?
-		if (bRecalcuateZoomFactor)
+		const FTransform& SplineTransform = SplineActor->SplineComponent->GetComponentTransform();
+		for (const TWeakObjectPtr<ASplineActor>& OverlaySplineActorPtr : OverlaySplineActors)
 		{
-			// Find min and max points
-			float MinX = INT_MAX, MinY = INT_MAX;
-			float MaxX = INT_MIN, MaxY = INT_MIN;
-			for (int32 SplinePointIndex = 0; SplinePointIndex < SplinePointCount; ++SplinePointIndex)
+			const ASplineActor* OverlaySplineActor = OverlaySplineActorPtr.Get();
+			if (OverlaySplineActor == nullptr || OverlaySplineActor->SplineComponent == nullptr)
 			{
-				FVector SplinePointLocation = SplineActor->SplineComponent->GetLocationAtSplinePoint(SplinePointIndex, ESplineCoordinateSpace::Local);
-
-				MinX = FMath::Min(SplinePointLocation.X, MinX);
-				MinY = FMath::Min(SplinePointLocation.Y, MinY);
-				MaxX = FMath::Max(SplinePointLocation.X, MaxX);
-				MaxY = FMath::Max(SplinePointLocation.Y, MaxY);
+				continue;
 			}
 
-			float XSpan = MaxX - MinX;
-			float YSpan = MaxY - MinY;
+			const FTransform RelativeTransform = OverlaySplineActor->SplineComponent->GetComponentTransform().GetRelativeTransform(SplineTransform);
+			const FInterpCurveVector& PositionCurve = OverlaySplineActor->SplineComponent->SplineCurves.Position;
 
-			float RequiredXZoomFactor = 1;
-			float RequiredYZoomFactor = 1;
+			FSplineOverlay2D& OverlaySpline = OverlaySplines.AddDefaulted_GetRef();
+			OverlaySpline.bClosedLoop = OverlaySplineActor->SplineComponent->IsClosedLoop();
+			OverlaySpline.PointData.Locations.SetNumUninitialized(PositionCurve.Points.Num());
+			OverlaySpline.PointData.Tangents.SetNumUninitialized(PositionCurve.Points.Num());
 
-			// If too big in either x or y
-			if (XSpan > (SSplineEditWidgetDefs::WidgetWidth * 0.9) || YSpan > (SSplineEditWidgetDefs::WidgetHeight * 0.9f))
+			for (int32 SplinePointIndex = 0; SplinePointIndex < PositionCurve.Points.Num(); ++SplinePointIndex)
 			{
-				// Calculate how much we need to zoom out for each (zoom factor will be < 1)
-				RequiredXZoomFactor = (SSplineEditWidgetDefs::WidgetWidth * 0.9) / (XSpan + SSplineEditWidgetDefs::PointSize.X);
-				RequiredYZoomFactor = (SSplineEditWidgetDefs::WidgetHeight * 0.9f) / (YSpan + SSplineEditWidgetDefs::PointSize.Y);
-				
-				// Keep Zoom Factor the same in X & Y to avoid distortion, set it to the minimum (most zoomed out) of X and Y
-				float ResultZoomFactor = FMath::Min(RequiredXZoomFactor, RequiredYZoomFactor);
-				ZoomFactor = FVector2D(ResultZoomFactor, ResultZoomFactor);
+				const FInterpCurvePoint<FVector>& CurvePoint = PositionCurve.Points[SplinePointIndex];
+				const FVector SplinePointLocation = RelativeTransform.TransformPosition(CurvePoint.OutVal);
+				OverlaySpline.PointData.Locations[SplinePointIndex] = SplinePointLocation;
+				OverlaySpline.PointData.Tangents[SplinePointIndex] = RelativeTransform.TransformVector(CurvePoint.LeaveTangent);
+				OverlaySpline.PointData.Bounds += FVector2D(SplinePointLocation.X, SplinePointLocation.Y);
 			}
-			// Otherwise if x or y span is smaller than 1/4 of the widget size
-			else if (XSpan < SSplineEditWidgetDefs::WidgetWidth / 4 || YSpan < (SSplineEditWidgetDefs::WidgetHeight) / 4)
-			{
-				// Calculate the zoom necessary to make it 90% of the widget size
-				RequiredXZoomFactor = (SSplineEditWidgetDefs::WidgetWidth * 0.9f) / XSpan;
-				RequiredYZoomFactor = (SSplineEditWidgetDefs::WidgetHeight * 0.9f) / YSpan;
+		}
+	}
 
-				// Keep Zoom Factor the same in X & Y to avoid distortion, set it to the minimum (most zoomed out) of X and Y
-				float ResultZoomFactor = FMath::Min(RequiredXZoomFactor, RequiredYZoomFactor);
-				ZoomFactor = FVector2D(ResultZoomFactor, ResultZoomFactor);
-			}
+	const int32 SplinePointCount = SplinePointDataCache.Num();
 
-			// Enforce min and max zooms
-			ZoomFactor.X = FMath::Max(ZoomFactor.X, SSplineEditWidgetDefs::MinZoom);
-			ZoomFactor.Y = FMath::Max(ZoomFactor.Y, SSplineEditWidgetDefs::MinZoom);
-			ZoomFactor.X = FMath::Min(ZoomFactor.X, SSplineEditWidgetDefs::MaxZoom);
-			ZoomFactor.Y = FMath::Min(ZoomFactor.Y, SSplineEditWidgetDefs::MaxZoom);
+	// Zoom and offset should fit all the splines we draw
+	FBox2D Bounds = SplinePointDataCache.Bounds;
+	for (const FSplineOverlay2D& OverlaySpline : OverlaySplines)
+	{
+		if (OverlaySpline.PointData.Bounds.bIsValid)
+		{
+			Bounds += OverlaySpline.PointData.Bounds;
 		}
+	}
 
-		// Position offset depends on zoom, so calculate it after calculating zoom
-		if (bRecalculatePositionOffset)
-		{
-			PositionOffset = FVector2D(0.0f, 0.0f);
+	// Should we auto-set the appropriate zoom level?
+	if (EnumHasAnyFlags(RebuildFlags, ESplineDataRebuildFlags::ZoomFactor) && Bounds.bIsValid)
+	{
+		float XSpan = Bounds.Max.X - Bounds.Min.X;
+		float YSpan = Bounds.Max.Y - Bounds.Min.Y;
 
-			float MinX = INT_MAX, MinY = INT_MAX;
-			float MaxX = INT_MIN, MaxY = INT_MIN;
+		float RequiredXZoomFactor = 1;
+		float RequiredYZoomFactor = 1;
 
-			// Find center point of spline and of the widget itself
-			FVector2D SplineActorCenterPoint = FVector2D(0.0f, 0.0f);
-			FVector2D WidgetCenterPoint = FVector2D(SSplineEditWidgetDefs::WidgetWidth/2, SSplineEditWidgetDefs::WidgetHeight/2);
-			for (int32 SplinePointIndex = 0; SplinePointIndex < SplinePointCount; ++SplinePointIndex)
-			{
-				FVector SplinePointLocation = SplineActor->SplineComponent->GetLocationAtSplinePoint(SplinePointIndex, ESplineCoordinateSpace::Local);
+		// If too big in either x or y
+		if (XSpan > (SSplineEditWidgetDefs::WidgetWidth * 0.9) || YSpan > (SSplineEditWidgetDefs::WidgetHeight * 0.9f))
+		{
+			// Calculate how much we need to zoom out for each (zoom factor will be < 1)
+			RequiredXZoomFactor = (SSplineEditWidgetDefs::WidgetWidth * 0.9) / (XSpan + SSplineEditWidgetDefs::PointSize.X);
+			RequiredYZoomFactor = (SSplineEditWidgetDefs::WidgetHeight * 0.9f) / (YSpan + SSplineEditWidgetDefs::PointSize.Y);
+			
+			// Keep Zoom Factor the same in X & Y to avoid distortion, set it to the minimum (most zoomed out) of X and Y
+			float ResultZoomFactor = FMath::Min(RequiredXZoomFactor, RequiredYZoomFactor);
+			ZoomFactor = FVector2D(ResultZoomFactor, ResultZoomFactor);
+		}
+		// Otherwise if x or y span is smaller than 1/4 of the widget size
+		else if (XSpan < SSplineEditWidgetDefs::WidgetWidth / 4 || YSpan < (SSplineEditWidgetDefs::WidgetHeight) / 4)
+		{
+			// Calculate the zoom necessary to make it 90% of the widget size
+			RequiredXZoomFactor = (SSplineEditWidgetDefs::WidgetWidth * 0.9f) / XSpan;
+			RequiredYZoomFactor = (SSplineEditWidgetDefs::WidgetHeight * 0.9f) / YSpan;
 
-				MinX = FMath::Min(SplinePointLocation.X * ZoomFactor.X, MinX);
-				MinY = FMath::Min(SplinePointLocation.Y * ZoomFactor.Y, MinY);
-				MaxX = FMath::Max(SplinePointLocation.X * ZoomFactor.X, MaxX);
-				MaxY = FMath::Max(SplinePointLocation.Y * ZoomFactor.Y, MaxY);
-			}
+			// Keep Zoom Factor the same in X & Y to avoid distortion, set it to the minimum (most zoomed out) of X and Y
+			float ResultZoomFactor = FMath::Min(RequiredXZoomFactor, RequiredYZoomFactor);
+			ZoomFactor = FVector2D(ResultZoomFactor, ResultZoomFactor);
+		}
 
-			float HalfWidthX = (MaxX - MinX)/2;
-			float HalfHeightY = (MaxY - MinY)/2;
+		// Enforce min and max zooms
+		ZoomFactor.X = FMath::Max(ZoomFactor.X, SSplineEditWidgetDefs::MinZoom);
+		ZoomFactor.Y = FMath::Max(ZoomFactor.Y, SSplineEditWidgetDefs::MinZoom);
+		ZoomFactor.X = FMath::Min(ZoomFactor.X, SSplineEditWidgetDefs::MaxZoom);
+		ZoomFactor.Y = FMath::Min(ZoomFactor.Y, SSplineEditWidgetDefs::MaxZoom);
+	}
 
-			SplineActorCenterPoint.X = MinX + HalfWidthX;
-			SplineActorCenterPoint.Y = MinY + HalfHeightY;
+	// Position offset depends on zoom, so calculate it after calculating zoom
+	if (EnumHasAnyFlags(RebuildFlags, ESplineDataRebuildFlags::PositionOffset) && Bounds.bIsValid)
+	{
+		// Zoom is always positive, so the center of the zoomed points is the zoomed center of the bounds
+		const FVector2D SplineActorCenterPoint = Bounds.GetCenter() * ZoomFactor;
+		const FVector2D WidgetCenterPoint = FVector2D(SSplineEditWidgetDefs::WidgetWidth/2, SSplineEditWidgetDefs::WidgetHeight/2);
 
-			// This is the offset necessary to make the spline actor center point be the same as the widget center point
-			PositionOffset = WidgetCenterPoint - SplineActorCenterPoint - (SSplineEditWidgetDefs::PointSize / 2);
-		}
+		// This is the offset necessary to make the spline actor center point be the same as the widget center point
+		PositionOffset = WidgetCenterPoint - SplineActorCenterPoint - (SSplineEditWidgetDefs::PointSize / 2);
+	}
+
+	// Zoom or offset changes always need the points projected again
+	if (EnumHasAnyFlags(RebuildFlags, ESplineDataRebuildFlags::Projection | ESplineDataRebuildFlags::ZoomFactor | ESplineDataRebuildFlags::PositionOffset))
+	{
+		// Resized in place, so pointers into the array stay valid as long as the number of points doesn't change
+		SplinePoints.SetNum(SplinePointCount);
 
 		for (int32 SplinePointIndex = 0; SplinePointIndex < SplinePointCount; ++SplinePointIndex)
 		{
-			FVector SplinePointLocation = SplineActor->SplineComponent->GetLocationAtSplinePoint(SplinePointIndex, ESplineCoordinateSpace::Local);
-			FVector SplinePointDirection = SplineActor->SplineComponent->GetTangentAtSplinePoint(SplinePointIndex, ESplineCoordinateSpace::Local);
+			const FVector& SplinePointLocation = SplinePointDataCache.Locations[SplinePointIndex];
+			const FVector& SplinePointDirection = SplinePointDataCache.Tangents[SplinePointIndex];
 
 			// Spline point info represents our spline point in 2D
-			FSplinePoint2D NewSplinePoint;
+			FSplinePoint2D& NewSplinePoint = SplinePoints[SplinePointIndex];
 			// Zoom and offset are already reflected in the position stored here.  Then it can always be used as is.  Just have to remember about the offset when modifying
 			NewSplinePoint.Position = FVector2D((SplinePointLocation.X * ZoomFactor.X) + PositionOffset.X, (SplinePointLocation.Y * ZoomFactor.Y) + PositionOffset.Y);
 			// Zoom already reflected in the position stored here.  Then it can always be used as is.  Just have to remember about the offset when modifying
 			NewSplinePoint.Direction = FVector2D(SplinePointDirection.X * ZoomFactor.X, SplinePointDirection.Y * ZoomFactor.Y);
 			NewSplinePoint.Index = SplinePointIndex;
-			SplinePoints.Add(NewSplinePoint);
+		}
+
+		for (FSplineOverlay2D& OverlaySpline : OverlaySplines)
+		{
+			const int32 OverlayPointCount = OverlaySpline.PointData.Num();
+			OverlaySpline.Positions.SetNumUninitialized(OverlayPointCount);
+			OverlaySpline.Directions.SetNumUninitialized(OverlayPointCount);
+			for (int32 SplinePointIndex = 0; SplinePointIndex < OverlayPointCount; ++SplinePointIndex)
+			{
+				const FVector& SplinePointLocation = OverlaySpline.PointData.Locations[SplinePointIndex];
+				const FVector& SplinePointDirection = OverlaySpline.PointData.Tangents[SplinePointIndex];
+				OverlaySpline.Positions[SplinePointIndex] = FVector2D((SplinePointLocation.X * ZoomFactor.X) + PositionOffset.X, (SplinePointLocation.Y * ZoomFactor.Y) + PositionOffset.Y);
+				OverlaySpline.Directions[SplinePointIndex] = FVector2D(SplinePointDirection.X * ZoomFactor.X, SplinePointDirection.Y * ZoomFactor.Y);
+			}
 		}
 	}
 }
@@ -222,63 +384,87 @@ bool SSplineEditWidget::OnGetCanEditSelectedSplinePointLocationAndTangent() cons
 	return false;
 }
 
-TOptional<float> SSplineEditWidget::OnGetSelectedSplinePointLocation(EAxis::Type Axis) const
+const SSplineEditWidget::FSelectedSplinePointValues& SSplineEditWidget::GetSelectedSplinePointValues() const
 {
-	if (SelectedSplinePointIndices.Num() == 0)
+	if (SelectedSplinePointValues.FrameNumber == GFrameCounter)
 	{
-		return 0.0f;
+		return SelectedSplinePointValues;
 	}
 
-	// Some invalid default value
-	float NumericVal = -FLT_MAX;
+	SelectedSplinePointValues = FSelectedSplinePointValues();
+	SelectedSplinePointValues.FrameNumber = GFrameCounter;
 
-	if (Axis != EAxis::X && Axis != EAxis::Y)
-	{
-		// Unsupported axis
-		return NumericVal;
-	}
-
-	// Check everything that is currently selected
+	// Single pass over the selection, checking every axis at once against the cached point data
+	bool bFirstPoint = true;
+	bool bLocationMatches[2] = { true, true };
+	bool bTangentMatches[2] = { true, true };
+	FVector FirstLocation = FVector::ZeroVector;
+	FVector FirstTangent = FVector::ZeroVector;
 	for (int32 SelectedSplinePointIndex : SelectedSplinePointIndices)
 	{
-		if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < SplineActor->SplineComponent->GetNumberOfSplinePoints())
+		if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < SplinePointDataCache.Num())
 		{
-			FVector SplinePointPos = SplineActor->SplineComponent->GetLocationAtSplinePoint(SelectedSplinePointIndex, ESplineCoordinateSpace::Local);
-
-			float CurrentSplinePointValue = -FLT_MAX;
+			const FVector& SplinePointLocation = SplinePointDataCache.Locations[SelectedSplinePointIndex];
+			const FVector& SplinePointTangent = SplinePointDataCache.Tangents[SelectedSplinePointIndex];
 
-			switch (Axis)
+			if (bFirstPoint)
 			{
-			case EAxis::X:
-				CurrentSplinePointValue = SplinePointPos.X;
-				break;
-			case EAxis::Y:
-				CurrentSplinePointValue = SplinePointPos.Y;
-				break;
-			default:
-				break;
+				// First time this is set
+				bFirstPoint = false;
+				FirstLocation = SplinePointLocation;
+				FirstTangent = SplinePointTangent;
 			}
-
-			if (NumericVal == -FLT_MAX)
+			else
 			{
-				// First time this is set
-				NumericVal = CurrentSplinePointValue;
+				// Has been set before, check if it matches
+				for (int32 AxisIndex = 0; AxisIndex < 2; ++AxisIndex)
+				{
+					bLocationMatches[AxisIndex] &= (SplinePointLocation[AxisIndex] == FirstLocation[AxisIndex]);
+					bTangentMatches[AxisIndex] &= (SplinePointTangent[AxisIndex] == FirstTangent[AxisIndex]);
+				}
 			}
-			// Has been set before, and doesn't match
-			else if (NumericVal != CurrentSplinePointValue)
+		}
+	}
+
+	// Leave unset values where they don't match, so it displays the "multiple values" indicator instead
+	for (int32 AxisIndex = 0; AxisIndex < 2; ++AxisIndex)
+	{
+		if (SelectedSplinePointIndices.Num() == 0)
+		{
+			SelectedSplinePointValues.Location[AxisIndex] = 0.0f;
+			SelectedSplinePointValues.Tangent[AxisIndex] = 0.0f;
+		}
+		else if (!bFirstPoint)
+		{
+			if (bLocationMatches[AxisIndex])
 			{
-				// Return an unset value so it displays the "multiple values" indicator instead
-				return TOptional<float>();
+				SelectedSplinePointValues.Location[AxisIndex] = FirstLocation[AxisIndex];
 			}
-			else
+			if (bTangentMatches[AxisIndex])
 			{
-				// Multiple items selected, but they have the same value
+				SelectedSplinePointValues.Tangent[AxisIndex] = FirstTangent[AxisIndex];
 			}
 		}
+		else
+		{
+			// Some invalid default value
+			SelectedSplinePointValues.Location[AxisIndex] = -FLT_MAX;
+			SelectedSplinePointValues.Tangent[AxisIndex] = -FLT_MAX;
+		}
 	}
 
-	// Return an unset value so it displays the "multiple values" indicator instead
-	return NumericVal;
+	return SelectedSplinePointValues;
+}
+
+TOptional<float> SSplineEditWidget::OnGetSelectedSplinePointLocation(EAxis::Type Axis) const
+{
+	if (Axis != EAxis::X && Axis != EAxis::Y)
+	{
+		// Unsupported axis
+		return -FLT_MAX;
+	}
+
+	return GetSelectedSplinePointValues().Location[Axis == EAxis::X ? 0 : 1];
 }
 
 void SSplineEditWidget::OnSelectedSplinePointLocationChanged(float NewValue, EAxis::Type Axis)
@@ -294,11 +480,7 @@ void SSplineEditWidget::OnSelectedSplinePointLocationChanged(float NewValue, EAx
 		// Scoped transaction for the undo buffer
 		const FScopedTransaction Transaction(LOCTEXT("SetSplinePointPosition", "Set Spline Point(s) Position"));
 
-		SplineActor->SplineComponent->Modify();
-		if (AActor* Owner = SplineActor->SplineComponent->GetOwner())
-		{
-			Owner->Modify();
-		}
+		const FScopedSplinePointsChange SplinePointsChange(SplineActor);
 
 		// Move everything that is currently selected
 		for (int32 SelectedSplinePointIndex : SelectedSplinePointIndices)
@@ -342,61 +524,13 @@ void SSplineEditWidget::OnSelectedSplinePointLocationCommitted(float InNewValue,
 
 TOptional<float> SSplineEditWidget::OnGetSelectedSplinePointTangent(EAxis::Type Axis) const
 {
-	if (SelectedSplinePointIndices.Num() == 0)
-	{
-		return 0.0f;
-	}
-
-	// Some invalid default value
-	float NumericVal = -FLT_MAX;
-
 	if (Axis != EAxis::X && Axis != EAxis::Y)
 	{
 		// Unsupported axis
-		return NumericVal;
+		return -FLT_MAX;
 	}
 
-	// Check tangent for everything that is currently selected
-	for (int32 SelectedSplinePointIndex : SelectedSplinePointIndices)
-	{
-		if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < SplineActor->SplineComponent->GetNumberOfSplinePoints())
-		{
-			FVector SplinePointTangent = SplineActor->SplineComponent->GetTangentAtSplinePoint(SelectedSplinePointIndex, ESplineCoordinateSpace::Local);
-
-			float CurrentSplinePointValue = -FLT_MAX;
-
-			switch (Axis)
-			{
-			case EAxis::X:
-				CurrentSplinePointValue = SplinePointTangent.X;
-				break;
-			case EAxis::Y:
-				CurrentSplinePointValue = SplinePointTangent.Y;
-				break;
-			default:
-				break;
-			}
-
-			if (NumericVal == -FLT_MAX)
-			{
-				// First time this is set
-				NumericVal = CurrentSplinePointValue;
-			}
-			// Has been set before, and doesn't match
-			else if (NumericVal != CurrentSplinePointValue)
-			{
-				// Return an unset value so it displays the "multiple values" indicator instead
-				return TOptional<float>();
-			}
-			else
-			{
-				// Multiple items selected, but they have the same value
-			}
-		}
-	}
-
-	// Return an unset value so it displays the "multiple values" indicator instead
-	return NumericVal;
+	return GetSelectedSplinePointValues().Tangent[Axis == EAxis::X ? 0 : 1];
 }
 
 void SSplineEditWidget::OnSelectedSplinePointTangentChanged(float NewValue, EAxis::Type Axis)
@@ -412,11 +546,7 @@ void SSplineEditWidget::OnSelectedSplinePointTangentChanged(float NewValue, EAxi
 		// Scoped transaction for the undo buffer
 		const FScopedTransaction Transaction(LOCTEXT("SetSplinePointTangent", "Set Spline Point(s) Tangent"));
 
-		SplineActor->SplineComponent->Modify();
-		if (AActor* Owner = SplineActor->SplineComponent->GetOwner())
-		{
-			Owner->Modify();
-		}
+		const FScopedSplinePointsChange SplinePointsChange(SplineActor);
 
 		// Move everything that is currently selected
 		for (int32 SelectedSplinePointIndex : SelectedSplinePointIndices)
@@ -461,6 +591,17 @@ void SSplineEditWidget::OnPropertyChanged(UObject* ObjectBeingModified, FPropert
 {
 	if (SplineActor != nullptr && SplineActor->SplineComponent != nullptr)
 	{
+		// Changes to the other selected splines only need them redrawn
+		for (const TWeakObjectPtr<ASplineActor>& OverlaySplineActorPtr : OverlaySplineActors)
+		{
+			const ASplineActor* OverlaySplineActor = OverlaySplineActorPtr.Get();
+			if (OverlaySplineActor != nullptr && (ObjectBeingModified == OverlaySplineActor || ObjectBeingModified == OverlaySplineActor->SplineComponent))
+			{
+				Rebuild2dSplineData(ESplineDataRebuildFlags::SplineData | ESplineDataRebuildFlags::Projection);
+				return;
+			}
+		}
+
 		// Only care about changes to our spline actor and it's spline component
 		if (ObjectBeingModified == SplineActor || ObjectBeingModified == SplineActor->SplineComponent)
 		{
@@ -494,6 +635,29 @@ int32 SSplineEditWidget::OnPaint( const FPaintArgs& Args, const FGeometry& Allot
 			);
 	}
 
+	// Draw the splines of the other selected actors underneath, they are only for reference
+	++LayerId;
+	for (const FSplineOverlay2D& OverlaySpline : OverlaySplines)
+	{
+		const int32 OverlayPointCount = OverlaySpline.Positions.Num();
+		for (int32 SegmentIndex = OverlaySpline.bClosedLoop ? 0 : 1; OverlayPointCount > 1 && SegmentIndex < OverlayPointCount; ++SegmentIndex)
+		{
+			const int32 StartSplinePointIndex = (SegmentIndex == 0) ? OverlayPointCount - 1 : SegmentIndex - 1;
+
+			FSlateDrawElement::MakeSpline(
+				OutDrawElements,
+				LayerId,
+				AllottedGeometry.ToPaintGeometry(),
+				OverlaySpline.Positions[StartSplinePointIndex] + (SSplineEditWidgetDefs::PointSize * 0.5),
+				OverlaySpline.Directions[StartSplinePointIndex],
+				OverlaySpline.Positions[SegmentIndex] + (SSplineEditWidgetDefs::PointSize * 0.5),
+				OverlaySpline.Directions[SegmentIndex],
+				SSplineEditWidgetDefs::OverlaySplineThickness,
+				ESlateDrawEffect::None,
+				InWidgetStyle.GetColorAndOpacityTint() * SSplineEditWidgetDefs::OverlaySplineColor);
+		}
+	}
+
 	// Draw spline segments (lines)
 	for (int32 SegmentIndex = 0; SplinePoints.Num() > 1 && SegmentIndex < SplinePoints.Num(); ++SegmentIndex)
 	{
@@ -620,7 +784,7 @@ FReply SSplineEditWidget::OnMouseMove( const FGeometry& InMyGeometry, const FPoi
 		{
 			// Update our position offset and rebuild the 2D view
 			PositionOffset += InMouseEvent.GetCursorDelta();
-			Rebuild2dSplineData(false, false);
+			Rebuild2dSplineData(ESplineDataRebuildFlags::Projection);
 		}
 	}
 
@@ -636,16 +800,19 @@ FReply SSplineEditWidget::OnMouseMove( const FGeometry& InMyGeometry, const FPoi
 			if (!bStartedDrag)
 			{
 				bStartedDrag = true;
+				CurrentDragStats = FSplineDragStats();
 				if (GEditor && GEditor->Trans && !GEditor->bIsSimulatingInEditor)
 				{
 					// For Undo
 					FText SessionName = LOCTEXT("SplineEditWidgetMoveSplinePoint", "Move Spline Point");
 					GEditor->BeginTransaction(TEXT(""), SessionName, Cast<UObject>(SplineActor));
-					SplineActor->SplineComponent->Modify();
-					if (AActor* Owner = SplineActor->SplineComponent->GetOwner())
-					{
-						Owner->Modify();
-					}
+					DragSplinePointsChange = MakeUnique<FScopedSplinePointsChange>(SplineActor);
+				}
+
+				// Bend the existing meshes while dragging so the walls follow the edit, the construction script runs once on release
+				if (SplineActor->bUpdateSplineMeshes)
+				{
+					SplineActor->BeginSplineMeshPreview();
 				}
 
 				// If there is a current selection, can use shift or control to add to the selection (but not remove if we are starting a drag)
@@ -668,47 +835,60 @@ FReply SSplineEditWidget::OnMouseMove( const FGeometry& InMyGeometry, const FPoi
 				}
 			}
 
+			++CurrentDragStats.NumMouseMoveEvents;
+
 			// Move everything that is currently selected
+			// The spline is only updated once all points have moved, and the change notification and viewport redraw are deferred to Tick()
+			const int32 NumSplineComponentPoints = SplineActor->SplineComponent->GetNumberOfSplinePoints();
+			bool bMovedAnyPoint = false;
 			for (int32 SelectedSplinePointIndex : SelectedSplinePointIndices)
 			{
-				if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < SplineActor->SplineComponent->GetNumberOfSplinePoints())
+				if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < NumSplineComponentPoints)
 				{
 					FSplinePoint2D* CurrentSplinePoint = nullptr;
 
-					// Index in the array of SplinePoint2Ds doesn't necessarily match the index in the SplineComponent
-					for (int32 SplinePointIndex = 0; SplinePointIndex < SplinePoints.Num(); ++SplinePointIndex)
+					// Index in the array of SplinePoint2Ds doesn't necessarily match the index in the SplineComponent, but it usually does
+					if (SplinePoints.IsValidIndex(SelectedSplinePointIndex) && SplinePoints[SelectedSplinePointIndex].Index == SelectedSplinePointIndex)
 					{
-						CurrentSplinePoint = &SplinePoints[SplinePointIndex];
-						if (SelectedSplinePointIndex == CurrentSplinePoint->Index)
+						CurrentSplinePoint = &SplinePoints[SelectedSplinePointIndex];
+					}
+					else
+					{
+						for (int32 SplinePointIndex = 0; SplinePointIndex < SplinePoints.Num(); ++SplinePointIndex)
 						{
-							break;
+							if (SelectedSplinePointIndex == SplinePoints[SplinePointIndex].Index)
+							{
+								CurrentSplinePoint = &SplinePoints[SplinePointIndex];
+								break;
+							}
 						}
 					}
-					
+
 					if (CurrentSplinePoint != nullptr)
 					{
 						CurrentSplinePoint->Position += InMouseEvent.GetCursorDelta();
 
-						UClass* ActorClass = ASplineActor::StaticClass();
-						FProperty* Property = FindFProperty<FProperty>(ActorClass, "SplineComponent");
 						FVector SplinePointPos = SplineActor->SplineComponent->GetLocationAtSplinePoint(SelectedSplinePointIndex, ESplineCoordinateSpace::Local);
 
 						// Position stored in the spline point is post offset and zoom, so undo these before storing the value in the spline point
-						SplineActor->SplineComponent->SetLocationAtSplinePoint(SelectedSplinePointIndex, FVector((CurrentSplinePoint->Position.X - PositionOffset.X) / ZoomFactor.X, (CurrentSplinePoint->Position.Y - PositionOffset.Y) / ZoomFactor.Y, SplinePointPos.Z), ESplineCoordinateSpace::Local);
-
-						SplineActor->SplineComponent->bSplineHasBeenEdited = true;
-
-						// Notify that the spline has been modified
-						FPropertyChangedEvent PropertyChangedEvent(Property);
-						SplineActor->SplineComponent->PostEditChangeProperty(PropertyChangedEvent);
+						// Don't update the spline yet, that's done once after all the selected points have moved
+						SplineActor->SplineComponent->SetLocationAtSplinePoint(SelectedSplinePointIndex, FVector((CurrentSplinePoint->Position.X - PositionOffset.X) / ZoomFactor.X, (CurrentSplinePoint->Position.Y - PositionOffset.Y) / ZoomFactor.Y, SplinePointPos.Z), ESplineCoordinateSpace::Local, false);
 
-						// Don't call PostEditMove here, too slow to re-run the ConstructionScript every frame
-						//SplineActor->PostEditMove(false);
+						++CurrentDragStats.NumPointMoves;
+						bMovedAnyPoint = true;
 					}
-					
 				}
 			}
-			GEditor->RedrawLevelEditingViewports(true);
+
+			if (bMovedAnyPoint)
+			{
+				SplineActor->SplineComponent->UpdateSpline();
+				SplineActor->SplineComponent->bSplineHasBeenEdited = true;
+
+				// Don't call PostEditMove here, too slow to re-run the ConstructionScript every frame
+				bPendingDragChangeNotification = true;
+				bPendingViewportRedraw = true;
+			}
 		}
 	}
 
@@ -840,6 +1020,56 @@ FReply SSplineEditWidget::OnMouseMove( const FGeometry& InMyGeometry, const FPoi
 	return FReply::Handled();
 }
 
+void SSplineEditWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	FlushPendingDragUpdates(InCurrentTime);
+}
+
+void SSplineEditWidget::FlushPendingDragUpdates(double CurrentTime)
+{
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
+	{
+		bPendingDragChangeNotification = false;
+		bPendingViewportRedraw = false;
+		return;
+	}
+
+	// One notification per frame, no matter how many points or mouse move events there were
+	if (bPendingDragChangeNotification)
+	{
+		bPendingDragChangeNotification = false;
+
+		// Notify that the spline has been modified
+		FProperty* Property = FindFProperty<FProperty>(ASplineActor::StaticClass(), "SplineComponent");
+		FPropertyChangedEvent PropertyChangedEvent(Property);
+		SplineActor->SplineComponent->PostEditChangeProperty(PropertyChangedEvent);
+
+		++CurrentDragStats.NumChangeNotifications;
+
+		if (SplineActor->IsPreviewingSplineMeshes())
+		{
+			SplineActor->UpdateSplineMeshPreview(SelectedSplinePointIndices);
+		}
+
+		// Pick up the auto tangents that were recalculated for the moved points
+		Rebuild2dSplineData(ESplineDataRebuildFlags::SplineData | ESplineDataRebuildFlags::Projection);
+	}
+
+	// Redrawing the level viewports faster than the display can show them is wasted work
+	const float MaxViewportRedrawsPerSecond = CVarSplineEditMaxRedrawsPerSecond.GetValueOnGameThread();
+	if (bPendingViewportRedraw && (MaxViewportRedrawsPerSecond <= 0.0f || (CurrentTime - LastViewportRedrawTime) >= (1.0 / MaxViewportRedrawsPerSecond)))
+	{
+		bPendingViewportRedraw = false;
+		LastViewportRedrawTime = CurrentTime;
+
+		GEditor->RedrawLevelEditingViewports(true);
+
+		++CurrentDragStats.NumViewportRedraws;
+	}
+}
+
 FReply SSplineEditWidget::OnMouseButtonDown( const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent )
 {
 	// Figure out what was clicked on
@@ -895,18 +1125,35 @@ FReply SSplineEditWidget::OnMouseButtonUp( const FGeometry& InMyGeometry, const
 				FProperty* SplineInfoProperty = FindFProperty<FProperty>(USplineComponent::StaticClass(), "SplineComponent");
 				SplineActor->SplineComponent->bSplineHasBeenEdited = true;
 
-				// Notify that the spline has been modified
-				FPropertyChangedEvent SplineInfoPropertyChangedEvent(SplineInfoProperty);
-				SplineActor->SplineComponent->PostEditChangeProperty(SplineInfoPropertyChangedEvent);
+				// Notify that the spline has been modified, unless the last moves of the drag already were
+				if (bPendingDragChangeNotification)
+				{
+					FPropertyChangedEvent SplineInfoPropertyChangedEvent(SplineInfoProperty);
+					SplineActor->SplineComponent->PostEditChangeProperty(SplineInfoPropertyChangedEvent);
+					++CurrentDragStats.NumChangeNotifications;
+				}
+
+				// Stop previewing, the construction script rebuilds the meshes properly
+				SplineActor->EndSplineMeshPreview();
 
 				// Notify of change so any CS is re-run
 				SplineActor->PostEditMove(false);
 
-				// Finish the transaction we started earlier when we detected a drag
+				// Finish the transaction we started earlier when we detected a drag, the moved points are stored first
+				DragSplinePointsChange.Reset();
 				GEditor->EndTransaction();
 				
-				// Force the level editing viewport to update
+				// Force the level editing viewport to update, to show the meshes rebuilt by the construction script
+				// This supersedes anything that was still deferred from the drag
 				GEditor->RedrawLevelEditingViewports(true);
+				bPendingDragChangeNotification = false;
+				bPendingViewportRedraw = false;
+
+				++CurrentDragStats.NumViewportRedraws;
+				LastDragStats = CurrentDragStats;
+
+				UE_LOG(LogSplineEditWidget, Verbose, TEXT("Spline point drag finished: %d mouse moves, %d point moves, %d change notifications, %d viewport redraws"),
+					LastDragStats.NumMouseMoveEvents, LastDragStats.NumPointMoves, LastDragStats.NumChangeNotifications, LastDragStats.NumViewportRedraws);
 			}
 			else
 			{
@@ -943,6 +1190,7 @@ FReply SSplineEditWidget::OnMouseButtonUp( const FGeometry& InMyGeometry, const
 
 		DragPointDistance = 0.0f;
 
+		DragSplinePointsChange.Reset();
 		if (GEditor && GEditor->Trans && !GEditor->bIsSimulatingInEditor && GEditor->Trans->IsActive())
 		{
 			GEditor->EndTransaction();
@@ -1012,7 +1260,7 @@ FReply SSplineEditWidget::OnMouseWheel( const FGeometry& MyGeometry, const FPoin
 	ZoomFactor.X = FMath::Min(ZoomFactor.X, SSplineEditWidgetDefs::MaxZoom);
 	ZoomFactor.Y = FMath::Min(ZoomFactor.Y, SSplineEditWidgetDefs::MaxZoom);
 
-	Rebuild2dSplineData(false, false);
+	Rebuild2dSplineData(ESplineDataRebuildFlags::Projection);
 
 	return FReply::Handled();
 }
@@ -1125,21 +1373,19 @@ void SSplineEditWidget::ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition,
 				{
 					// Scoped transaction for the undo buffer
 					const FScopedTransaction Transaction(LOCTEXT("EditSplinePointType", "Change Spline Point(s) Type"));
-					Self->SplineActor->SplineComponent->Modify();
-					if (AActor* Owner = Self->SplineActor->SplineComponent->GetOwner())
-					{
-						Owner->Modify();
-					}
+					const FScopedSplinePointsChange SplinePointsChange(Self->SplineActor);
 
 					for (int32 SelectedSplinePointIndex : Self->SelectedSplinePointIndices)
 					{
-						if (SelectedSplinePointIndex > 0 || SelectedSplinePointIndex < Self->SplineActor->SplineComponent->GetNumberOfSplinePoints())
+						if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < Self->SplineActor->SplineComponent->GetNumberOfSplinePoints())
 						{
 							// Set the spline point type
-							Self->SplineActor->SplineComponent->SetSplinePointType(SelectedSplinePointIndex, SplineType);
+							Self->SplineActor->SplineComponent->SetSplinePointType(SelectedSplinePointIndex, SplineType, false);
 						}
 					}
 
+					// Update the spline once for the whole selection
+					Self->SplineActor->SplineComponent->UpdateSpline();
 					Self->SplineActor->SplineComponent->bSplineHasBeenEdited = true;
 
 					// Don't call PostEditChangeProperty here because it ends up forcing the spline edit widget to recalculate zoom & offset, so it makes you lose your place if you have zoomed or panned
@@ -1162,22 +1408,20 @@ void SSplineEditWidget::ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition,
 				if (Self->SelectedSplinePointIndices.Num() > 0)
 				{
 					// Scoped transaction for the undo buffer
-					const FScopedTransaction Transaction(LOCTEXT("EditSplinePointType", "Make Spline Point(s) Round"));
-					Self->SplineActor->SplineComponent->Modify();
-					if (AActor* Owner = Self->SplineActor->SplineComponent->GetOwner())
-					{
-						Owner->Modify();
-					}
+					const FScopedTransaction Transaction(LOCTEXT("MakeSplinePointRound", "Make Spline Point(s) Round"));
+					const FScopedSplinePointsChange SplinePointsChange(Self->SplineActor);
 
 					for (int32 SelectedSplinePointIndex : Self->SelectedSplinePointIndices)
 					{
-						if (SelectedSplinePointIndex > 0 || SelectedSplinePointIndex < Self->SplineActor->SplineComponent->GetNumberOfSplinePoints())
+						if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < Self->SplineActor->SplineComponent->GetNumberOfSplinePoints())
 						{
 							// Set the spline point type
-							Self->SplineActor->SplineComponent->SetSplinePointType(SelectedSplinePointIndex, ESplinePointType::Curve);
+							Self->SplineActor->SplineComponent->SetSplinePointType(SelectedSplinePointIndex, ESplinePointType::Curve, false);
 						}
 					}
 
+					// Update the spline once for the whole selection
+					Self->SplineActor->SplineComponent->UpdateSpline();
 					Self->SplineActor->SplineComponent->bSplineHasBeenEdited = true;
 
 					// Don't call PostEditChangeProperty here because it ends up forcing the spline edit widget to recalculate zoom & offset, so it makes you lose your place if you have zoomed or panned
@@ -1200,27 +1444,25 @@ void SSplineEditWidget::ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition,
 				if (Self->SelectedSplinePointIndices.Num() > 0)
 				{
 					// Scoped transaction for the undo buffer
-					const FScopedTransaction Transaction(LOCTEXT("EditSplinePointType", "Make Spline Point(s) Sharp Corners"));
-					Self->SplineActor->SplineComponent->Modify();
-					if (AActor* Owner = Self->SplineActor->SplineComponent->GetOwner())
-					{
-						Owner->Modify();
-					}
+					const FScopedTransaction Transaction(LOCTEXT("MakeSplinePointSharpCorners", "Make Spline Point(s) Sharp Corners"));
+					const FScopedSplinePointsChange SplinePointsChange(Self->SplineActor);
 
 					for (int32 SelectedSplinePointIndex : Self->SelectedSplinePointIndices)
 					{
-						if (SelectedSplinePointIndex > 0 || SelectedSplinePointIndex < Self->SplineActor->SplineComponent->GetNumberOfSplinePoints())
+						if (SelectedSplinePointIndex >= 0 && SelectedSplinePointIndex < Self->SplineActor->SplineComponent->GetNumberOfSplinePoints())
 						{
 							FVector PreviousTangent = Self->SplineActor->SplineComponent->GetTangentAtSplinePoint(SelectedSplinePointIndex, ESplineCoordinateSpace::Local);
 							// Set the spline point type
-							Self->SplineActor->SplineComponent->SetSplinePointType(SelectedSplinePointIndex, ESplinePointType::CurveClamped);
+							Self->SplineActor->SplineComponent->SetSplinePointType(SelectedSplinePointIndex, ESplinePointType::CurveClamped, false);
 							// Set the right tangent for a sharp corner point
 							FVector NewTangent = PreviousTangent;
 							NewTangent.X = NewTangent.Y = 0.0001f;	// UE-19183, tangents of 0 leave holes in a mesh. Make it just above 0 for now
-							Self->SplineActor->SplineComponent->SetTangentAtSplinePoint(SelectedSplinePointIndex, NewTangent, ESplineCoordinateSpace::Local);
+							Self->SplineActor->SplineComponent->SetTangentAtSplinePoint(SelectedSplinePointIndex, NewTangent, ESplineCoordinateSpace::Local, false);
 						}
 					}
 
+					// Update the spline once for the whole selection
+					Self->SplineActor->SplineComponent->UpdateSpline();
 					Self->SplineActor->SplineComponent->bSplineHasBeenEdited = true;
 
 					// Don't call PostEditChangeProperty here because it ends up forcing the spline edit widget to recalculate zoom & offset, so it makes you lose your place if you have zoomed or panned
@@ -1255,15 +1497,12 @@ void SSplineEditWidget::ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition,
 			// Scoped transaction for the undo buffer
 			const FScopedTransaction Transaction(LOCTEXT("DeleteSplinePoint", "Delete Spline Point"));
 
-			Self->SplineActor->SplineComponent->Modify();
-			if (AActor* Owner = Self->SplineActor->SplineComponent->GetOwner())
-			{
-				Owner->Modify();
-			}
+			const FScopedSplinePointsChange SplinePointsChange(Self->SplineActor);
 
 			// Delete the spline point
-			Self->SplineActor->SplineComponent->RemoveSplinePoint(MatchingIndex);
-			Self->SplineActor->SplineComponent->bSplineHasBeenEdited = true;
+			TArray<int32> SplinePointIndicesToRemove;
+			SplinePointIndicesToRemove.Add(MatchingIndex);
+			Self->SplineActor->RemoveSplinePoints(SplinePointIndicesToRemove);
 
 			// Don't call PostEditChangeProperty here because it ends up forcing the spline edit widget to recalculate zoom & offset, so it makes you lose your place if you have zoomed or panned
 
@@ -1310,45 +1549,38 @@ void SSplineEditWidget::ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition,
 			// Scoped transaction for the undo buffer
 			const FScopedTransaction Transaction(LOCTEXT("InsertSplinePoint", "Insert Spline Point"));
 
-			Self->SplineActor->SplineComponent->Modify();
-			if (AActor* Owner = Self->SplineActor->SplineComponent->GetOwner())
-			{
-				Owner->Modify();
-			}
+			const FScopedSplinePointsChange SplinePointsChange(Self->SplineActor);
 
 			// Add New point
 			int32 IndexToInsert = PointToEdit.Index + 1;
-			// Insert or add at end?
-			if (IndexToInsert < Self->SplineActor->SplineComponent->GetNumberOfSplinePoints())
-			{
-				
-				Self->SplineActor->SplineComponent->AddSplinePointAtIndex(NewSplinePointLocation3D, IndexToInsert, ESplineCoordinateSpace::Local);
-			}
-			else
-			{
-				Self->SplineActor->SplineComponent->AddSplinePoint(NewSplinePointLocation3D, ESplineCoordinateSpace::Local);
-			}
+
+			TArray<FVector> NewSplinePointLocations;
+			TArray<FVector> NewSplinePointTangents;
+			TArray<ESplinePointType::Type> NewSplinePointTypes;
+			NewSplinePointLocations.Add(NewSplinePointLocation3D);
 
 			// Set to the desired curve type
 			switch (PointCurveType)
 			{
-			case EPinballSplinePointCurveType::RoundSplinePoint:
-				Self->SplineActor->SplineComponent->SetSplinePointType(IndexToInsert, ESplinePointType::Curve);
-				break;
 			case EPinballSplinePointCurveType::SharpCornerSplinePoint:
 			{
-				FVector PreviousTangent = Self->SplineActor->SplineComponent->GetTangentAtSplinePoint(IndexToInsert, ESplineCoordinateSpace::Local);
-				Self->SplineActor->SplineComponent->SetSplinePointType(IndexToInsert, ESplinePointType::CurveClamped);
-				FVector NewTangent = PreviousTangent;
+				// Set the right tangent for a sharp corner point, which makes it a custom tangent point
+				FVector NewTangent = Self->SplineActor->SplineComponent->GetTangentAtSplinePoint(PointToEdit.Index, ESplineCoordinateSpace::Local);
 				NewTangent.X = NewTangent.Y = 0.0001f;	// UE-19183, tangents of 0 leave holes in a mesh. Make it just above 0 for now
-				Self->SplineActor->SplineComponent->SetTangentAtSplinePoint(IndexToInsert, NewTangent, ESplineCoordinateSpace::Local);
+				NewSplinePointTangents.Add(NewTangent);
+				NewSplinePointTypes.Add(ESplinePointType::CurveCustomTangent);
 				break;
 			}
+			case EPinballSplinePointCurveType::RoundSplinePoint:
 			default:
+				// Tangent is calculated automatically
+				NewSplinePointTangents.Add(FVector::ZeroVector);
+				NewSplinePointTypes.Add(ESplinePointType::Curve);
 				break;
 			}
-			
-			Self->SplineActor->SplineComponent->bSplineHasBeenEdited = true;
+
+			// Insert or add at end, the spline is updated once
+			Self->SplineActor->InsertSplinePoints(IndexToInsert, NewSplinePointLocations, NewSplinePointTangents, NewSplinePointTypes);
 
 			// Don't call PostEditChangeProperty here because it ends up forcing the spline edit widget to recalculate zoom & offset, so it makes you lose your place if you have zoomed or panned
 
@@ -1422,6 +1654,7 @@ void SSplineEditWidget::ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition,
 						EUserInterfaceActionType::Button);
 				}
 			}
+			OptionsMenuBuilder.EndSection();
 		}
 		// Right clicked on Spline
 		else
@@ -1452,7 +1685,35 @@ void SSplineEditWidget::ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition,
 			}
 			OptionsMenuBuilder.EndSection();
 		}
-		
+
+		// Whole spline options
+		OptionsMenuBuilder.BeginSection(NAME_None, LOCTEXT("EditSplineSection", "Spline"));
+		{
+			OptionsMenuBuilder.AddWidget(
+				SNew(SBox)
+				.WidthOverride(100.0f)
+				[
+					SNew(SSpinBox<float>)
+					.MinValue(SSplineEditWidgetDefs::MinSimplifyTolerance)
+					.MaxValue(SSplineEditWidgetDefs::MaxSimplifyTolerance)
+					.Value(this, &SSplineEditWidget::GetSimplifyTolerance)
+					.OnValueChanged(this, &SSplineEditWidget::SetSimplifyTolerance)
+				],
+				LOCTEXT("SimplifyTolerance", "Simplify Tolerance"));
+
+			OptionsMenuBuilder.AddMenuEntry(
+				LOCTEXT("SimplifySpline", "Simplify Spline"),
+				LOCTEXT("SimplifySplineTooltip", "Remove as many spline points as possible while keeping the spline within the tolerance of its current shape."),
+				FSlateIcon(),	// Icon
+				FUIAction(
+				FExecuteAction::CreateSP(this, &SSplineEditWidget::SimplifySpline),
+				FCanExecuteAction(),
+				FIsActionChecked()),
+				NAME_None,	// Extension point
+				EUserInterfaceActionType::Button);
+		}
+		OptionsMenuBuilder.EndSection();
+
 		TSharedRef< SWidget > WindowContent =
 			SNew(SBorder)
 			[
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
+#include "SplinePointsChange.h"
 
 struct FSlateBrush;
 class ASplineActor;
@@ -11,6 +12,69 @@ class ASplineActor;
 // Draw bounding box of the spline we are currently hovering over
 #define SPLINE_EDIT_WIDGET_DEBUG_SPLINE_HOVER 0
 
+/** Which parts of the 2D spline representation need to be rebuilt */
+enum class ESplineDataRebuildFlags : uint8
+{
+	None = 0,
+
+	/** Re-read the point data from the spline component into the cache */
+	SplineData = 1 << 0,
+
+	/** Pick a zoom factor that fits the spline in the widget */
+	ZoomFactor = 1 << 1,
+
+	/** Pick a position offset that centers the spline in the widget */
+	PositionOffset = 1 << 2,
+
+	/** Project the cached point data into 2D spline points using the current zoom and offset */
+	Projection = 1 << 3,
+
+	All = SplineData | ZoomFactor | PositionOffset | Projection,
+};
+ENUM_CLASS_FLAGS(ESplineDataRebuildFlags)
+
+/**
+* Raw spline point data read directly from the spline curves in a single pass
+* Kept as separate contiguous arrays so rebuilding the 2D representation doesn't go through the component transform for every point
+*/
+struct FSplinePointDataCache
+{
+	FSplinePointDataCache()
+		: Bounds(ForceInit)
+	{}
+
+	/** Local space location of each spline point */
+	TArray<FVector> Locations;
+
+	/** Local space (leave) tangent of each spline point */
+	TArray<FVector> Tangents;
+
+	/** X/Y bounds of all the spline point locations */
+	FBox2D Bounds;
+
+	int32 Num() const
+	{
+		return Locations.Num();
+	}
+};
+
+/** Spline of another selected actor, drawn for reference but not editable */
+struct FSplineOverlay2D
+{
+	FSplineOverlay2D()
+		: bClosedLoop(false)
+	{}
+
+	/** Point data in the local space of the spline being edited */
+	FSplinePointDataCache PointData;
+
+	/** 2D positions and directions, with zoom and offset applied */
+	TArray<FVector2D> Positions;
+	TArray<FVector2D> Directions;
+
+	bool bClosedLoop;
+};
+
 /**
 * 2D (X&Y) Spline point info for a point in the spline
 */
@@ -33,6 +97,29 @@ struct FSplinePoint2D
 };
 
 
+/** Counters for a single spline point drag, used to verify how much work a drag generates */
+struct FSplineDragStats
+{
+	FSplineDragStats()
+		: NumMouseMoveEvents(0)
+		, NumPointMoves(0)
+		, NumChangeNotifications(0)
+		, NumViewportRedraws(0)
+	{}
+
+	/** Mouse move events received while the drag was active */
+	int32 NumMouseMoveEvents;
+
+	/** Individual spline point location updates */
+	int32 NumPointMoves;
+
+	/** PostEditChangeProperty notifications sent to the spline component */
+	int32 NumChangeNotifications;
+
+	/** Level editing viewport redraws requested */
+	int32 NumViewportRedraws;
+};
+
 /** Results for mouse overlapping spline */
 struct FSplineOverlapResult
 {
@@ -92,6 +179,9 @@ public:
 		/** Pointer to the Spline Actor in question */
 		SLATE_ATTRIBUTE( ASplineActor*, SplineActor )
 
+		/** Other selected Spline Actors, drawn underneath the edited spline for reference */
+		SLATE_ARGUMENT( TArray<ASplineActor*>, OverlaySplineActors )
+
 	SLATE_END_ARGS()
 
 	/**
@@ -110,19 +200,35 @@ public:
 	virtual FCursorReply OnCursorQuery(const FGeometry& MyGeometry, const FPointerEvent& CursorEvent) const override;
 	virtual FReply OnMouseMove(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent) override;
 	virtual FReply OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** Counters for the drag that is currently in progress */
+	const FSplineDragStats& GetCurrentDragStats() const
+	{
+		return CurrentDragStats;
+	}
+
+	/** Counters for the last drag that was completed */
+	const FSplineDragStats& GetLastDragStats() const
+	{
+		return LastDragStats;
+	}
 
 	/** Manipulate the Selected Spline Point indices */
 	void AddToSelectedSplinePointIndices(int32 IndexToAdd)
 	{
 		SelectedSplinePointIndices.Add(IndexToAdd);
+		InvalidateSelectedSplinePointValues();
 	}
 	void RemoveFromSelectedSplinePointIndices(int32 IndexToRemove)
 	{
 		SelectedSplinePointIndices.Remove(IndexToRemove);
+		InvalidateSelectedSplinePointValues();
 	}
 	void ClearSelectedSplinePointIndices()
 	{
 		SelectedSplinePointIndices.Empty();
+		InvalidateSelectedSplinePointValues();
 	}
 
 	/*
@@ -137,6 +243,9 @@ public:
 	*/
 	void Rebuild2dSplineData(bool bRecalculatePositionOffset, bool bRecalculateZoomFactor);
 
+	/** Rebuild only the requested parts of the 2D representation of the spline */
+	void Rebuild2dSplineData(ESplineDataRebuildFlags RebuildFlags);
+
 	/** Whether or not we can adjust the location and rotation of the currently selected spline points */
 	bool OnGetCanEditSelectedSplinePointLocationAndTangent() const;
 
@@ -149,8 +258,53 @@ public:
 	void OnSelectedSplinePointTangentChanged(float NewValue, EAxis::Type Axis);
 	void OnSelectedSplinePointTangentCommitted(float InNewValue, ETextCommit::Type CommitType, EAxis::Type Axis);
 
+	/** Maximum distance simplifying may move the spline, shared by the context menu and the details panel */
+	float GetSimplifyTolerance() const
+	{
+		return SimplifyTolerance;
+	}
+	void SetSimplifyTolerance(float NewTolerance);
+
+	/** Simplify the spline being edited, in one undoable transaction */
+	void SimplifySpline();
+
+	/** Simplify every given spline and re-run their construction scripts in one undoable transaction, and report the point counts and error */
+	static void SimplifySplines(const TArray<ASplineActor*>& SplineActorsToSimplify, float Tolerance);
+
 protected:
 
+	/**
+	* Sends the change notification and viewport redraw that were deferred while dragging
+	* At most one notification is sent per frame, and redraws are limited to the display refresh rate
+	*/
+	void FlushPendingDragUpdates(double CurrentTime);
+
+	/** Aggregate location and tangent of the selected spline points, unset where the selected points have different values */
+	struct FSelectedSplinePointValues
+	{
+		FSelectedSplinePointValues()
+			: FrameNumber(MAX_uint64)
+		{}
+
+		/** Frame these values were computed on */
+		uint64 FrameNumber;
+
+		TOptional<float> Location[2];
+		TOptional<float> Tangent[2];
+	};
+
+	/**
+	* Returns the aggregated values of the selected spline points
+	* Slate polls these for every numeric entry box every frame, so they are computed at most once per frame
+	*/
+	const FSelectedSplinePointValues& GetSelectedSplinePointValues() const;
+
+	/** Forces the selected spline point values to be recomputed next time they are polled */
+	void InvalidateSelectedSplinePointValues()
+	{
+		SelectedSplinePointValues.FrameNumber = MAX_uint64;
+	}
+
 	/** Finds the spline point that's under the cursor */
 	struct FSplinePoint2D* FindSplinePointUnderCursor(const FGeometry& MyGeometry, const FVector2D& ScreenSpaceCursorPosition);
 
@@ -161,6 +315,12 @@ private:
 
 	ASplineActor* SplineActor;
 
+	/** Other selected Spline Actors drawn for reference */
+	TArray<TWeakObjectPtr<ASplineActor>> OverlaySplineActors;
+
+	/** 2D representation of OverlaySplineActors */
+	TArray<FSplineOverlay2D> OverlaySplines;
+
 	/** Displays a context menu at the specified location with options for modifying the spline actor's spline */
 	void ShowOptionsMenuAt(const FVector2D& ScreenSpacePosition, const FWidgetPath& WidgetPath);
 
@@ -181,6 +341,9 @@ private:
 	TAttribute<FVector2D> BorderPadding;
 
 
+	/** Raw point data of the spline, refreshed only when the spline itself changed */
+	FSplinePointDataCache SplinePointDataCache;
+
 	/** Array of Spline Points with 2D positions */
 	TArray<struct FSplinePoint2D> SplinePoints;
 
@@ -198,12 +361,21 @@ private:
 	/** Indices of spline points that the user has currently selected */
 	TArray<int32> SelectedSplinePointIndices;
 
+	/** Cached aggregate values of the selected spline points */
+	mutable FSelectedSplinePointValues SelectedSplinePointValues;
+
 	/** Point that we're currently dragging around.  This points to an entry in the SplinePoints array! */
 	FSplinePoint2D* PointBeingDragged;
 
 	/** Whether or not the user has dragged a spline point far enough to start a drag transaction*/
 	bool bStartedDrag;
 
+	/** Records the points moved by the current drag into its transaction */
+	TUniquePtr<FScopedSplinePointsChange> DragSplinePointsChange;
+
+	/** Tolerance used by SimplifySpline */
+	float SimplifyTolerance;
+
 	/** Whether the user is panning with the mouse or not */
 	bool bPanningWithMouse;
 
@@ -219,6 +391,19 @@ private:
 	/** Position of the mouse cursor relative to the widget, the last time it moved.  Used for drag and drop. */
 	FVector2D RelativeMouseCursorPos;
 
+	/** Whether spline points were moved by a drag since the last change notification was sent */
+	bool bPendingDragChangeNotification;
+
+	/** Whether the level editing viewports need to be redrawn to reflect a drag */
+	bool bPendingViewportRedraw;
+
+	/** Time of the last level editing viewport redraw we requested while dragging */
+	double LastViewportRedrawTime;
+
+	/** Counters for the drag in progress, and for the last completed drag */
+	FSplineDragStats CurrentDragStats;
+	FSplineDragStats LastDragStats;
+
 
 
 	/** The result of checking what spline the mouse is overlapping */
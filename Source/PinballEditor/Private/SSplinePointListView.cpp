@@ -0,0 +1,372 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "SSplinePointListView.h"
+#include "SplineActor.h"
+#include "ScopedTransaction.h"
+#include "SplinePointsChange.h"
+#include "Editor.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Input/SNumericEntryBox.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+
+#define LOCTEXT_NAMESPACE "SSplinePointListView"
+
+namespace SSplinePointListViewDefs
+{
+	const FName IndexColumnName(TEXT("Index"));
+	const FName LocationXColumnName(TEXT("LocationX"));
+	const FName LocationYColumnName(TEXT("LocationY"));
+	const FName TangentXColumnName(TEXT("TangentX"));
+	const FName TangentYColumnName(TEXT("TangentY"));
+	const FName TypeColumnName(TEXT("Type"));
+
+	const float RowHeight = 22.0f;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SSplinePointListRow
+
+/** A single row of the spline point list */
+class SSplinePointListRow : public SMultiColumnTableRow<FSplinePointListItem>
+{
+public:
+	SLATE_BEGIN_ARGS( SSplinePointListRow ) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable, FSplinePointListItem InItem, SSplinePointListView* InOwner)
+	{
+		Item = InItem;
+		Owner = InOwner;
+
+		SMultiColumnTableRow<FSplinePointListItem>::Construct(FSuperRowType::FArguments(), InOwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		const int32 SplinePointIndex = *Item;
+
+		if (ColumnName == SSplinePointListViewDefs::IndexColumnName)
+		{
+			return SNew(STextBlock)
+				.Text(FText::AsNumber(SplinePointIndex));
+		}
+		else if (ColumnName == SSplinePointListViewDefs::LocationXColumnName)
+		{
+			return MakeNumericCell(SplinePointIndex, ESplinePointListColumn::LocationX);
+		}
+		else if (ColumnName == SSplinePointListViewDefs::LocationYColumnName)
+		{
+			return MakeNumericCell(SplinePointIndex, ESplinePointListColumn::LocationY);
+		}
+		else if (ColumnName == SSplinePointListViewDefs::TangentXColumnName)
+		{
+			return MakeNumericCell(SplinePointIndex, ESplinePointListColumn::TangentX);
+		}
+		else if (ColumnName == SSplinePointListViewDefs::TangentYColumnName)
+		{
+			return MakeNumericCell(SplinePointIndex, ESplinePointListColumn::TangentY);
+		}
+		else if (ColumnName == SSplinePointListViewDefs::TypeColumnName)
+		{
+			return SNew(SComboButton)
+				.OnGetMenuContent(this, &SSplinePointListRow::MakePointTypeMenu, SplinePointIndex)
+				.ButtonContent()
+				[
+					SNew(STextBlock)
+					.Text(Owner, &SSplinePointListView::OnGetSplinePointTypeText, SplinePointIndex)
+				];
+		}
+
+		return SNullWidget::NullWidget;
+	}
+
+private:
+
+	TSharedRef<SWidget> MakeNumericCell(int32 SplinePointIndex, ESplinePointListColumn Column)
+	{
+		return SNew(SNumericEntryBox<float>)
+			.Delta(0.01f)
+			.Value(Owner, &SSplinePointListView::OnGetSplinePointValue, SplinePointIndex, Column)
+			.OnValueCommitted(Owner, &SSplinePointListView::OnSplinePointValueCommitted, SplinePointIndex, Column);
+	}
+
+	TSharedRef<SWidget> MakePointTypeMenu(int32 SplinePointIndex)
+	{
+		const bool bShouldCloseMenuAfterSelection = true;
+		FMenuBuilder MenuBuilder(bShouldCloseMenuAfterSelection, NULL);
+
+		for (int32 SplineTypeIndex = 0; SplineTypeIndex <= (int32)ESplinePointType::CurveCustomTangent; ++SplineTypeIndex)
+		{
+			const ESplinePointType::Type SplineType = (ESplinePointType::Type)SplineTypeIndex;
+
+			MenuBuilder.AddMenuEntry(
+				SSplinePointListView::GetSplinePointTypeName(SplineType),
+				FText(),	// No tooltip (intentional)
+				FSlateIcon(),	// Icon
+				FUIAction(FExecuteAction::CreateSP(Owner, &SSplinePointListView::OnSplinePointTypeChanged, SplinePointIndex, SplineType)),
+				NAME_None,	// Extension point
+				EUserInterfaceActionType::Button);
+		}
+
+		return MenuBuilder.MakeWidget();
+	}
+
+	FSplinePointListItem Item;
+	SSplinePointListView* Owner;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// SSplinePointListView
+
+void SSplinePointListView::Construct( const FArguments& InArgs )
+{
+	SplineActor = InArgs._SplineActor.Get();
+	OnSplinePointsEdited = InArgs._OnSplinePointsEdited;
+
+	ChildSlot
+	[
+		SAssignNew(ListView, SListView<FSplinePointListItem>)
+		.ListItemsSource(&SplinePointItems)
+		.ItemHeight(SSplinePointListViewDefs::RowHeight)
+		.SelectionMode(ESelectionMode::Multi)
+		.OnGenerateRow(this, &SSplinePointListView::OnGenerateRow)
+		.HeaderRow
+		(
+			SNew(SHeaderRow)
+			+ SHeaderRow::Column(SSplinePointListViewDefs::IndexColumnName)
+			.DefaultLabel(LOCTEXT("IndexColumn", "#"))
+			.FixedWidth(32.0f)
+			+ SHeaderRow::Column(SSplinePointListViewDefs::LocationXColumnName)
+			.DefaultLabel(LOCTEXT("LocationXColumn", "Location X"))
+			+ SHeaderRow::Column(SSplinePointListViewDefs::LocationYColumnName)
+			.DefaultLabel(LOCTEXT("LocationYColumn", "Location Y"))
+			+ SHeaderRow::Column(SSplinePointListViewDefs::TangentXColumnName)
+			.DefaultLabel(LOCTEXT("TangentXColumn", "Tangent X"))
+			+ SHeaderRow::Column(SSplinePointListViewDefs::TangentYColumnName)
+			.DefaultLabel(LOCTEXT("TangentYColumn", "Tangent Y"))
+			+ SHeaderRow::Column(SSplinePointListViewDefs::TypeColumnName)
+			.DefaultLabel(LOCTEXT("TypeColumn", "Type"))
+		)
+	];
+
+	RefreshSplinePoints();
+}
+
+void SSplinePointListView::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Values are read live by the visible rows, only adding or removing points needs the items rebuilt
+	if (SplineActor != nullptr && SplineActor->SplineComponent != nullptr && SplineActor->SplineComponent->GetNumberOfSplinePoints() != SplinePointItems.Num())
+	{
+		RefreshSplinePoints();
+	}
+}
+
+void SSplinePointListView::RefreshSplinePoints()
+{
+	SplinePointItems.Empty();
+
+	if (SplineActor != nullptr && SplineActor->SplineComponent != nullptr)
+	{
+		const int32 NumSplinePoints = SplineActor->SplineComponent->GetNumberOfSplinePoints();
+		SplinePointItems.Reserve(NumSplinePoints);
+		for (int32 SplinePointIndex = 0; SplinePointIndex < NumSplinePoints; ++SplinePointIndex)
+		{
+			SplinePointItems.Add(MakeShareable(new int32(SplinePointIndex)));
+		}
+	}
+
+	if (ListView.IsValid())
+	{
+		ListView->RequestListRefresh();
+	}
+}
+
+TSharedRef<ITableRow> SSplinePointListView::OnGenerateRow(FSplinePointListItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SSplinePointListRow, OwnerTable, Item, this);
+}
+
+TOptional<float> SSplinePointListView::OnGetSplinePointValue(int32 SplinePointIndex, ESplinePointListColumn Column) const
+{
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr || !SplineActor->SplineComponent->SplineCurves.Position.Points.IsValidIndex(SplinePointIndex))
+	{
+		return TOptional<float>();
+	}
+
+	// Read the raw curve point, only visible rows ask for this
+	const FInterpCurvePoint<FVector>& CurvePoint = SplineActor->SplineComponent->SplineCurves.Position.Points[SplinePointIndex];
+
+	switch (Column)
+	{
+	case ESplinePointListColumn::LocationX:
+		return CurvePoint.OutVal.X;
+	case ESplinePointListColumn::LocationY:
+		return CurvePoint.OutVal.Y;
+	case ESplinePointListColumn::TangentX:
+		return CurvePoint.LeaveTangent.X;
+	case ESplinePointListColumn::TangentY:
+		return CurvePoint.LeaveTangent.Y;
+	default:
+		break;
+	}
+
+	return TOptional<float>();
+}
+
+void SSplinePointListView::GetSplinePointIndicesToEdit(int32 SplinePointIndex, TArray<int32>& OutSplinePointIndices) const
+{
+	OutSplinePointIndices.Reset();
+
+	// Editing a selected row edits the whole selection, editing any other row only edits that row
+	bool bIsSelected = false;
+	TArray<FSplinePointListItem> SelectedItems = ListView->GetSelectedItems();
+	for (const FSplinePointListItem& SelectedItem : SelectedItems)
+	{
+		OutSplinePointIndices.Add(*SelectedItem);
+		bIsSelected |= (*SelectedItem == SplinePointIndex);
+	}
+
+	if (!bIsSelected)
+	{
+		OutSplinePointIndices.Reset();
+		OutSplinePointIndices.Add(SplinePointIndex);
+	}
+}
+
+void SSplinePointListView::OnSplinePointValueCommitted(float NewValue, ETextCommit::Type CommitType, int32 SplinePointIndex, ESplinePointListColumn Column)
+{
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
+	{
+		return;
+	}
+
+	TArray<int32> SplinePointIndices;
+	GetSplinePointIndicesToEdit(SplinePointIndex, SplinePointIndices);
+
+	// Only the points the value changes, committing an unchanged value mustn't make a transaction or re-run the construction script
+	USplineComponent* SplineComponent = SplineActor->SplineComponent;
+	const int32 NumSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+	const int32 Axis = (Column == ESplinePointListColumn::LocationX || Column == ESplinePointListColumn::TangentX) ? 0 : 1;
+	SplinePointIndices.RemoveAll([SplineComponent, NumSplinePoints, Column, Axis, NewValue](int32 EditIndex)
+	{
+		if (EditIndex < 0 || EditIndex >= NumSplinePoints)
+		{
+			return true;
+		}
+		const bool bIsLocation = (Column == ESplinePointListColumn::LocationX || Column == ESplinePointListColumn::LocationY);
+		const FVector CurrentValue = bIsLocation ? SplineComponent->GetLocationAtSplinePoint(EditIndex, ESplineCoordinateSpace::Local) : SplineComponent->GetTangentAtSplinePoint(EditIndex, ESplineCoordinateSpace::Local);
+		return CurrentValue[Axis] == NewValue;
+	});
+	if (SplinePointIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// One transaction for the whole bulk edit
+	const FScopedTransaction Transaction(LOCTEXT("SetSplinePointValues", "Set Spline Point(s) Value"));
+	const FScopedSplinePointsChange SplinePointsChange(SplineActor);
+
+	for (int32 EditIndex : SplinePointIndices)
+	{
+		// Don't update the spline for each point, that's done once at the end
+		if (Column == ESplinePointListColumn::LocationX || Column == ESplinePointListColumn::LocationY)
+		{
+			FVector SplinePointLocation = SplineComponent->GetLocationAtSplinePoint(EditIndex, ESplineCoordinateSpace::Local);
+			SplinePointLocation[Axis] = NewValue;
+			SplineComponent->SetLocationAtSplinePoint(EditIndex, SplinePointLocation, ESplineCoordinateSpace::Local, false);
+		}
+		else
+		{
+			FVector SplinePointTangent = SplineComponent->GetTangentAtSplinePoint(EditIndex, ESplineCoordinateSpace::Local);
+			SplinePointTangent[Axis] = NewValue;
+			SplineComponent->SetTangentAtSplinePoint(EditIndex, SplinePointTangent, ESplineCoordinateSpace::Local, false);
+		}
+	}
+
+	FinishSplinePointEdit();
+}
+
+FText SSplinePointListView::OnGetSplinePointTypeText(int32 SplinePointIndex) const
+{
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr || SplinePointIndex < 0 || SplinePointIndex >= SplineActor->SplineComponent->GetNumberOfSplinePoints())
+	{
+		return FText::GetEmpty();
+	}
+
+	return GetSplinePointTypeName(SplineActor->SplineComponent->GetSplinePointType(SplinePointIndex));
+}
+
+void SSplinePointListView::OnSplinePointTypeChanged(int32 SplinePointIndex, ESplinePointType::Type NewType)
+{
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
+	{
+		return;
+	}
+
+	TArray<int32> SplinePointIndices;
+	GetSplinePointIndicesToEdit(SplinePointIndex, SplinePointIndices);
+
+	// Only the points of another type, picking the same type mustn't make a transaction or re-run the construction script
+	USplineComponent* SplineComponent = SplineActor->SplineComponent;
+	const int32 NumSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+	SplinePointIndices.RemoveAll([SplineComponent, NumSplinePoints, NewType](int32 EditIndex)
+	{
+		return EditIndex < 0 || EditIndex >= NumSplinePoints || SplineComponent->GetSplinePointType(EditIndex) == NewType;
+	});
+	if (SplinePointIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// One transaction for the whole bulk edit
+	const FScopedTransaction Transaction(LOCTEXT("SetSplinePointTypes", "Change Spline Point(s) Type"));
+	const FScopedSplinePointsChange SplinePointsChange(SplineActor);
+
+	for (int32 EditIndex : SplinePointIndices)
+	{
+		SplineComponent->SetSplinePointType(EditIndex, NewType, false);
+	}
+
+	FinishSplinePointEdit();
+}
+
+void SSplinePointListView::FinishSplinePointEdit()
+{
+	SplineActor->SplineComponent->UpdateSpline();
+	SplineActor->SplineComponent->bSplineHasBeenEdited = true;
+
+	// Notify of change so any ConstructionScript is re-run
+	SplineActor->PostEditMove(false);
+
+	GEditor->RedrawLevelEditingViewports(true);
+
+	OnSplinePointsEdited.ExecuteIfBound();
+}
+
+FText SSplinePointListView::GetSplinePointTypeName(ESplinePointType::Type SplinePointType)
+{
+	switch (SplinePointType)
+	{
+	case ESplinePointType::Linear:
+		return LOCTEXT("LinearPointType", "Linear");
+	case ESplinePointType::Curve:
+		return LOCTEXT("CurvePointType", "Curve");
+	case ESplinePointType::Constant:
+		return LOCTEXT("ConstantPointType", "Constant");
+	case ESplinePointType::CurveClamped:
+		return LOCTEXT("CurveClampedPointType", "CurveClamped");
+	case ESplinePointType::CurveCustomTangent:
+		return LOCTEXT("CurveCustomTangentPointType", "CurveCustomTangent");
+	default:
+		break;
+	}
+
+	return FText::GetEmpty();
+}
+
+#undef LOCTEXT_NAMESPACE
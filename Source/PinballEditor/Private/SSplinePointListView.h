@@ -0,0 +1,95 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Components/SplineComponent.h"
+
+class ASplineActor;
+class ITableRow;
+class STableViewBase;
+
+/** Columns shown for every spline point in the list */
+enum class ESplinePointListColumn : uint8
+{
+	LocationX,
+	LocationY,
+	TangentX,
+	TangentY,
+};
+
+/** Item in the spline point list, just the index of the point in the SplineComponent */
+typedef TSharedPtr<int32> FSplinePointListItem;
+
+/**
+ * Table of every point of a spline, with numeric entry for location and tangent and a selector for the point type
+ * Backed by an SListView so only the visible rows are ever generated, which keeps large outline walls fast to edit
+ * Edits made to a row that is part of the list selection are applied to every selected row in one transaction
+ */
+class SSplinePointListView : public SCompoundWidget
+{
+public:
+
+	SLATE_BEGIN_ARGS( SSplinePointListView )
+		: _SplineActor(nullptr)
+	{}
+
+		/** Pointer to the Spline Actor in question */
+		SLATE_ATTRIBUTE( ASplineActor*, SplineActor )
+
+		/** Called once an edit made in the list has been applied to the spline */
+		SLATE_EVENT( FSimpleDelegate, OnSplinePointsEdited )
+
+	SLATE_END_ARGS()
+
+	/**
+	 * Construct the widget
+	 *
+	 * @param	InArgs				A declaration from which to construct the widget
+	 */
+	void Construct( const FArguments& InArgs );
+
+	/** SWidget overrides */
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** Rebuild the list items, needed when spline points are added or removed */
+	void RefreshSplinePoints();
+
+	/** Value of a single cell, read directly from the spline curves */
+	TOptional<float> OnGetSplinePointValue(int32 SplinePointIndex, ESplinePointListColumn Column) const;
+
+	/** Apply a new cell value to this point, or to every selected point if this point is part of the selection */
+	void OnSplinePointValueCommitted(float NewValue, ETextCommit::Type CommitType, int32 SplinePointIndex, ESplinePointListColumn Column);
+
+	/** Name of the point type of a single point */
+	FText OnGetSplinePointTypeText(int32 SplinePointIndex) const;
+
+	/** Apply a new point type to this point, or to every selected point if this point is part of the selection */
+	void OnSplinePointTypeChanged(int32 SplinePointIndex, ESplinePointType::Type NewType);
+
+	/** Display names for the spline point types, indexed by ESplinePointType */
+	static FText GetSplinePointTypeName(ESplinePointType::Type SplinePointType);
+
+private:
+
+	/** Creates the row widget for a single spline point */
+	TSharedRef<ITableRow> OnGenerateRow(FSplinePointListItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+	/** Indices of the points an edit on this point applies to */
+	void GetSplinePointIndicesToEdit(int32 SplinePointIndex, TArray<int32>& OutSplinePointIndices) const;
+
+	/** Notify of change so any ConstructionScript is re-run, once for the whole edit */
+	void FinishSplinePointEdit();
+
+	ASplineActor* SplineActor;
+
+	FSimpleDelegate OnSplinePointsEdited;
+
+	/** One item per spline point */
+	TArray<FSplinePointListItem> SplinePointItems;
+
+	/** The list view showing SplinePointItems */
+	TSharedPtr< SListView<FSplinePointListItem> > ListView;
+};
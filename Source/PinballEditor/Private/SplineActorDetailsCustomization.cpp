@@ -11,14 +11,44 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Fonts/SlateFontInfo.h"
 #include "SSplineEditWidget.h"
+#include "SSplinePointListView.h"
 #include "PropertyCustomizationHelpers.h"
 #include "SplineActor.h"
 #include "Components/SplineComponent.h"
 #include "ScopedTransaction.h"
+#include "SplinePointsChange.h"
 #include "Widgets/Input/SNumericEntryBox.h"
+#include "WallActor.h"
+#include "GeometryBlueprintLibrary.h"
+#include "PolygonClipping.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
 
 #define LOCTEXT_NAMESPACE "Pinball"
 
+namespace SplineActorDetailsCustomizationDefs
+{
+	/** Default distance of offset copies, about the gap between a wall and a rail guide */
+	const float DefaultOffsetDistance = 20.0f;
+
+	/** Samples per curved spline segment when merging wall outlines */
+	const int32 MergeSamplesPerSegment = 8;
+
+	/** Merged outline vertices closer than this to a straight line are dropped */
+	const float MergeCollinearTolerance = 0.1f;
+
+	void ShowNotification(const FText& Text, SNotificationItem::ECompletionState CompletionState)
+	{
+		FNotificationInfo Info(Text);
+		Info.ExpireDuration = 5.0f;
+		TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (Notification.IsValid())
+		{
+			Notification->SetCompletionState(CompletionState);
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // FSplineActorDetailsCustomization
 
@@ -27,14 +57,15 @@ TSharedRef<IDetailCustomization> FSplineActorDetailsCustomization::MakeInstance(
 	return MakeShareable(new FSplineActorDetailsCustomization);
 }
 
+FSplineActorDetailsCustomization::FSplineActorDetailsCustomization()
+	: MyDetailLayout(nullptr)
+	, OffsetDistance(SplineActorDetailsCustomizationDefs::DefaultOffsetDistance)
+{
+}
+
 void FSplineActorDetailsCustomization::CustomizeDetails(IDetailLayoutBuilder& DetailLayout)
 {
 	const TArray< TWeakObjectPtr<UObject> >& SelectedObjects = DetailLayout.GetDetailsView()->GetSelectedObjects();
-	if (SelectedObjects.Num() > 1)
-	{
-		//Can only handle single selection
-		return;
-	}
 
 	// Don't show Spline Component, Spline Mesh Component, and Reset Spline to Default properties
 	DetailLayout.HideCategory(FName(TEXT("Spline")));
@@ -42,20 +73,24 @@ void FSplineActorDetailsCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 	// Add Spline actor category
 	IDetailCategoryBuilder& SplineActorCategory = DetailLayout.EditCategory("Spline Actor", FText::GetEmpty(), ECategoryPriority::Important);
 
-	ASplineActor* SplineActor = nullptr;
+	// Every selected spline actor takes part in the edits, the first one is the one shown in the editing widget
+	SelectedSplineActors.Reset();
+	TArray<ASplineActor*> OverlaySplineActors;
 	for (int32 ObjectIndex = 0; ObjectIndex < SelectedObjects.Num(); ++ObjectIndex)
 	{
 		UObject* TestObject = SelectedObjects[ObjectIndex].Get();
-		if (AActor* CurrentActor = Cast<AActor>(TestObject))
+		if (ASplineActor* TestSplineActor = Cast<ASplineActor>(TestObject))
 		{
-			if (ASplineActor* TestSplineActor = Cast<ASplineActor>(CurrentActor))
+			if (SelectedSplineActors.Num() > 0)
 			{
-				SplineActor = TestSplineActor;
-				break;
+				OverlaySplineActors.Add(TestSplineActor);
 			}
+			SelectedSplineActors.Add(TestSplineActor);
 		}
 	}
 
+	ASplineActor* SplineActor = (SelectedSplineActors.Num() > 0) ? SelectedSplineActors[0].Get() : nullptr;
+
 	if (SplineActor != nullptr)
 	{
 		FDetailWidgetRow& SplineEditWidgetCustomRow = SplineActorCategory.AddCustomRow(FText::GetEmpty());
@@ -68,6 +103,7 @@ void FSplineActorDetailsCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 			[
 				SAssignNew(SplineEditWidget, SSplineEditWidget)
 				.SplineActor(SplineActor)
+				.OverlaySplineActors(OverlaySplineActors)
 			];
 
 		if (SplineActor->SplineComponent != nullptr)
@@ -206,13 +242,26 @@ void FSplineActorDetailsCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 
 		];
 
+		// Add a table of every spline point, only the visible rows are generated so this stays fast on big outlines
+		FDetailWidgetRow& SplinePointListRow = SplineActorCategory.AddCustomRow(LOCTEXT("SplinePointsFilter", "Spline Points"));
+		SplinePointListRow.WholeRowContent()
+			[
+				SNew(SBox)
+				.HeightOverride(300.0f)
+				[
+					SNew(SSplinePointListView)
+					.SplineActor(SplineActor)
+					.OnSplinePointsEdited(FSimpleDelegate::CreateSP(this, &FSplineActorDetailsCustomization::OnSplinePointListEdited))
+				]
+			];
+
 		// Add button to invert the spline on the X axis
 		FDetailWidgetRow& SplineInvertXCustomRow = SplineActorCategory.AddCustomRow(FText::GetEmpty());
 		SplineInvertXCustomRow.WholeRowContent()
 			[
 				SNew(SButton)
 				.Text(LOCTEXT("InvertSplineX", "Invert Spline X"))
-				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::InvertSpline, SplineActor, ESplineInvertAxis::InvertX))
+				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::InvertSpline, ESplineInvertAxis::InvertX))
 			];
 
 		// Add button to invert the spline on the Y axis
@@ -221,7 +270,7 @@ void FSplineActorDetailsCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 			[
 				SNew(SButton)
 				.Text(LOCTEXT("InvertSplineY", "Invert Spline Y"))
-				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::InvertSpline, SplineActor, ESplineInvertAxis::InvertY))
+				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::InvertSpline, ESplineInvertAxis::InvertY))
 			];
 
 		// Reset spline
@@ -230,32 +279,104 @@ void FSplineActorDetailsCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 			[
 				SNew(SButton)
 				.Text(LOCTEXT("ResetSplineToDefault", "Reset Spline To Default"))
-				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::ResetSpline, SplineActor))
+				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::ResetSpline))
 			];
+
+		// Simplify spline, with the tolerance shared with the spline editing widget context menu
+		FDetailWidgetRow& SplineSimplifyRow = SplineActorCategory.AddCustomRow(LOCTEXT("SimplifySplineFilter", "Simplify Spline"));
+		SplineSimplifyRow.NameContent()
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("SimplifyTolerance", "Simplify Tolerance"))
+		];
+		SplineSimplifyRow.ValueContent()
+		.MaxDesiredWidth(10000)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			[
+				SNew(SNumericEntryBox<float>)
+				.Delta(0.01f)
+				.Value_Lambda([this]() { return SplineEditWidget.IsValid() ? SplineEditWidget->GetSimplifyTolerance() : TOptional<float>(); })
+				.OnValueCommitted_Lambda([this](float NewValue, ETextCommit::Type CommitType) { if (SplineEditWidget.IsValid()) { SplineEditWidget->SetSimplifyTolerance(NewValue); } })
+			]
+			+ SHorizontalBox::Slot()
+			.Padding(5, 0)
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("SimplifySpline", "Simplify Spline"))
+				.ToolTipText(LOCTEXT("SimplifySplineTooltip", "Remove as many spline points as possible while keeping the spline within the tolerance of its current shape."))
+				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::SimplifySpline))
+			]
+		];
+
+		// Offset copy, for rail guides and double sided walls
+		FDetailWidgetRow& SplineOffsetRow = SplineActorCategory.AddCustomRow(LOCTEXT("OffsetSplineFilter", "Offset Spline"));
+		SplineOffsetRow.NameContent()
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("OffsetDistance", "Offset Distance"))
+		];
+		SplineOffsetRow.ValueContent()
+		.MaxDesiredWidth(10000)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			[
+				SNew(SNumericEntryBox<float>)
+				.Delta(0.01f)
+				.Value_Lambda([this]() { return OffsetDistance; })
+				.OnValueCommitted_Lambda([this](float NewValue, ETextCommit::Type CommitType) { OffsetDistance = NewValue; })
+			]
+			+ SHorizontalBox::Slot()
+			.Padding(5, 0)
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("CreateOffsetCopy", "Create Offset Copy"))
+				.ToolTipText(LOCTEXT("CreateOffsetCopyTooltip", "Create a copy of the spline offset by this distance, outwards for closed splines and to the right for open splines. Use a negative distance to inset."))
+				.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::CreateOffsetCopy))
+			]
+		];
+
+		// Merging overlapping walls saves the draw calls, overdraw and double contacts of the overlap
+		FDetailWidgetRow& MergeWallsRow = SplineActorCategory.AddCustomRow(LOCTEXT("MergeWallsFilter", "Merge Walls"));
+		MergeWallsRow.ValueContent()
+		.MaxDesiredWidth(10000)
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("MergeSelectedWalls", "Merge Selected Walls"))
+			.ToolTipText(LOCTEXT("MergeSelectedWallsTooltip", "Replace the selected closed walls with the union of their outlines, one wall per connected piece. Holes are joined to the outline by a zero width bridge."))
+			.IsEnabled(this, &FSplineActorDetailsCustomization::CanMergeSelectedWalls)
+			.OnClicked(FOnClicked::CreateSP(this, &FSplineActorDetailsCustomization::MergeSelectedWalls))
+		];
 	}
 	
 
 	MyDetailLayout = &DetailLayout;
 }
 
-FReply FSplineActorDetailsCustomization::InvertSpline(ASplineActor* SplineActor, ESplineInvertAxis InvertAxis)
+FReply FSplineActorDetailsCustomization::InvertSpline(ESplineInvertAxis InvertAxis)
 {
-	// Scoped transaction for the undo buffer
+	// Scoped transaction for the undo buffer, one for all the selected splines
 	const FScopedTransaction Transaction(LOCTEXT("EditSplinePointType", "Invert Spline"));
 
-	// Notify the component and actor that they will be modified
-	SplineActor->SplineComponent->Modify();
-	if (AActor* Owner = SplineActor->SplineComponent->GetOwner())
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
 	{
-		Owner->Modify();
-	}
+		ASplineActor* SplineActor = SplineActorPtr.Get();
+		if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
+		{
+			continue;
+		}
+
+		const FScopedSplinePointsChange SplinePointsChange(SplineActor);
 
-	if (SplineActor->SplineComponent != nullptr)
-	{
 		TArray<FVector> SplinePointLocations;
 		TArray<FVector> SplinePointTangents;
 		TArray<FVector> SplinePointScales;
 		TArray<ESplinePointType::Type> SplinePointTypes;
+		TArray<FQuat> SplinePointRotations;
 
 		// Save info about the spline points
 		for (int32 SplinePointIndex = SplineActor->SplineComponent->GetNumberOfSplinePoints()-1; SplinePointIndex >= 0; --SplinePointIndex)
@@ -291,71 +412,328 @@ FReply FSplineActorDetailsCustomization::InvertSpline(ASplineActor* SplineActor,
 			SplinePointScales.Add(SplinePointScale);
 			ESplinePointType::Type SplinePointType = SplineActor->SplineComponent->GetSplinePointType(SplinePointIndex);
 			SplinePointTypes.Add(SplinePointType);
-		}
 
-		// Clear all the spline points temporarily
-		SplineActor->SplineComponent->ClearSplinePoints(false);
+			// Rotations are mirrored too, mirroring X negates the Y and Z parts of the quaternion, mirroring Y its X and Z parts
+			FQuat SplinePointRotation = SplineActor->SplineComponent->SplineCurves.Rotation.Points.IsValidIndex(SplinePointIndex) ? SplineActor->SplineComponent->SplineCurves.Rotation.Points[SplinePointIndex].OutVal : FQuat::Identity;
+			if (InvertAxis == ESplineInvertAxis::InvertX)
+			{
+				SplinePointRotation = FQuat(SplinePointRotation.X, -SplinePointRotation.Y, -SplinePointRotation.Z, SplinePointRotation.W);
+			}
+			else if (InvertAxis == ESplineInvertAxis::InvertY)
+			{
+				SplinePointRotation = FQuat(-SplinePointRotation.X, SplinePointRotation.Y, -SplinePointRotation.Z, SplinePointRotation.W);
+			}
+			SplinePointRotations.Add(SplinePointRotation);
+		}
 
 		// Add the spline points back in the reverse order (necessary so the triangles are calculated in the right order to display the cap mesh on the top facing upwards)
-		for (int32 SplinePointIndex = 0; SplinePointIndex < SplinePointLocations.Num(); ++SplinePointIndex)
+		// All points are replaced in one go, so the spline is only updated once
+		SplineActor->SetSplinePoints(SplinePointLocations, SplinePointTangents, SplinePointTypes, SplinePointScales, SplinePointRotations);
+	}
+
+	// Re-run the construction scripts once per actor, now that every spline has been edited
+	FinishSplineEdit(false);
+
+	return FReply::Handled();
+}
+
+FReply FSplineActorDetailsCustomization::ResetSpline()
+{
+	// Scoped transaction for the undo buffer, one for all the selected splines
+	const FScopedTransaction Transaction(LOCTEXT("ResetSplineTransaction", "Reset Spline Point"));
+
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
+	{
+		ASplineActor* SplineActor = SplineActorPtr.Get();
+		if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
 		{
-			SplineActor->SplineComponent->AddSplinePoint(SplinePointLocations[SplinePointIndex], ESplineCoordinateSpace::Local);
-			SplineActor->SplineComponent->SetTangentAtSplinePoint(SplinePointIndex, SplinePointTangents[SplinePointIndex], ESplineCoordinateSpace::Local);
-			SplineActor->SplineComponent->SetSplinePointType(SplinePointIndex, SplinePointTypes[SplinePointIndex]);
+			continue;
+		}
+
+		const FScopedSplinePointsChange SplinePointsChange(SplineActor);
 
-			// TODO: SetScale functions don't exist? Some information is getting lost without this...
-			//SplineActor->SplineComponent->SetScaleAtSplinePoint(SplinePointIndex, SplinePointScales[SplinePointIndex]);
+		// Start from the points of the blueprint default in one batch
+		SplineActor->ResetSplinePointsToDefault();
+
+		// The default may also be set by the blueprint construction script, so let the blueprint know to set it to the default with this boolean
+		SplineActor->bResetSplineToDefault = true;
+
+		SplineActor->SplineComponent->bSplineHasBeenEdited = true;
+	}
+
+	// Notify that the spline has been modified
+	// Don't call PostEditChangeProperty because it ends up forcing the spline edit widget to recalculate zoom & offset, so it makes you lose your place if you have zoomed or panned
+	//UClass* ActorClass = ASplineActor::StaticClass();
+	//UProperty* SplineInfoProperty = FindField<UProperty>(USplineComponent::StaticClass(), GET_MEMBER_NAME_CHECKED(USplineComponent, SplineInfo));
+	//FPropertyChangedEvent SplineInfoPropertyChangedEvent(SplineInfoProperty);
+	//Self->SplineActor->PostEditChangeProperty(SplineInfoPropertyChangedEvent);
+
+	// The construction scripts pick up bResetSplineToDefault
+	FinishSplineEdit(true);
+
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
+	{
+		if (ASplineActor* SplineActor = SplineActorPtr.Get())
+		{
+			SplineActor->bResetSplineToDefault = false;
 		}
 	}
+	
+	return FReply::Handled();
+}
 
-	// Notify of change so any CS is re-run
-	// Too slow to run every frame
-	SplineActor->PostEditMove(false);
+FReply FSplineActorDetailsCustomization::SimplifySpline()
+{
+	if (!SplineEditWidget.IsValid())
+	{
+		return FReply::Handled();
+	}
 
-	// Update the viewport
-	GEditor->RedrawLevelEditingViewports(true);
+	TArray<ASplineActor*> SplineActorsToSimplify;
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
+	{
+		if (ASplineActor* SplineActor = SplineActorPtr.Get())
+		{
+			SplineActorsToSimplify.Add(SplineActor);
+		}
+	}
 
-	// Rebuild the spline data
+	SSplineEditWidget::SimplifySplines(SplineActorsToSimplify, SplineEditWidget->GetSimplifyTolerance());
+
+	// Point indices don't match anymore, the construction scripts were already re-run with the simplification
+	SplineEditWidget->ClearSelectedSplinePointIndices();
+	GEditor->RedrawLevelEditingViewports(true);
 	SplineEditWidget->Rebuild2dSplineData(true, false);
 
 	return FReply::Handled();
 }
 
-FReply FSplineActorDetailsCustomization::ResetSpline(ASplineActor* SplineActor)
+FReply FSplineActorDetailsCustomization::CreateOffsetCopy()
 {
-	// Scoped transaction for the undo buffer
-	const FScopedTransaction Transaction(LOCTEXT("ResetSplineTransaction", "Reset Spline Point"));
-	SplineActor->SplineComponent->Modify();
-	if (AActor* Owner = SplineActor->SplineComponent->GetOwner())
+	const FScopedTransaction Transaction(LOCTEXT("CreateOffsetCopyTransaction", "Create Offset Spline Copy"));
+
+	TArray<ASplineActor*> OffsetCopies;
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
 	{
-		Owner->Modify();
+		ASplineActor* SplineActor = SplineActorPtr.Get();
+		if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr || SplineActor->GetWorld() == nullptr)
+		{
+			continue;
+		}
+
+		// Copy everything from the source actor, but only run the construction script once the offset points are set
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.Template = SplineActor;
+		SpawnParameters.bDeferConstruction = true;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		const FTransform SpawnTransform = SplineActor->GetActorTransform();
+
+		ASplineActor* OffsetCopy = SplineActor->GetWorld()->SpawnActor<ASplineActor>(SplineActor->GetClass(), SpawnTransform, SpawnParameters);
+		if (OffsetCopy == nullptr || OffsetCopy->SplineComponent == nullptr)
+		{
+			continue;
+		}
+
+		OffsetCopy->SetSplinePointsFromOffset(SplineActor->SplineComponent, OffsetDistance);
+		OffsetCopy->FinishSpawning(SpawnTransform);
+		OffsetCopy->SetActorLabel(SplineActor->GetActorLabel() + TEXT("_Offset"));
+		OffsetCopies.Add(OffsetCopy);
 	}
 
-	// The default is stored in the blueprint, so we just let the blueprint know to set it to the default with this boolean
-	SplineActor->bResetSplineToDefault = true;
+	// Select the copies so they can be adjusted straight away
+	if (OffsetCopies.Num() > 0)
+	{
+		GEditor->SelectNone(false, true);
+		for (ASplineActor* OffsetCopy : OffsetCopies)
+		{
+			GEditor->SelectActor(OffsetCopy, true, false);
+		}
+		GEditor->NoteSelectionChange();
+	}
 
-	SplineActor->SplineComponent->bSplineHasBeenEdited = true;
+	GEditor->RedrawLevelEditingViewports(true);
 
-	// Notify that the spline has been modified
-	// Don't call this because it ends up forcing the spline edit widget to recalculate zoom & offset, so it makes you lose your place if you have zoomed or panned
-	//UClass* ActorClass = ASplineActor::StaticClass();
-	//UProperty* SplineInfoProperty = FindField<UProperty>(USplineComponent::StaticClass(), GET_MEMBER_NAME_CHECKED(USplineComponent, SplineInfo));
-	//FPropertyChangedEvent SplineInfoPropertyChangedEvent(SplineInfoProperty);
-	//Self->SplineActor->PostEditChangeProperty(SplineInfoPropertyChangedEvent);
+	return FReply::Handled();
+}
+
+bool FSplineActorDetailsCustomization::CanMergeSelectedWalls() const
+{
+	int32 NumClosedWalls = 0;
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
+	{
+		const AWallActor* Wall = Cast<AWallActor>(SplineActorPtr.Get());
+		if (Wall != nullptr && Wall->SplineComponent != nullptr && Wall->SplineComponent->IsClosedLoop())
+		{
+			++NumClosedWalls;
+		}
+	}
+	return NumClosedWalls >= 2;
+}
+
+FReply FSplineActorDetailsCustomization::MergeSelectedWalls()
+{
+	using namespace SplineActorDetailsCustomizationDefs;
+
+	TArray<AWallActor*> Walls;
+	TArray<TArray<FVector2D>> Outlines;
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
+	{
+		AWallActor* Wall = Cast<AWallActor>(SplineActorPtr.Get());
+		if (Wall == nullptr || Wall->SplineComponent == nullptr || !Wall->SplineComponent->IsClosedLoop() || Wall->GetWorld() == nullptr)
+		{
+			continue;
+		}
+
+		TArray<FVector2D> Outline;
+		if (UGeometryBlueprintLibrary::GetSplineOutline(Outline, Wall->SplineComponent, MergeSamplesPerSegment))
+		{
+			Walls.Add(Wall);
+			Outlines.Add(MoveTemp(Outline));
+		}
+	}
+
+	if (Walls.Num() < 2)
+	{
+		ShowNotification(LOCTEXT("MergeWallsNotEnough", "Select at least two closed walls to merge"), SNotificationItem::CS_Fail);
+		return FReply::Handled();
+	}
 
-	// Notify of change so any CS is re-run
-	// Too slow to run every frame
-	SplineActor->PostEditMove(false);
+	const double StartTime = FPlatformTime::Seconds();
 
+	TArray<FPolygonWithHoles> MergedPolygons;
+	FPolygonClipping::Union(Outlines, MergedPolygons);
+
+	// Make sure every cap triangulates before changing the level
+	TArray<TArray<FVector2D>> MergedOutlines;
+	TArray<FVector2D> Triangles;
+	int32 NumHoles = 0;
+	for (FPolygonWithHoles& MergedPolygon : MergedPolygons)
+	{
+		FPolygonClipping::RemoveCollinearVertices(MergedPolygon.Outer, MergeCollinearTolerance);
+		for (TArray<FVector2D>& Hole : MergedPolygon.Holes)
+		{
+			FPolygonClipping::RemoveCollinearVertices(Hole, MergeCollinearTolerance);
+		}
+		NumHoles += MergedPolygon.Holes.Num();
+
+		TArray<FVector2D>& MergedOutline = MergedOutlines.AddDefaulted_GetRef();
+		FPolygonClipping::MakeKeyholePolygon(MergedPolygon, MergedOutline);
+		if (!UGeometryBlueprintLibrary::TriangulatePoly(Triangles, MergedOutline, false))
+		{
+			ShowNotification(LOCTEXT("MergeWallsTriangulationFailed", "The merged wall outline can't be triangulated, the walls were left as they are"), SNotificationItem::CS_Fail);
+			return FReply::Handled();
+		}
+	}
+
+	if (MergedOutlines.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("MergeWallsTransaction", "Merge Walls"));
+
+	// The merged walls copy the first selected wall, their points are in the space of its spline
+	AWallActor* TemplateWall = Walls[0];
+	UWorld* World = TemplateWall->GetWorld();
+	const FTransform SpawnTransform = TemplateWall->GetActorTransform();
+	const FTransform SplineTransform = TemplateWall->SplineComponent->GetComponentTransform();
+	const float OutlineZ = TemplateWall->SplineComponent->GetLocationAtSplinePoint(0, ESplineCoordinateSpace::World).Z;
+
+	TArray<ASplineActor*> MergedWalls;
+	int32 NumMergedPoints = 0;
+	for (const TArray<FVector2D>& MergedOutline : MergedOutlines)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.Template = TemplateWall;
+		SpawnParameters.bDeferConstruction = true;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		AWallActor* MergedWall = World->SpawnActor<AWallActor>(TemplateWall->GetClass(), SpawnTransform, SpawnParameters);
+		if (MergedWall == nullptr || MergedWall->SplineComponent == nullptr)
+		{
+			continue;
+		}
+
+		// Straight points on the merged outline, so the caps triangulate exactly as checked above
+		TArray<FVector> Locations;
+		TArray<FVector> Tangents;
+		TArray<ESplinePointType::Type> Types;
+		Locations.Reserve(MergedOutline.Num());
+		for (const FVector2D& Vertex : MergedOutline)
+		{
+			Locations.Add(SplineTransform.InverseTransformPosition(FVector(Vertex, OutlineZ)));
+		}
+		Tangents.Init(FVector::ZeroVector, Locations.Num());
+		Types.Init(ESplinePointType::Linear, Locations.Num());
+
+		MergedWall->SplineComponent->SetClosedLoop(true, false);
+		MergedWall->SetSplinePoints(Locations, Tangents, Types, TArray<FVector>());
+		MergedWall->FinishSpawning(SpawnTransform);
+		MergedWall->SetActorLabel(TemplateWall->GetActorLabel() + TEXT("_Merged"));
+		MergedWalls.Add(MergedWall);
+		NumMergedPoints += Locations.Num();
+	}
+
+	if (MergedWalls.Num() == 0)
+	{
+		return FReply::Handled();
+	}
+
+	for (AWallActor* Wall : Walls)
+	{
+		World->EditorDestroyActor(Wall, true);
+	}
+
+	GEditor->SelectNone(false, true);
+	for (ASplineActor* MergedWall : MergedWalls)
+	{
+		GEditor->SelectActor(MergedWall, true, false);
+	}
+	GEditor->NoteSelectionChange();
 	GEditor->RedrawLevelEditingViewports(true);
 
-	SplineEditWidget->Rebuild2dSplineData(true, true);
+	FFormatNamedArguments Arguments;
+	Arguments.Add(TEXT("NumWalls"), Walls.Num());
+	Arguments.Add(TEXT("NumMergedWalls"), MergedWalls.Num());
+	Arguments.Add(TEXT("NumHoles"), NumHoles);
+	Arguments.Add(TEXT("NumPoints"), NumMergedPoints);
+	Arguments.Add(TEXT("Milliseconds"), FText::AsNumber((FPlatformTime::Seconds() - StartTime) * 1000.0));
+	ShowNotification(FText::Format(LOCTEXT("MergeWallsResult", "Merged {NumWalls} walls into {NumMergedWalls} with {NumHoles} hole(s) and {NumPoints} spline points in {Milliseconds}ms"), Arguments), SNotificationItem::CS_Success);
 
-	SplineActor->bResetSplineToDefault = false;
-	
 	return FReply::Handled();
 }
 
+void FSplineActorDetailsCustomization::FinishSplineEdit(bool bRecalculateZoomFactor)
+{
+	for (const TWeakObjectPtr<ASplineActor>& SplineActorPtr : SelectedSplineActors)
+	{
+		if (ASplineActor* SplineActor = SplineActorPtr.Get())
+		{
+			// Notify of change so any CS is re-run
+			// Too slow to run every frame
+			SplineActor->PostEditMove(false);
+		}
+	}
+
+	// Update the viewport
+	GEditor->RedrawLevelEditingViewports(true);
+
+	// Rebuild the spline data
+	if (SplineEditWidget.IsValid())
+	{
+		SplineEditWidget->Rebuild2dSplineData(true, bRecalculateZoomFactor);
+	}
+}
+
+void FSplineActorDetailsCustomization::OnSplinePointListEdited()
+{
+	// The list already re-ran the construction script, the view of the widget stays where it is
+	if (SplineEditWidget.IsValid())
+	{
+		SplineEditWidget->Rebuild2dSplineData(false, false);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 #undef LOCTEXT_NAMESPACE
@@ -23,6 +23,8 @@ public:
 	// Makes a new instance of this detail layout class for a specific detail view requesting it
 	static TSharedRef<IDetailCustomization> MakeInstance();
 
+	FSplineActorDetailsCustomization();
+
 	// IDetailCustomization interface
 	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailLayout) override;
 	// End of IDetailCustomization interface
@@ -31,12 +33,36 @@ private:
 
 	IDetailLayoutBuilder* MyDetailLayout;
 
-	/** Invert the spline on the specified axis */
-	FReply InvertSpline(ASplineActor* SplineActor, ESplineInvertAxis InvertAxis);
+	/** Invert all the selected splines on the specified axis */
+	FReply InvertSpline(ESplineInvertAxis InvertAxis);
+
+	/** Reset all the selected splines to the default */
+	FReply ResetSpline();
+
+	/** Simplify all the selected splines with the tolerance of the spline editing widget */
+	FReply SimplifySpline();
+
+	/** Spawn a copy of every selected spline actor with its spline offset by OffsetDistance */
+	FReply CreateOffsetCopy();
+
+	/** Replace the selected closed walls with one wall per connected piece of the union of their outlines */
+	FReply MergeSelectedWalls();
 
-	/** Reset this spline to the default */
-	FReply ResetSpline(ASplineActor* SplineActor);
+	/** Whether enough closed walls are selected to merge them */
+	bool CanMergeSelectedWalls() const;
+
+	/** Notify of change so any CS is re-run, once per selected actor, and update the viewport and spline edit widget */
+	void FinishSplineEdit(bool bRecalculateZoomFactor);
+
+	/** Update the spline edit widget with the points edited in the spline point list */
+	void OnSplinePointListEdited();
+
+	/** All the selected Spline Actors, the first one is edited in the spline editing widget */
+	TArray<TWeakObjectPtr<ASplineActor>> SelectedSplineActors;
 
 	/** The spline editing widget in the details panel */
 	TSharedPtr<SSplineEditWidget> SplineEditWidget;
+
+	/** Distance used by CreateOffsetCopy */
+	float OffsetDistance;
 };
@@ -0,0 +1,228 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "SplinePointsChange.h"
+#include "SplineActor.h"
+#include "Components/SplineComponent.h"
+#include "Misc/ITransaction.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSplinePointsChange, Log, All);
+
+namespace SplinePointsChangeDefs
+{
+	template<typename T>
+	bool ArePointsEqual(const FInterpCurvePoint<T>& A, const FInterpCurvePoint<T>& B)
+	{
+		return A.OutVal == B.OutVal && A.ArriveTangent == B.ArriveTangent && A.LeaveTangent == B.LeaveTangent && A.InterpMode == B.InterpMode;
+	}
+
+	/** Removes Count points at Index of a curve and inserts the given points there */
+	template<typename T>
+	void SplicePoints(TArray<FInterpCurvePoint<T>>& Points, int32 Index, int32 Count, const TArray<FSplinePointValues>& InsertedPoints, FInterpCurvePoint<T> FSplinePointValues::*Member)
+	{
+		Points.RemoveAt(Index, Count, false);
+		Points.InsertUninitialized(Index, InsertedPoints.Num());
+		for (int32 InsertedIndex = 0; InsertedIndex < InsertedPoints.Num(); ++InsertedIndex)
+		{
+			new(&Points[Index + InsertedIndex]) FInterpCurvePoint<T>(InsertedPoints[InsertedIndex].*Member);
+		}
+	}
+}
+
+bool FSplinePointValues::operator==(const FSplinePointValues& Other) const
+{
+	using namespace SplinePointsChangeDefs;
+	return ArePointsEqual(Position, Other.Position) && ArePointsEqual(Rotation, Other.Rotation) && ArePointsEqual(Scale, Other.Scale);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FSplinePointsChange
+
+FSplinePointsChange::FSplinePointsChange(int32 InNumPointsBefore, int32 InNumPointsAfter, bool bInSplineHasBeenEditedBefore, bool bInSplineHasBeenEditedAfter, TArray<FSplinePointDelta>&& InDeltas,
+	int32 InSpliceIndex, TArray<FSplinePointValues>&& InRemovedPoints, TArray<FSplinePointValues>&& InInsertedPoints)
+	: NumPointsBefore(InNumPointsBefore)
+	, NumPointsAfter(InNumPointsAfter)
+	, bSplineHasBeenEditedBefore(bInSplineHasBeenEditedBefore)
+	, bSplineHasBeenEditedAfter(bInSplineHasBeenEditedAfter)
+	, Deltas(MoveTemp(InDeltas))
+	, SpliceIndex(InSpliceIndex)
+	, RemovedPoints(MoveTemp(InRemovedPoints))
+	, InsertedPoints(MoveTemp(InInsertedPoints))
+{
+}
+
+void FSplinePointsChange::Apply(UObject* Object)
+{
+	ApplySplinePoints(Object, true);
+}
+
+void FSplinePointsChange::Revert(UObject* Object)
+{
+	ApplySplinePoints(Object, false);
+}
+
+FString FSplinePointsChange::ToString() const
+{
+	return FString::Printf(TEXT("Spline Points Change (%d point(s), %d bytes)"), GetNumStoredPoints(), (int32)GetTransactionByteSize());
+}
+
+SIZE_T FSplinePointsChange::GetTransactionByteSize() const
+{
+	return sizeof(*this) + Deltas.GetAllocatedSize() + RemovedPoints.GetAllocatedSize() + InsertedPoints.GetAllocatedSize();
+}
+
+void FSplinePointsChange::ApplySplinePoints(UObject* Object, bool bApplyAfter) const
+{
+	ASplineActor* SplineActor = Cast<ASplineActor>(Object);
+	if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
+	{
+		return;
+	}
+
+	USplineComponent* SplineComponent = SplineActor->SplineComponent;
+	FSplineCurves& SplineCurves = SplineComponent->SplineCurves;
+
+	// The stored span replaces the one of the other side, the points after it shift with it
+	if (RemovedPoints.Num() > 0 || InsertedPoints.Num() > 0)
+	{
+		using namespace SplinePointsChangeDefs;
+		const TArray<FSplinePointValues>& FromPoints = bApplyAfter ? RemovedPoints : InsertedPoints;
+		const TArray<FSplinePointValues>& ToPoints = bApplyAfter ? InsertedPoints : RemovedPoints;
+		SplineCurves.Rotation.Points.SetNum(SplineCurves.Position.Points.Num());
+		SplineCurves.Scale.Points.SetNum(SplineCurves.Position.Points.Num());
+		SplicePoints(SplineCurves.Position.Points, SpliceIndex, FromPoints.Num(), ToPoints, &FSplinePointValues::Position);
+		SplicePoints(SplineCurves.Rotation.Points, SpliceIndex, FromPoints.Num(), ToPoints, &FSplinePointValues::Rotation);
+		SplicePoints(SplineCurves.Scale.Points, SpliceIndex, FromPoints.Num(), ToPoints, &FSplinePointValues::Scale);
+
+		// The keys of the shifted points are those of their old indices
+		for (int32 Index = 0; Index < SplineCurves.Position.Points.Num(); ++Index)
+		{
+			SplineCurves.Position.Points[Index].InVal = Index;
+			SplineCurves.Rotation.Points[Index].InVal = Index;
+			SplineCurves.Scale.Points[Index].InVal = Index;
+		}
+	}
+
+	const int32 NumPoints = bApplyAfter ? NumPointsAfter : NumPointsBefore;
+	SplineCurves.Position.Points.SetNum(NumPoints);
+	SplineCurves.Rotation.Points.SetNum(NumPoints);
+	SplineCurves.Scale.Points.SetNum(NumPoints);
+
+	for (const FSplinePointDelta& Delta : Deltas)
+	{
+		if (Delta.Index < NumPoints)
+		{
+			const FSplinePointValues& Values = bApplyAfter ? Delta.After : Delta.Before;
+			SplineCurves.Position.Points[Delta.Index] = Values.Position;
+			SplineCurves.Rotation.Points[Delta.Index] = Values.Rotation;
+			SplineCurves.Scale.Points[Delta.Index] = Values.Scale;
+		}
+	}
+
+	SplineComponent->bSplineHasBeenEdited = bApplyAfter ? bSplineHasBeenEditedAfter : bSplineHasBeenEditedBefore;
+	SplineComponent->UpdateSpline();
+
+	// Nothing was snapshotted by Modify, so the package isn't dirtied by the transaction itself
+	SplineActor->MarkPackageDirty();
+
+	// Notify of change so any ConstructionScript is re-run
+	SplineActor->PostEditMove(false);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FScopedSplinePointsChange
+
+FScopedSplinePointsChange::FScopedSplinePointsChange(ASplineActor* InSplineActor)
+	: SplineActor(InSplineActor)
+	, bSplineHasBeenEditedBefore(false)
+	, bRecording(false)
+{
+	if (GUndo != nullptr && SplineActor != nullptr && SplineActor->SplineComponent != nullptr)
+	{
+		bRecording = true;
+		GetSplinePointValues(SplineActor, SplinePointValuesBefore);
+		bSplineHasBeenEditedBefore = SplineActor->SplineComponent->bSplineHasBeenEdited;
+	}
+}
+
+FScopedSplinePointsChange::~FScopedSplinePointsChange()
+{
+	if (!bRecording || GUndo == nullptr || !IsValid(SplineActor) || SplineActor->SplineComponent == nullptr)
+	{
+		return;
+	}
+
+	TArray<FSplinePointValues> SplinePointValuesAfter;
+	GetSplinePointValues(SplineActor, SplinePointValuesAfter);
+
+	// Points unchanged at the start and the end are left out, so inserting or removing a point doesn't store every point after it
+	const int32 NumPointsBefore = SplinePointValuesBefore.Num();
+	const int32 NumPointsAfter = SplinePointValuesAfter.Num();
+	const int32 MinNumPoints = FMath::Min(NumPointsBefore, NumPointsAfter);
+	int32 NumSamePrefix = 0;
+	while (NumSamePrefix < MinNumPoints && SplinePointValuesBefore[NumSamePrefix] == SplinePointValuesAfter[NumSamePrefix])
+	{
+		++NumSamePrefix;
+	}
+	int32 NumSameSuffix = 0;
+	while (NumSameSuffix < MinNumPoints - NumSamePrefix
+		&& SplinePointValuesBefore[NumPointsBefore - 1 - NumSameSuffix] == SplinePointValuesAfter[NumPointsAfter - 1 - NumSameSuffix])
+	{
+		++NumSameSuffix;
+	}
+
+	TArray<FSplinePointDelta> Deltas;
+	TArray<FSplinePointValues> RemovedPoints;
+	TArray<FSplinePointValues> InsertedPoints;
+	if (NumPointsBefore == NumPointsAfter)
+	{
+		// Same points moved, only the different ones of the span are kept
+		for (int32 Index = NumSamePrefix; Index < NumPointsAfter - NumSameSuffix; ++Index)
+		{
+			if (SplinePointValuesBefore[Index] != SplinePointValuesAfter[Index])
+			{
+				FSplinePointDelta& Delta = Deltas.AddDefaulted_GetRef();
+				Delta.Index = Index;
+				Delta.Before = SplinePointValuesBefore[Index];
+				Delta.After = SplinePointValuesAfter[Index];
+			}
+		}
+	}
+	else
+	{
+		RemovedPoints.Append(SplinePointValuesBefore.GetData() + NumSamePrefix, NumPointsBefore - NumSameSuffix - NumSamePrefix);
+		InsertedPoints.Append(SplinePointValuesAfter.GetData() + NumSamePrefix, NumPointsAfter - NumSameSuffix - NumSamePrefix);
+	}
+
+	const bool bSplineHasBeenEditedAfter = SplineActor->SplineComponent->bSplineHasBeenEdited;
+	if (Deltas.Num() == 0 && NumPointsBefore == NumPointsAfter && bSplineHasBeenEditedBefore == bSplineHasBeenEditedAfter)
+	{
+		// Nothing changed, nothing to undo
+		return;
+	}
+
+	Deltas.Shrink();
+	TUniquePtr<FSplinePointsChange> Change = MakeUnique<FSplinePointsChange>(NumPointsBefore, NumPointsAfter, bSplineHasBeenEditedBefore, bSplineHasBeenEditedAfter, MoveTemp(Deltas),
+		NumSamePrefix, MoveTemp(RemovedPoints), MoveTemp(InsertedPoints));
+
+	UE_LOG(LogSplinePointsChange, Verbose, TEXT("%s: stored %d of %d spline point(s) in %d bytes"),
+		*SplineActor->GetName(), Change->GetNumStoredPoints(), FMath::Max(NumPointsBefore, NumPointsAfter), (int32)Change->GetTransactionByteSize());
+
+	GUndo->StoreUndo(SplineActor, MoveTemp(Change));
+
+	// Modify would have dirtied the package, without it the edit could be lost on closing the editor
+	SplineActor->MarkPackageDirty();
+}
+
+void FScopedSplinePointsChange::GetSplinePointValues(const ASplineActor* InSplineActor, TArray<FSplinePointValues>& OutSplinePointValues)
+{
+	const FSplineCurves& SplineCurves = InSplineActor->SplineComponent->SplineCurves;
+	const int32 NumPoints = SplineCurves.Position.Points.Num();
+
+	OutSplinePointValues.SetNum(NumPoints);
+	for (int32 Index = 0; Index < NumPoints; ++Index)
+	{
+		OutSplinePointValues[Index].Position = SplineCurves.Position.Points[Index];
+		OutSplinePointValues[Index].Rotation = SplineCurves.Rotation.Points.IsValidIndex(Index) ? SplineCurves.Rotation.Points[Index] : FInterpCurvePoint<FQuat>(Index, FQuat::Identity);
+		OutSplinePointValues[Index].Scale = SplineCurves.Scale.Points.IsValidIndex(Index) ? SplineCurves.Scale.Points[Index] : FInterpCurvePoint<FVector>(Index, FVector(1.0f));
+	}
+}
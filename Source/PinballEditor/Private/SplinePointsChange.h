@@ -0,0 +1,111 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Change.h"
+#include "Math/InterpCurvePoint.h"
+
+class ASplineActor;
+
+/**
+ * Everything stored for a single spline point, one point of each spline curve
+ * Points compare equal regardless of their input keys, which are their indices rebuilt by UpdateSpline
+ */
+struct FSplinePointValues
+{
+	FInterpCurvePoint<FVector> Position;
+	FInterpCurvePoint<FQuat> Rotation;
+	FInterpCurvePoint<FVector> Scale;
+
+	bool operator==(const FSplinePointValues& Other) const;
+	bool operator!=(const FSplinePointValues& Other) const { return !(*this == Other); }
+};
+
+/** Before and after values of one spline point that was changed by an edit */
+struct FSplinePointDelta
+{
+	int32 Index;
+
+	/** Only valid if the point existed before the edit */
+	FSplinePointValues Before;
+
+	/** Only valid if the point exists after the edit */
+	FSplinePointValues After;
+};
+
+/**
+ * Undo record for an edit of the points of a spline actor
+ * Only the points that changed are stored, instead of the full serialized state of the actor and its spline component
+ * Edits that add or remove points store the span between the points unchanged at the start and the end, spliced in on undo and redo
+ * bResetSplineToDefault isn't stored, it only tells the next construction script run to reset the points, and the points it reset to are
+ */
+class FSplinePointsChange : public FCommandChange
+{
+public:
+
+	FSplinePointsChange(int32 InNumPointsBefore, int32 InNumPointsAfter, bool bInSplineHasBeenEditedBefore, bool bInSplineHasBeenEditedAfter, TArray<FSplinePointDelta>&& InDeltas,
+		int32 InSpliceIndex, TArray<FSplinePointValues>&& InRemovedPoints, TArray<FSplinePointValues>&& InInsertedPoints);
+
+	// FChange interface
+	virtual void Apply(UObject* Object) override;
+	virtual void Revert(UObject* Object) override;
+	virtual FString ToString() const override;
+	// End of FChange interface
+
+	/** Number of bytes used by this record in the transaction buffer */
+	SIZE_T GetTransactionByteSize() const;
+
+	/** Number of points stored by this record */
+	int32 GetNumStoredPoints() const { return Deltas.Num() + RemovedPoints.Num() + InsertedPoints.Num(); }
+
+private:
+
+	/** Set the spline points of the actor to either side of this change and notify of the edit */
+	void ApplySplinePoints(UObject* Object, bool bApplyAfter) const;
+
+	int32 NumPointsBefore;
+	int32 NumPointsAfter;
+
+	bool bSplineHasBeenEditedBefore;
+	bool bSplineHasBeenEditedAfter;
+
+	/** Changed points, sorted by index, when the edit kept the number of points */
+	TArray<FSplinePointDelta> Deltas;
+
+	/** Index of the first point that differs, when the edit added or removed points */
+	int32 SpliceIndex;
+
+	/** Points from SpliceIndex before the edit, up to the unchanged points at the end */
+	TArray<FSplinePointValues> RemovedPoints;
+
+	/** Points from SpliceIndex after the edit, up to the unchanged points at the end */
+	TArray<FSplinePointValues> InsertedPoints;
+};
+
+/**
+ * Records the spline points of a spline actor when constructed, and stores a FSplinePointsChange with only the changed points
+ * into the current transaction when destroyed. Use in place of calling Modify on the spline actor and its spline component,
+ * whose full serialized state would be stored for every edit, however few points it changed.
+ * Marks the package of the actor dirty when it stores a change, as Modify would have.
+ * Must be destroyed before the transaction it is recorded into ends.
+ */
+class FScopedSplinePointsChange
+{
+public:
+
+	explicit FScopedSplinePointsChange(ASplineActor* InSplineActor);
+	~FScopedSplinePointsChange();
+
+private:
+
+	/** Current values of every point of the spline */
+	static void GetSplinePointValues(const ASplineActor* InSplineActor, TArray<FSplinePointValues>& OutSplinePointValues);
+
+	ASplineActor* SplineActor;
+
+	/** Values when this was constructed, empty if there is no transaction to record into */
+	TArray<FSplinePointValues> SplinePointValuesBefore;
+	bool bSplineHasBeenEditedBefore;
+	bool bRecording;
+};
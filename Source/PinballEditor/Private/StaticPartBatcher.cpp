@@ -0,0 +1,276 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "StaticPartBatcher.h"
+#include "PinballPartBatchActor.h"
+#include "SplineActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Selection.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "EngineUtils.h"
+#include "Editor.h"
+#include "ScopedTransaction.h"
+
+#define LOCTEXT_NAMESPACE "StaticPartBatcher"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStaticPartBatcher, Log, All);
+
+namespace StaticPartBatcherDefs
+{
+	/** Parts whose meshes are used by fewer actors than this aren't worth an instanced component */
+	const int32 DefaultMinInstances = 2;
+
+	/** Label of the spawned batch actor */
+	const TCHAR* BatchActorLabel = TEXT("PinballPartBatch");
+
+	/** Whether a class has Blueprint events that would stop running once its actors are batched */
+	bool HasGameplayScript(const UClass* Class)
+	{
+		// Some of these events are protected, so they can't be checked with GET_FUNCTION_NAME_CHECKED
+		static const FName ScriptEventNames[] =
+		{
+			TEXT("ReceiveBeginPlay"),
+			TEXT("ReceiveTick"),
+			TEXT("ReceiveActorBeginOverlap"),
+			TEXT("ReceiveHit"),
+		};
+
+		for (const FName& ScriptEventName : ScriptEventNames)
+		{
+			if (Class->IsFunctionImplementedInScript(ScriptEventName))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+bool FStaticPartBatcher::GetBatchableMeshComponents(AActor* Actor, bool bAllowScriptedActors, TArray<UStaticMeshComponent*>& OutMeshComponents)
+{
+	using namespace StaticPartBatcherDefs;
+
+	OutMeshComponents.Reset();
+
+	if (Actor == nullptr || Actor->IsPendingKill() || Actor->IsA<APinballPartBatchActor>() || Actor->IsA<ASplineActor>() || Actor->IsA<APawn>())
+	{
+		return false;
+	}
+
+	if (!bAllowScriptedActors && (Actor->PrimaryActorTick.bCanEverTick || HasGameplayScript(Actor->GetClass())))
+	{
+		return false;
+	}
+
+	// Only plain scene components and static meshes that don't move, anything else would be lost
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+	for (UActorComponent* Component : Components)
+	{
+		if (UStaticMeshComponent* MeshComponent = ExactCast<UStaticMeshComponent>(Component))
+		{
+			if (MeshComponent->Mobility == EComponentMobility::Movable || MeshComponent->GetStaticMesh() == nullptr || !MeshComponent->IsVisible())
+			{
+				return false;
+			}
+			OutMeshComponents.Add(MeshComponent);
+		}
+		else if (Component->GetClass() != USceneComponent::StaticClass() && !Component->IsEditorOnly())
+		{
+			return false;
+		}
+	}
+
+	return OutMeshComponents.Num() > 0;
+}
+
+int32 FStaticPartBatcher::BatchActors(UWorld* World, const TArray<AActor*>& Actors, bool bAllowScriptedActors, int32 MinInstances)
+{
+	using namespace StaticPartBatcherDefs;
+
+	if (World == nullptr)
+	{
+		return 0;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FPinballDrawCallStats StatsBefore = APinballPartBatchActor::EstimateDrawCalls(World);
+
+	// Parts only go into the batch actor of the persistent level
+	TArray<AActor*> BatchableActors;
+	TArray<TArray<UStaticMeshComponent*>> BatchableMeshComponents;
+	TMap<const UStaticMesh*, int32> NumMeshInstances;
+	for (AActor* Actor : Actors)
+	{
+		TArray<UStaticMeshComponent*> MeshComponents;
+		if (Actor != nullptr && Actor->GetLevel() == World->PersistentLevel && GetBatchableMeshComponents(Actor, bAllowScriptedActors, MeshComponents))
+		{
+			for (const UStaticMeshComponent* MeshComponent : MeshComponents)
+			{
+				++NumMeshInstances.FindOrAdd(MeshComponent->GetStaticMesh());
+			}
+			BatchableActors.Add(Actor);
+			BatchableMeshComponents.Add(MoveTemp(MeshComponents));
+		}
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("BatchStaticPartsTransaction", "Batch Static Parts"));
+
+	APinballPartBatchActor* BatchActor = nullptr;
+	int32 NumBatchedActors = 0;
+	TMap<const UClass*, int32> NumStrippedScriptedActors;
+	for (int32 ActorIndex = 0; ActorIndex < BatchableActors.Num(); ++ActorIndex)
+	{
+		AActor* Actor = BatchableActors[ActorIndex];
+		const TArray<UStaticMeshComponent*>& MeshComponents = BatchableMeshComponents[ActorIndex];
+
+		// Every mesh of the part has to be shared with enough other parts
+		const bool bShared = !MeshComponents.ContainsByPredicate([&NumMeshInstances, MinInstances](const UStaticMeshComponent* MeshComponent)
+		{
+			return NumMeshInstances.FindRef(MeshComponent->GetStaticMesh()) < MinInstances;
+		});
+		if (!bShared)
+		{
+			continue;
+		}
+
+		if (BatchActor == nullptr)
+		{
+			BatchActor = FindOrSpawnBatchActor(World);
+			if (BatchActor == nullptr)
+			{
+				return 0;
+			}
+		}
+
+		if (bAllowScriptedActors && (Actor->PrimaryActorTick.bCanEverTick || HasGameplayScript(Actor->GetClass())))
+		{
+			++NumStrippedScriptedActors.FindOrAdd(Actor->GetClass());
+		}
+
+		BatchActor->AddPart(FName(*Actor->GetActorLabel()), Actor->Tags, MeshComponents);
+		World->EditorDestroyActor(Actor, true);
+		++NumBatchedActors;
+	}
+
+	// Their BeginPlay, tick, overlap and hit logic is gone with them, and has to be driven through the batch actor
+	for (const TPair<const UClass*, int32>& StrippedClass : NumStrippedScriptedActors)
+	{
+		UE_LOG(LogStaticPartBatcher, Warning, TEXT("Batched %d actor(s) of %s, its tick and Blueprint events no longer run"),
+			StrippedClass.Value, *StrippedClass.Key->GetPathName());
+	}
+
+	const FPinballDrawCallStats StatsAfter = APinballPartBatchActor::EstimateDrawCalls(World);
+
+	UE_LOG(LogStaticPartBatcher, Log, TEXT("Batched %d of %d actor(s) into %d instanced component(s) in %.3fs"),
+		NumBatchedActors, Actors.Num(), (BatchActor != nullptr) ? BatchActor->PartComponents.Num() : 0, FPlatformTime::Seconds() - StartTime);
+	UE_LOG(LogStaticPartBatcher, Log, TEXT("%s: primitives %d -> %d, estimated draw calls %d -> %d, measure with stat RHI in a viewport"),
+		*World->GetMapName(), StatsBefore.NumPrimitives, StatsAfter.NumPrimitives, StatsBefore.NumDrawCalls, StatsAfter.NumDrawCalls);
+
+	if (NumBatchedActors > 0)
+	{
+		GEditor->RedrawLevelEditingViewports(true);
+	}
+
+	return NumBatchedActors;
+}
+
+APinballPartBatchActor* FStaticPartBatcher::FindOrSpawnBatchActor(UWorld* World)
+{
+	for (TActorIterator<APinballPartBatchActor> It(World); It; ++It)
+	{
+		if (It->GetLevel() == World->PersistentLevel && !It->IsPendingKill())
+		{
+			return *It;
+		}
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APinballPartBatchActor* BatchActor = World->SpawnActor<APinballPartBatchActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParameters);
+	if (BatchActor != nullptr)
+	{
+		BatchActor->SetActorLabel(StaticPartBatcherDefs::BatchActorLabel);
+	}
+	return BatchActor;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console command
+
+static void BatchStaticPartsCommand(const TArray<FString>& Args)
+{
+	if (GEditor == nullptr)
+	{
+		return;
+	}
+
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	bool bSelectedOnly = false;
+	bool bAllowScripted = false;
+	int32 MinInstances = StaticPartBatcherDefs::DefaultMinInstances;
+	TArray<UClass*> Classes;
+	for (const FString& Arg : Args)
+	{
+		FString ClassPath;
+		if (FParse::Value(*Arg, TEXT("Class="), ClassPath))
+		{
+			if (UClass* Class = LoadClass<AActor>(nullptr, *ClassPath))
+			{
+				Classes.Add(Class);
+			}
+			else
+			{
+				UE_LOG(LogStaticPartBatcher, Error, TEXT("%s isn't an actor class"), *ClassPath);
+				return;
+			}
+		}
+		else if (Arg == TEXT("Selected"))
+		{
+			bSelectedOnly = true;
+		}
+		else if (Arg == TEXT("AllowScripted"))
+		{
+			bAllowScripted = true;
+		}
+		else
+		{
+			FParse::Value(*Arg, TEXT("MinInstances="), MinInstances);
+		}
+	}
+
+	TArray<AActor*> Actors;
+	if (bSelectedOnly)
+	{
+		GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(Actors);
+	}
+	else
+	{
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			Actors.Add(*It);
+		}
+	}
+
+	if (Classes.Num() > 0)
+	{
+		Actors.RemoveAll([&Classes](const AActor* Actor)
+		{
+			return !Classes.ContainsByPredicate([Actor](const UClass* Class) { return Actor->IsA(Class); });
+		});
+	}
+
+	// Actors with a script are only batched when asked to, gameplay is then expected to drive them through the batch actor
+	FStaticPartBatcher::BatchActors(World, Actors, bAllowScripted, FMath::Max(MinInstances, 1));
+}
+
+static FAutoConsoleCommand BatchStaticPartsConsoleCommand(
+	TEXT("Pinball.BatchStaticParts"),
+	TEXT("Replaces repeated static mesh actors with instances in a part batch actor, and logs the draw calls before and after. Usage: Pinball.BatchStaticParts [Selected] [Class=Path]... [MinInstances=N] [AllowScripted]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BatchStaticPartsCommand));
+
+#undef LOCTEXT_NAMESPACE
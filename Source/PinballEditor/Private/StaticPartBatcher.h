@@ -0,0 +1,34 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class APinballPartBatchActor;
+class UStaticMeshComponent;
+class UWorld;
+
+/**
+ * Replaces actors that only draw static meshes, such as posts and rails, with instances in the part batch actor of their level
+ * Parts keep their label and tags, so gameplay can still find them through the batch actor
+ */
+class FStaticPartBatcher
+{
+public:
+	/**
+	* Static mesh components of an actor made only of static meshes, or false if it can't be batched
+	* @param bAllowScriptedActors	Whether actors with a Blueprint BeginPlay, tick, overlap or hit event can be batched, their script no longer runs once batched
+	*/
+	static bool GetBatchableMeshComponents(AActor* Actor, bool bAllowScriptedActors, TArray<UStaticMeshComponent*>& OutMeshComponents);
+
+	/**
+	* Batches the actors whose static meshes are used by at least MinInstances of them, in a single transaction
+	* @return	Number of batched actors
+	*/
+	static int32 BatchActors(UWorld* World, const TArray<AActor*>& Actors, bool bAllowScriptedActors, int32 MinInstances);
+
+private:
+	/** The part batch actor of the persistent level, spawned if there isn't one yet */
+	static APinballPartBatchActor* FindOrSpawnBatchActor(UWorld* World);
+};
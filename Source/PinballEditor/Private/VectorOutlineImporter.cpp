@@ -0,0 +1,1190 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "VectorOutlineImporter.h"
+#include "SplineActor.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "Editor.h"
+#include "ScopedTransaction.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Paths.h"
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+
+#define LOCTEXT_NAMESPACE "VectorOutlineImporter"
+
+DEFINE_LOG_CATEGORY_STATIC(LogVectorOutlineImporter, Log, All);
+
+namespace VectorOutlineImporterDefs
+{
+	/** Size of the blocks the files are read in */
+	const int64 ReadChunkSize = 64 * 1024;
+
+	/** Arcs are split in segments of at most this angle, a single hermite segment drifts away from the arc above that */
+	const float MaxArcSegmentAngle = HALF_PI;
+
+	/** Distance under which the last point of a closed outline is considered the same as the first one */
+	const float ClosePointTolerance = 0.001f;
+
+	/** Outlines and groups whose name contains this become ramps */
+	const TCHAR* RampNameTag = TEXT("ramp");
+
+	/** World outliner folder for the spawned actors */
+	const FName ImportFolderPath = TEXT("ImportedOutlines");
+
+	/** Classes spawned by default, the Blueprints give the native classes their meshes and collision */
+	const TCHAR* DefaultWallClassPath = TEXT("/Game/Blueprints/BP_WallActor.BP_WallActor_C");
+	const TCHAR* DefaultRampClassPath = TEXT("/Game/Blueprints/BP_RampActor.BP_RampActor_C");
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FVectorOutline
+
+FVectorOutline::FVectorOutline()
+	: bRamp(false)
+	, bClosedLoop(false)
+{
+}
+
+void FVectorOutline::MoveTo(const FVector2D& Location)
+{
+	Locations.Reset();
+	ArriveTangents.Reset();
+	LeaveTangents.Reset();
+
+	Locations.Add(Location);
+	ArriveTangents.Add(FVector2D::ZeroVector);
+	LeaveTangents.Add(FVector2D::ZeroVector);
+}
+
+void FVectorOutline::AddSegment(const FVector2D& StartLeaveTangent, const FVector2D& Location, const FVector2D& EndArriveTangent)
+{
+	// Zero length segments would only add duplicate points
+	if (Location.Equals(GetLastLocation()))
+	{
+		return;
+	}
+
+	LeaveTangents.Last() = StartLeaveTangent;
+
+	Locations.Add(Location);
+	ArriveTangents.Add(EndArriveTangent);
+	LeaveTangents.Add(FVector2D::ZeroVector);
+}
+
+void FVectorOutline::LineTo(const FVector2D& Location)
+{
+	const FVector2D Delta = Location - GetLastLocation();
+	AddSegment(Delta, Location, Delta);
+}
+
+void FVectorOutline::CubicTo(const FVector2D& Control1, const FVector2D& Control2, const FVector2D& Location)
+{
+	// Derivatives of the bezier at both ends, which is what the spline uses as tangents between two consecutive keys
+	AddSegment(3.0f * (Control1 - GetLastLocation()), Location, 3.0f * (Location - Control2));
+}
+
+void FVectorOutline::QuadraticTo(const FVector2D& Control, const FVector2D& Location)
+{
+	AddSegment(2.0f * (Control - GetLastLocation()), Location, 2.0f * (Location - Control));
+}
+
+void FVectorOutline::EllipticalArcTo(const FVector2D& Center, const FVector2D& Radii, float Rotation, float StartAngle, float SweepAngle)
+{
+	const int32 NumSegments = FMath::Max(1, FMath::CeilToInt(FMath::Abs(SweepAngle) / VectorOutlineImporterDefs::MaxArcSegmentAngle));
+	const float SegmentAngle = SweepAngle / NumSegments;
+
+	// Hermite tangent of a cubic approximating an arc of SegmentAngle, relative to the derivative of the ellipse
+	const float TangentScale = 4.0f * FMath::Tan(SegmentAngle / 4.0f);
+
+	float RotationSin, RotationCos;
+	FMath::SinCos(&RotationSin, &RotationCos, Rotation);
+
+	auto GetEllipsePoint = [&](float Angle, FVector2D& OutLocation, FVector2D& OutDerivative)
+	{
+		float AngleSin, AngleCos;
+		FMath::SinCos(&AngleSin, &AngleCos, Angle);
+
+		const FVector2D Local(Radii.X * AngleCos, Radii.Y * AngleSin);
+		const FVector2D LocalDerivative(-Radii.X * AngleSin, Radii.Y * AngleCos);
+
+		OutLocation = Center + FVector2D(Local.X * RotationCos - Local.Y * RotationSin, Local.X * RotationSin + Local.Y * RotationCos);
+		OutDerivative = FVector2D(LocalDerivative.X * RotationCos - LocalDerivative.Y * RotationSin, LocalDerivative.X * RotationSin + LocalDerivative.Y * RotationCos);
+	};
+
+	FVector2D StartLocation, StartDerivative;
+	GetEllipsePoint(StartAngle, StartLocation, StartDerivative);
+
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		FVector2D EndLocation, EndDerivative;
+		GetEllipsePoint(StartAngle + (SegmentIndex + 1) * SegmentAngle, EndLocation, EndDerivative);
+
+		AddSegment(TangentScale * StartDerivative, EndLocation, TangentScale * EndDerivative);
+
+		StartDerivative = EndDerivative;
+	}
+}
+
+void FVectorOutline::Close()
+{
+	if (Locations.Num() >= 2 && Locations.Last().Equals(Locations[0], VectorOutlineImporterDefs::ClosePointTolerance))
+	{
+		// The outline already ends on its first point, which becomes the loop segment
+		ArriveTangents[0] = ArriveTangents.Last();
+		Locations.Pop(false);
+		ArriveTangents.Pop(false);
+		LeaveTangents.Pop(false);
+	}
+	else if (Locations.Num() >= 2)
+	{
+		// Straight loop segment back to the first point
+		const FVector2D Delta = Locations[0] - GetLastLocation();
+		LeaveTangents.Last() = Delta;
+		ArriveTangents[0] = Delta;
+	}
+
+	bClosedLoop = true;
+}
+
+void FVectorOutline::Finish()
+{
+	if (!bClosedLoop && Locations.Num() >= 2)
+	{
+		// Open ends continue straight, in the direction of their only segment
+		ArriveTangents[0] = LeaveTangents[0];
+		LeaveTangents.Last() = ArriveTangents.Last();
+	}
+}
+
+void FVectorOutline::FlipY()
+{
+	for (int32 PointIndex = 0; PointIndex < Locations.Num(); ++PointIndex)
+	{
+		Locations[PointIndex].Y = -Locations[PointIndex].Y;
+		ArriveTangents[PointIndex].Y = -ArriveTangents[PointIndex].Y;
+		LeaveTangents[PointIndex].Y = -LeaveTangents[PointIndex].Y;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FSvgOutlineReader
+
+/**
+ * Scans SVG markup one tag at a time, only the tag being scanned is kept in memory
+ * Reads <path>, <polyline> and <polygon> elements, transform attributes are not supported
+ */
+class FSvgOutlineReader
+{
+public:
+	FSvgOutlineReader(TArray<FVectorOutline>& InOutlines)
+		: Outlines(InOutlines)
+		, bInTag(false)
+		, QuoteChar(0)
+		, NumWarnings(0)
+	{
+	}
+
+	void ProcessBytes(const uint8* Bytes, int64 NumBytes)
+	{
+		for (int64 ByteIndex = 0; ByteIndex < NumBytes; ++ByteIndex)
+		{
+			const ANSICHAR Char = (ANSICHAR)Bytes[ByteIndex];
+			if (!bInTag)
+			{
+				if (Char == '<')
+				{
+					bInTag = true;
+					QuoteChar = 0;
+					TagBytes.Reset();
+				}
+				continue;
+			}
+
+			if (QuoteChar != 0)
+			{
+				if (Char == QuoteChar)
+				{
+					QuoteChar = 0;
+				}
+			}
+			else if (Char == '"' || Char == '\'')
+			{
+				// Comments may contain unbalanced quotes
+				if (!IsComment())
+				{
+					QuoteChar = Char;
+				}
+			}
+			else if (Char == '>' && (!IsComment() || IsCommentEnd()))
+			{
+				bInTag = false;
+				ProcessTag();
+				continue;
+			}
+
+			TagBytes.Add(Char);
+		}
+	}
+
+private:
+	bool IsComment() const
+	{
+		return TagBytes.Num() >= 3 && TagBytes[0] == '!' && TagBytes[1] == '-' && TagBytes[2] == '-';
+	}
+
+	bool IsCommentEnd() const
+	{
+		const int32 Num = TagBytes.Num();
+		return Num >= 5 && TagBytes[Num - 1] == '-' && TagBytes[Num - 2] == '-';
+	}
+
+	void ProcessTag()
+	{
+		if (TagBytes.Num() == 0 || TagBytes[0] == '!' || TagBytes[0] == '?')
+		{
+			return;
+		}
+
+		TagBytes.Add('\0');
+		const FString Tag = FUTF8ToTCHAR(TagBytes.GetData()).Get();
+		const bool bSelfClosing = Tag.EndsWith(TEXT("/"));
+
+		// Keep track of groups, a group named as a ramp makes everything in it a ramp
+		if (Tag.StartsWith(TEXT("/g")) && (Tag.Len() == 2 || FChar::IsWhitespace(Tag[2])))
+		{
+			if (GroupIsRamp.Num() > 0)
+			{
+				GroupIsRamp.Pop(false);
+			}
+			return;
+		}
+
+		const FString ElementName = GetElementName(Tag);
+		const bool bParentIsRamp = GroupIsRamp.Num() > 0 && GroupIsRamp.Last();
+
+		if (ElementName == TEXT("g"))
+		{
+			if (!bSelfClosing)
+			{
+				GroupIsRamp.Add(bParentIsRamp || IsNamedAsRamp(Tag));
+				WarnIfTransformed(Tag);
+			}
+			return;
+		}
+
+		const bool bPath = ElementName == TEXT("path");
+		const bool bPolyline = ElementName == TEXT("polyline");
+		const bool bPolygon = ElementName == TEXT("polygon");
+		if (!bPath && !bPolyline && !bPolygon)
+		{
+			return;
+		}
+
+		WarnIfTransformed(Tag);
+
+		FString Name;
+		if (!GetAttribute(Tag, TEXT("id"), Name))
+		{
+			Name = FString::Printf(TEXT("%s%d"), *ElementName, Outlines.Num());
+		}
+		const bool bRamp = bParentIsRamp || IsNamedAsRamp(Tag);
+
+		FString Data;
+		if (bPath && GetAttribute(Tag, TEXT("d"), Data))
+		{
+			ParsePathData(Data, Name, bRamp);
+		}
+		else if (!bPath && GetAttribute(Tag, TEXT("points"), Data))
+		{
+			ParsePoints(Data, Name, bRamp, bPolygon);
+		}
+	}
+
+	static FString GetElementName(const FString& Tag)
+	{
+		int32 NameEnd = 0;
+		while (NameEnd < Tag.Len() && !FChar::IsWhitespace(Tag[NameEnd]) && Tag[NameEnd] != TEXT('/'))
+		{
+			++NameEnd;
+		}
+
+		// Ignore any namespace prefix, as in svg:path
+		FString ElementName = Tag.Left(NameEnd);
+		int32 ColonIndex;
+		if (ElementName.FindLastChar(TEXT(':'), ColonIndex))
+		{
+			ElementName = ElementName.RightChop(ColonIndex + 1);
+		}
+		return ElementName;
+	}
+
+	static bool GetAttribute(const FString& Tag, const TCHAR* AttributeName, FString& OutValue)
+	{
+		const int32 AttributeNameLen = FCString::Strlen(AttributeName);
+		int32 SearchStart = 0;
+		while (true)
+		{
+			const int32 NameIndex = Tag.Find(AttributeName, ESearchCase::CaseSensitive, ESearchDir::FromStart, SearchStart);
+			if (NameIndex == INDEX_NONE)
+			{
+				return false;
+			}
+			SearchStart = NameIndex + AttributeNameLen;
+
+			// Must be a whole attribute name, not the end of a longer one or part of a value
+			if (NameIndex == 0 || !FChar::IsWhitespace(Tag[NameIndex - 1]))
+			{
+				continue;
+			}
+
+			int32 Cursor = SearchStart;
+			while (Cursor < Tag.Len() && FChar::IsWhitespace(Tag[Cursor]))
+			{
+				++Cursor;
+			}
+			if (Cursor >= Tag.Len() || Tag[Cursor] != TEXT('='))
+			{
+				continue;
+			}
+			++Cursor;
+			while (Cursor < Tag.Len() && FChar::IsWhitespace(Tag[Cursor]))
+			{
+				++Cursor;
+			}
+			if (Cursor >= Tag.Len() || (Tag[Cursor] != TEXT('"') && Tag[Cursor] != TEXT('\'')))
+			{
+				continue;
+			}
+
+			const TCHAR AttributeQuote = Tag[Cursor];
+			const int32 ValueStart = Cursor + 1;
+			int32 ValueEnd = ValueStart;
+			while (ValueEnd < Tag.Len() && Tag[ValueEnd] != AttributeQuote)
+			{
+				++ValueEnd;
+			}
+
+			OutValue = Tag.Mid(ValueStart, ValueEnd - ValueStart);
+			return true;
+		}
+	}
+
+	static bool IsNamedAsRamp(const FString& Tag)
+	{
+		static const TCHAR* NameAttributes[] = { TEXT("id"), TEXT("class"), TEXT("inkscape:label") };
+		for (const TCHAR* NameAttribute : NameAttributes)
+		{
+			FString Value;
+			if (GetAttribute(Tag, NameAttribute, Value) && Value.Contains(VectorOutlineImporterDefs::RampNameTag))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void WarnIfTransformed(const FString& Tag)
+	{
+		FString Transform;
+		if (GetAttribute(Tag, TEXT("transform"), Transform) && NumWarnings++ == 0)
+		{
+			UE_LOG(LogVectorOutlineImporter, Warning, TEXT("SVG transform attributes are ignored, flatten transforms before exporting (first found: '%s')"), *Transform);
+		}
+	}
+
+	static void SkipSeparators(const TCHAR*& Cursor)
+	{
+		while (*Cursor != 0 && (FChar::IsWhitespace(*Cursor) || *Cursor == TEXT(',')))
+		{
+			++Cursor;
+		}
+	}
+
+	static bool ReadNumber(const TCHAR*& Cursor, float& OutValue)
+	{
+		SkipSeparators(Cursor);
+
+		TCHAR* NumberEnd = nullptr;
+		const double Value = FCString::Strtod(Cursor, &NumberEnd);
+		if (NumberEnd == Cursor)
+		{
+			return false;
+		}
+
+		Cursor = NumberEnd;
+		OutValue = (float)Value;
+		return true;
+	}
+
+	static bool ReadPoint(const TCHAR*& Cursor, FVector2D& OutPoint)
+	{
+		return ReadNumber(Cursor, OutPoint.X) && ReadNumber(Cursor, OutPoint.Y);
+	}
+
+	/** Arc flags are single digits that may be written without any separator */
+	static bool ReadFlag(const TCHAR*& Cursor, bool& OutFlag)
+	{
+		SkipSeparators(Cursor);
+		if (*Cursor != TEXT('0') && *Cursor != TEXT('1'))
+		{
+			return false;
+		}
+
+		OutFlag = *Cursor == TEXT('1');
+		++Cursor;
+		return true;
+	}
+
+	static float GetVectorAngle(const FVector2D& From, const FVector2D& To)
+	{
+		return FMath::Atan2(From.X * To.Y - From.Y * To.X, From.X * To.X + From.Y * To.Y);
+	}
+
+	/** Converts an SVG endpoint arc to a center parameterized one, see the SVG specification implementation notes */
+	static void AddSvgArc(FVectorOutline& Outline, FVector2D Radii, float RotationDegrees, bool bLargeArc, bool bSweep, const FVector2D& End)
+	{
+		const FVector2D Start = Outline.GetLastLocation();
+		Radii = FVector2D(FMath::Abs(Radii.X), FMath::Abs(Radii.Y));
+		if (Radii.X < KINDA_SMALL_NUMBER || Radii.Y < KINDA_SMALL_NUMBER)
+		{
+			Outline.LineTo(End);
+			return;
+		}
+
+		const float Rotation = FMath::DegreesToRadians(RotationDegrees);
+		float RotationSin, RotationCos;
+		FMath::SinCos(&RotationSin, &RotationCos, Rotation);
+
+		const FVector2D HalfDelta = (Start - End) * 0.5f;
+		const FVector2D StartPrime(RotationCos * HalfDelta.X + RotationSin * HalfDelta.Y, -RotationSin * HalfDelta.X + RotationCos * HalfDelta.Y);
+
+		// Scale up radii that are too small to reach the end point
+		const float RadiiScale = FMath::Square(StartPrime.X / Radii.X) + FMath::Square(StartPrime.Y / Radii.Y);
+		if (RadiiScale > 1.0f)
+		{
+			Radii *= FMath::Sqrt(RadiiScale);
+		}
+
+		const float Numerator = FMath::Square(Radii.X * Radii.Y) - FMath::Square(Radii.X * StartPrime.Y) - FMath::Square(Radii.Y * StartPrime.X);
+		const float Denominator = FMath::Square(Radii.X * StartPrime.Y) + FMath::Square(Radii.Y * StartPrime.X);
+		const float CenterScale = (bLargeArc == bSweep ? -1.0f : 1.0f) * FMath::Sqrt(FMath::Max(0.0f, Numerator / FMath::Max(Denominator, SMALL_NUMBER)));
+		const FVector2D CenterPrime(CenterScale * Radii.X * StartPrime.Y / Radii.Y, -CenterScale * Radii.Y * StartPrime.X / Radii.X);
+
+		const FVector2D Center = FVector2D(RotationCos * CenterPrime.X - RotationSin * CenterPrime.Y, RotationSin * CenterPrime.X + RotationCos * CenterPrime.Y) + (Start + End) * 0.5f;
+
+		const FVector2D StartVector((StartPrime.X - CenterPrime.X) / Radii.X, (StartPrime.Y - CenterPrime.Y) / Radii.Y);
+		const FVector2D EndVector((-StartPrime.X - CenterPrime.X) / Radii.X, (-StartPrime.Y - CenterPrime.Y) / Radii.Y);
+		const float StartAngle = GetVectorAngle(FVector2D(1.0f, 0.0f), StartVector);
+		float SweepAngle = GetVectorAngle(StartVector, EndVector);
+		if (!bSweep && SweepAngle > 0.0f)
+		{
+			SweepAngle -= 2.0f * PI;
+		}
+		else if (bSweep && SweepAngle < 0.0f)
+		{
+			SweepAngle += 2.0f * PI;
+		}
+
+		Outline.EllipticalArcTo(Center, Radii, Rotation, StartAngle, SweepAngle);
+	}
+
+	void AddOutline(FVectorOutline& Outline)
+	{
+		Outline.Finish();
+		if (Outline.Locations.Num() >= 2)
+		{
+			Outlines.Add(MoveTemp(Outline));
+		}
+		Outline = FVectorOutline();
+	}
+
+	void ParsePathData(const FString& PathData, const FString& Name, bool bRamp)
+	{
+		FVectorOutline Outline;
+		bool bHasOutline = false;
+		int32 NumSubpaths = 0;
+
+		FVector2D Current = FVector2D::ZeroVector;
+		FVector2D SubpathStart = FVector2D::ZeroVector;
+
+		// Last control point, for the smooth curve commands that mirror it
+		FVector2D LastControl = FVector2D::ZeroVector;
+		TCHAR LastCommand = 0;
+		TCHAR Command = 0;
+
+		auto BeginOutline = [&](const FVector2D& Location)
+		{
+			if (bHasOutline)
+			{
+				AddOutline(Outline);
+			}
+			Outline.Name = NumSubpaths == 0 ? Name : FString::Printf(TEXT("%s_%d"), *Name, NumSubpaths);
+			Outline.bRamp = bRamp;
+			Outline.MoveTo(Location);
+			bHasOutline = true;
+			++NumSubpaths;
+		};
+
+		const TCHAR* Cursor = *PathData;
+		while (true)
+		{
+			SkipSeparators(Cursor);
+			if (*Cursor == 0)
+			{
+				break;
+			}
+
+			if (FChar::IsAlpha(*Cursor))
+			{
+				Command = *Cursor++;
+				if (Command == TEXT('Z') || Command == TEXT('z'))
+				{
+					if (bHasOutline)
+					{
+						Outline.Close();
+						AddOutline(Outline);
+						bHasOutline = false;
+					}
+					Current = SubpathStart;
+					LastCommand = Command;
+					continue;
+				}
+			}
+			else if (Command == 0)
+			{
+				UE_LOG(LogVectorOutlineImporter, Warning, TEXT("Path '%s' doesn't start with a command, skipped"), *Name);
+				return;
+			}
+
+			const bool bRelative = FChar::IsLower(Command);
+			const FVector2D Origin = bRelative ? Current : FVector2D::ZeroVector;
+			const TCHAR UpperCommand = FChar::ToUpper(Command);
+
+			// Drawing after a close command continues from the start of the closed subpath
+			if (!bHasOutline && UpperCommand != TEXT('M'))
+			{
+				BeginOutline(Current);
+			}
+
+			bool bValid = true;
+			FVector2D Control1, Control2, Point;
+			switch (UpperCommand)
+			{
+			case TEXT('M'):
+				bValid = ReadPoint(Cursor, Point);
+				if (bValid)
+				{
+					Current = SubpathStart = Origin + Point;
+					BeginOutline(Current);
+
+					// Any more coordinates after a move are line segments
+					Command = bRelative ? TEXT('l') : TEXT('L');
+				}
+				break;
+			case TEXT('L'):
+				bValid = ReadPoint(Cursor, Point);
+				if (bValid)
+				{
+					Current = Origin + Point;
+					Outline.LineTo(Current);
+				}
+				break;
+			case TEXT('H'):
+				bValid = ReadNumber(Cursor, Point.X);
+				if (bValid)
+				{
+					Current.X = (bRelative ? Current.X : 0.0f) + Point.X;
+					Outline.LineTo(Current);
+				}
+				break;
+			case TEXT('V'):
+				bValid = ReadNumber(Cursor, Point.Y);
+				if (bValid)
+				{
+					Current.Y = (bRelative ? Current.Y : 0.0f) + Point.Y;
+					Outline.LineTo(Current);
+				}
+				break;
+			case TEXT('C'):
+				bValid = ReadPoint(Cursor, Control1) && ReadPoint(Cursor, Control2) && ReadPoint(Cursor, Point);
+				if (bValid)
+				{
+					LastControl = Origin + Control2;
+					Current = Origin + Point;
+					Outline.CubicTo(Origin + Control1, LastControl, Current);
+				}
+				break;
+			case TEXT('S'):
+				bValid = ReadPoint(Cursor, Control2) && ReadPoint(Cursor, Point);
+				if (bValid)
+				{
+					const TCHAR UpperLastCommand = FChar::ToUpper(LastCommand);
+					Control1 = (UpperLastCommand == TEXT('C') || UpperLastCommand == TEXT('S')) ? 2.0f * Current - LastControl : Current;
+					LastControl = Origin + Control2;
+					Current = Origin + Point;
+					Outline.CubicTo(Control1, LastControl, Current);
+				}
+				break;
+			case TEXT('Q'):
+				bValid = ReadPoint(Cursor, Control1) && ReadPoint(Cursor, Point);
+				if (bValid)
+				{
+					LastControl = Origin + Control1;
+					Current = Origin + Point;
+					Outline.QuadraticTo(LastControl, Current);
+				}
+				break;
+			case TEXT('T'):
+				bValid = ReadPoint(Cursor, Point);
+				if (bValid)
+				{
+					const TCHAR UpperLastCommand = FChar::ToUpper(LastCommand);
+					LastControl = (UpperLastCommand == TEXT('Q') || UpperLastCommand == TEXT('T')) ? 2.0f * Current - LastControl : Current;
+					Current = Origin + Point;
+					Outline.QuadraticTo(LastControl, Current);
+				}
+				break;
+			case TEXT('A'):
+			{
+				FVector2D Radii;
+				float Rotation = 0.0f;
+				bool bLargeArc = false;
+				bool bSweep = false;
+				bValid = ReadPoint(Cursor, Radii) && ReadNumber(Cursor, Rotation) && ReadFlag(Cursor, bLargeArc) && ReadFlag(Cursor, bSweep) && ReadPoint(Cursor, Point);
+				if (bValid)
+				{
+					Current = Origin + Point;
+					AddSvgArc(Outline, Radii, Rotation, bLargeArc, bSweep, Current);
+				}
+				break;
+			}
+			default:
+				bValid = false;
+				break;
+			}
+
+			if (!bValid)
+			{
+				UE_LOG(LogVectorOutlineImporter, Warning, TEXT("Path '%s' has invalid data for command '%c', the rest of it is skipped"), *Name, Command);
+				break;
+			}
+
+			LastCommand = Command;
+		}
+
+		if (bHasOutline)
+		{
+			AddOutline(Outline);
+		}
+	}
+
+	void ParsePoints(const FString& Points, const FString& Name, bool bRamp, bool bClosedLoop)
+	{
+		FVectorOutline Outline;
+		Outline.Name = Name;
+		Outline.bRamp = bRamp;
+
+		const TCHAR* Cursor = *Points;
+		FVector2D Point;
+		while (ReadPoint(Cursor, Point))
+		{
+			if (Outline.Locations.Num() == 0)
+			{
+				Outline.MoveTo(Point);
+			}
+			else
+			{
+				Outline.LineTo(Point);
+			}
+		}
+
+		if (bClosedLoop && Outline.Locations.Num() > 0)
+		{
+			Outline.Close();
+		}
+		AddOutline(Outline);
+	}
+
+	TArray<FVectorOutline>& Outlines;
+
+	/** Bytes of the tag being scanned, without the angle brackets */
+	TArray<ANSICHAR> TagBytes;
+	bool bInTag;
+
+	/** Quote character of the attribute value being scanned, or 0 */
+	ANSICHAR QuoteChar;
+
+	/** For each open <g>, whether it or one of its parents is a ramp group */
+	TArray<bool> GroupIsRamp;
+
+	int32 NumWarnings;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// FDxfOutlineReader
+
+/**
+ * Scans the group code / value line pairs of an ASCII DXF file
+ * Reads LWPOLYLINE entities and old style POLYLINE entities with their VERTEX list, including arc bulges
+ */
+class FDxfOutlineReader
+{
+public:
+	FDxfOutlineReader(TArray<FVectorOutline>& InOutlines)
+		: Outlines(InOutlines)
+		, GroupCode(INDEX_NONE)
+		, EntityType(EDxfEntityType::Other)
+		, bPolylineClosed(false)
+		, bInPolyline(false)
+	{
+	}
+
+	void ProcessBytes(const uint8* Bytes, int64 NumBytes)
+	{
+		for (int64 ByteIndex = 0; ByteIndex < NumBytes; ++ByteIndex)
+		{
+			const ANSICHAR Char = (ANSICHAR)Bytes[ByteIndex];
+			if (Char == '\n')
+			{
+				LineBytes.Add('\0');
+				ProcessLine(FString(ANSI_TO_TCHAR(LineBytes.GetData())).TrimStartAndEnd());
+				LineBytes.Reset();
+			}
+			else if (Char != '\r')
+			{
+				LineBytes.Add(Char);
+			}
+		}
+	}
+
+	/** Flushes the last entity, call once the whole file has been processed */
+	void Finish()
+	{
+		if (LineBytes.Num() > 0)
+		{
+			LineBytes.Add('\0');
+			ProcessLine(FString(ANSI_TO_TCHAR(LineBytes.GetData())).TrimStartAndEnd());
+			LineBytes.Reset();
+		}
+		EndEntity();
+		EndPolyline();
+	}
+
+private:
+	enum class EDxfEntityType : uint8
+	{
+		LwPolyline,
+		Polyline,
+		Vertex,
+		Other,
+	};
+
+	void ProcessLine(const FString& Line)
+	{
+		// Lines alternate between a group code and its value
+		if (GroupCode == INDEX_NONE)
+		{
+			GroupCode = FCString::Atoi(*Line);
+			return;
+		}
+
+		const int32 Code = GroupCode;
+		GroupCode = INDEX_NONE;
+
+		if (Code == 0)
+		{
+			BeginEntity(Line);
+			return;
+		}
+
+		switch (Code)
+		{
+		case 8:
+			if (EntityType == EDxfEntityType::LwPolyline || EntityType == EDxfEntityType::Polyline)
+			{
+				Layer = Line;
+			}
+			break;
+		case 10:
+			if (EntityType == EDxfEntityType::LwPolyline || EntityType == EDxfEntityType::Vertex)
+			{
+				// Each X starts a new vertex
+				Vertices.Add(FVector2D(FCString::Atof(*Line), 0.0f));
+				Bulges.Add(0.0f);
+			}
+			break;
+		case 20:
+			if ((EntityType == EDxfEntityType::LwPolyline || EntityType == EDxfEntityType::Vertex) && Vertices.Num() > 0)
+			{
+				Vertices.Last().Y = FCString::Atof(*Line);
+			}
+			break;
+		case 42:
+			if ((EntityType == EDxfEntityType::LwPolyline || EntityType == EDxfEntityType::Vertex) && Bulges.Num() > 0)
+			{
+				Bulges.Last() = FCString::Atof(*Line);
+			}
+			break;
+		case 70:
+			if (EntityType == EDxfEntityType::LwPolyline || EntityType == EDxfEntityType::Polyline)
+			{
+				bPolylineClosed = (FCString::Atoi(*Line) & 1) != 0;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void BeginEntity(const FString& Name)
+	{
+		EndEntity();
+
+		if (Name == TEXT("LWPOLYLINE"))
+		{
+			EndPolyline();
+			EntityType = EDxfEntityType::LwPolyline;
+			bInPolyline = true;
+		}
+		else if (Name == TEXT("POLYLINE"))
+		{
+			EndPolyline();
+			EntityType = EDxfEntityType::Polyline;
+			bInPolyline = true;
+		}
+		else if (Name == TEXT("VERTEX") && bInPolyline)
+		{
+			EntityType = EDxfEntityType::Vertex;
+		}
+		else
+		{
+			// SEQEND or any other entity ends the vertex list of a POLYLINE
+			EndPolyline();
+			EntityType = EDxfEntityType::Other;
+		}
+	}
+
+	void EndEntity()
+	{
+		// An LWPOLYLINE holds all of its vertices itself
+		if (EntityType == EDxfEntityType::LwPolyline)
+		{
+			EndPolyline();
+		}
+		EntityType = EDxfEntityType::Other;
+	}
+
+	void EndPolyline()
+	{
+		if (!bInPolyline)
+		{
+			return;
+		}
+		bInPolyline = false;
+
+		if (Vertices.Num() >= 2)
+		{
+			FVectorOutline Outline;
+			Outline.Name = FString::Printf(TEXT("%s_%d"), Layer.IsEmpty() ? TEXT("Polyline") : *Layer, Outlines.Num());
+			Outline.bRamp = Layer.Contains(VectorOutlineImporterDefs::RampNameTag);
+			Outline.MoveTo(Vertices[0]);
+
+			const int32 NumSegments = bPolylineClosed ? Vertices.Num() : Vertices.Num() - 1;
+			for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+			{
+				AddBulgeSegment(Outline, Vertices[SegmentIndex], Vertices[(SegmentIndex + 1) % Vertices.Num()], Bulges[SegmentIndex]);
+			}
+
+			if (bPolylineClosed)
+			{
+				Outline.Close();
+			}
+			Outline.Finish();
+
+			// DXF has Y pointing up
+			Outline.FlipY();
+
+			if (Outline.Locations.Num() >= 2)
+			{
+				Outlines.Add(MoveTemp(Outline));
+			}
+		}
+
+		Vertices.Reset();
+		Bulges.Reset();
+		Layer.Reset();
+		bPolylineClosed = false;
+	}
+
+	/** A bulge is the tangent of a quarter of the included angle of the arc, positive for counter clockwise arcs */
+	static void AddBulgeSegment(FVectorOutline& Outline, const FVector2D& Start, const FVector2D& End, float Bulge)
+	{
+		const FVector2D Chord = End - Start;
+		const float ChordLength = Chord.Size();
+		if (FMath::IsNearlyZero(Bulge) || ChordLength < KINDA_SMALL_NUMBER)
+		{
+			Outline.LineTo(End);
+			return;
+		}
+
+		const float SweepAngle = 4.0f * FMath::Atan(Bulge);
+
+		// The center is on the left of the chord for counter clockwise arcs
+		const FVector2D ChordNormal = FVector2D(-Chord.Y, Chord.X) / ChordLength;
+		const FVector2D Center = (Start + End) * 0.5f + ChordNormal * ((ChordLength * 0.5f) / FMath::Tan(SweepAngle * 0.5f));
+		const FVector2D StartOffset = Start - Center;
+		const float Radius = StartOffset.Size();
+
+		Outline.EllipticalArcTo(Center, FVector2D(Radius, Radius), 0.0f, FMath::Atan2(StartOffset.Y, StartOffset.X), SweepAngle);
+	}
+
+	TArray<FVectorOutline>& Outlines;
+
+	/** Bytes of the line being scanned */
+	TArray<ANSICHAR> LineBytes;
+
+	/** Group code waiting for its value, or INDEX_NONE if the next line is a group code */
+	int32 GroupCode;
+
+	EDxfEntityType EntityType;
+
+	/** Polyline being read */
+	TArray<FVector2D> Vertices;
+	TArray<float> Bulges;
+	FString Layer;
+	bool bPolylineClosed;
+	bool bInPolyline;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// FVectorOutlineImporter
+
+bool FVectorOutlineImporter::ReadOutlines(const FString& Filename, TArray<FVectorOutline>& OutOutlines, FString& OutError)
+{
+	const FString Extension = FPaths::GetExtension(Filename);
+	const bool bSvg = Extension.Equals(TEXT("svg"), ESearchCase::IgnoreCase);
+	const bool bDxf = Extension.Equals(TEXT("dxf"), ESearchCase::IgnoreCase);
+	if (!bSvg && !bDxf)
+	{
+		OutError = FString::Printf(TEXT("Unsupported file type '%s', expected .svg or .dxf"), *Extension);
+		return false;
+	}
+
+	TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Filename));
+	if (!FileHandle)
+	{
+		OutError = FString::Printf(TEXT("Couldn't open '%s'"), *Filename);
+		return false;
+	}
+
+	FSvgOutlineReader SvgReader(OutOutlines);
+	FDxfOutlineReader DxfReader(OutOutlines);
+
+	TArray<uint8> Chunk;
+	Chunk.SetNumUninitialized(VectorOutlineImporterDefs::ReadChunkSize);
+
+	int64 BytesLeft = FileHandle->Size();
+	while (BytesLeft > 0)
+	{
+		const int64 ChunkSize = FMath::Min(BytesLeft, VectorOutlineImporterDefs::ReadChunkSize);
+		if (!FileHandle->Read(Chunk.GetData(), ChunkSize))
+		{
+			OutError = FString::Printf(TEXT("Couldn't read '%s'"), *Filename);
+			return false;
+		}
+		BytesLeft -= ChunkSize;
+
+		if (bSvg)
+		{
+			SvgReader.ProcessBytes(Chunk.GetData(), ChunkSize);
+		}
+		else
+		{
+			DxfReader.ProcessBytes(Chunk.GetData(), ChunkSize);
+		}
+	}
+
+	if (bDxf)
+	{
+		DxfReader.Finish();
+	}
+
+	return true;
+}
+
+void FVectorOutlineImporter::SpawnOutlineActors(UWorld* World, const TArray<FVectorOutline>& Outlines, TSubclassOf<ASplineActor> WallClass, TSubclassOf<ASplineActor> RampClass, float Scale, TArray<ASplineActor*>& OutSpawnedActors)
+{
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("ImportVectorOutlines", "Import Vector Outlines"));
+
+	// Spawn every actor with its spline points set, but hold off the construction scripts
+	TArray<FTransform> SpawnTransforms;
+	TArray<int32> SpawnedOutlineIndices;
+	OutSpawnedActors.Reset(Outlines.Num());
+	SpawnTransforms.Reserve(Outlines.Num());
+	SpawnedOutlineIndices.Reserve(Outlines.Num());
+
+	TArray<FVector> Locations;
+	TArray<FVector> ArriveTangents;
+	TArray<FVector> LeaveTangents;
+	TArray<ESplinePointType::Type> Types;
+	const TArray<FVector> Scales;
+
+	for (int32 OutlineIndex = 0; OutlineIndex < Outlines.Num(); ++OutlineIndex)
+	{
+		const FVectorOutline& Outline = Outlines[OutlineIndex];
+		UClass* ActorClass = Outline.bRamp ? RampClass.Get() : WallClass.Get();
+		if (ActorClass == nullptr)
+		{
+			continue;
+		}
+
+		// Place the actor in the middle of its outline, so it is easy to find and move around
+		const FVector2D Center = FBox2D(Outline.Locations).GetCenter();
+		const FTransform SpawnTransform(FVector(Center * Scale, 0.0f));
+
+		ASplineActor* SplineActor = World->SpawnActorDeferred<ASplineActor>(ActorClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (SplineActor == nullptr || SplineActor->SplineComponent == nullptr)
+		{
+			continue;
+		}
+
+		const int32 NumPoints = Outline.Locations.Num();
+		Locations.SetNum(NumPoints);
+		ArriveTangents.SetNum(NumPoints);
+		LeaveTangents.SetNum(NumPoints);
+		Types.Init(ESplinePointType::CurveCustomTangent, NumPoints);
+		for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+		{
+			Locations[PointIndex] = FVector((Outline.Locations[PointIndex] - Center) * Scale, 0.0f);
+			ArriveTangents[PointIndex] = FVector(Outline.ArriveTangents[PointIndex] * Scale, 0.0f);
+			LeaveTangents[PointIndex] = FVector(Outline.LeaveTangents[PointIndex] * Scale, 0.0f);
+		}
+
+		SplineActor->SplineComponent->SetClosedLoop(Outline.bClosedLoop, false);
+		SplineActor->SetSplinePoints(Locations, ArriveTangents, LeaveTangents, Types, Scales);
+
+		OutSpawnedActors.Add(SplineActor);
+		SpawnTransforms.Add(SpawnTransform);
+		SpawnedOutlineIndices.Add(OutlineIndex);
+	}
+
+	// One construction pass per actor, now that all of them have their final points
+	GEditor->SelectNone(false, true);
+	for (int32 ActorIndex = 0; ActorIndex < OutSpawnedActors.Num(); ++ActorIndex)
+	{
+		ASplineActor* SplineActor = OutSpawnedActors[ActorIndex];
+		SplineActor->FinishSpawning(SpawnTransforms[ActorIndex]);
+		SplineActor->SetActorLabel(Outlines[SpawnedOutlineIndices[ActorIndex]].Name);
+		SplineActor->SetFolderPath(VectorOutlineImporterDefs::ImportFolderPath);
+		GEditor->SelectActor(SplineActor, true, false);
+	}
+	GEditor->NoteSelectionChange();
+}
+
+int32 FVectorOutlineImporter::ImportFile(UWorld* World, const FString& Filename, TSubclassOf<ASplineActor> WallClass, TSubclassOf<ASplineActor> RampClass, float Scale)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FVectorOutline> Outlines;
+	FString Error;
+	if (!FVectorOutlineImporter::ReadOutlines(Filename, Outlines, Error))
+	{
+		UE_LOG(LogVectorOutlineImporter, Error, TEXT("%s"), *Error);
+		return 0;
+	}
+
+	const double ReadTime = FPlatformTime::Seconds();
+
+	TArray<ASplineActor*> SpawnedActors;
+	SpawnOutlineActors(World, Outlines, WallClass, RampClass, Scale, SpawnedActors);
+
+	const double SpawnTime = FPlatformTime::Seconds();
+
+	int32 NumPoints = 0;
+	int32 NumRamps = 0;
+	for (const FVectorOutline& Outline : Outlines)
+	{
+		NumPoints += Outline.Locations.Num();
+		NumRamps += Outline.bRamp ? 1 : 0;
+	}
+
+	UE_LOG(LogVectorOutlineImporter, Log, TEXT("Imported %d outline(s) (%d walls, %d ramps, %d spline points) from '%s' as %d actor(s): read %.3fs, spawn and construction %.3fs, total %.3fs"),
+		Outlines.Num(), Outlines.Num() - NumRamps, NumRamps, NumPoints, *FPaths::GetCleanFilename(Filename), SpawnedActors.Num(),
+		ReadTime - StartTime, SpawnTime - ReadTime, SpawnTime - StartTime);
+
+	return SpawnedActors.Num();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console command
+
+static void ImportVectorOutlinesCommand(const TArray<FString>& Args)
+{
+	if (GEditor == nullptr)
+	{
+		return;
+	}
+
+	FString Filename;
+	FString WallClassPath = VectorOutlineImporterDefs::DefaultWallClassPath;
+	FString RampClassPath = VectorOutlineImporterDefs::DefaultRampClassPath;
+	float Scale = 1.0f;
+
+	// The console splits the arguments at every space, joined back so quoted paths with spaces read as one
+	const FString ArgsLine = FString::Join(Args, TEXT(" "));
+	const TCHAR* ArgsCursor = *ArgsLine;
+	FString Arg;
+	while (FParse::Token(ArgsCursor, Arg, false))
+	{
+		if (!FParse::Value(*Arg, TEXT("WallClass="), WallClassPath)
+			&& !FParse::Value(*Arg, TEXT("RampClass="), RampClassPath)
+			&& !FParse::Value(*Arg, TEXT("Scale="), Scale))
+		{
+			Filename = Arg;
+		}
+	}
+
+	const TSubclassOf<ASplineActor> WallClass = LoadClass<ASplineActor>(nullptr, *WallClassPath);
+	const TSubclassOf<ASplineActor> RampClass = LoadClass<ASplineActor>(nullptr, *RampClassPath);
+
+	if (WallClass == nullptr || RampClass == nullptr)
+	{
+		UE_LOG(LogVectorOutlineImporter, Error, TEXT("WallClass and RampClass must be spline actor classes"));
+		return;
+	}
+
+	if (Scale <= 0.0f)
+	{
+		UE_LOG(LogVectorOutlineImporter, Error, TEXT("Scale must be positive"));
+		return;
+	}
+
+	// Ask for the file if it wasn't given
+	if (Filename.IsEmpty())
+	{
+		IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+		TArray<FString> Filenames;
+		if (DesktopPlatform == nullptr || !DesktopPlatform->OpenFileDialog(FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+			LOCTEXT("ImportVectorOutlinesTitle", "Import Playfield Outlines").ToString(), FPaths::ProjectDir(), TEXT(""),
+			TEXT("Vector outlines (*.svg;*.dxf)|*.svg;*.dxf"), EFileDialogFlags::None, Filenames) || Filenames.Num() == 0)
+		{
+			return;
+		}
+		Filename = Filenames[0];
+	}
+
+	FVectorOutlineImporter::ImportFile(GEditor->GetEditorWorldContext().World(), Filename, WallClass, RampClass, Scale);
+}
+
+static FAutoConsoleCommand ImportVectorOutlinesConsoleCommand(
+	TEXT("Pinball.ImportVectorOutlines"),
+	TEXT("Spawns walls and ramps from the outlines of an SVG or DXF file. Walls and ramps are BP_WallActor and BP_RampActor unless other classes are given. Usage: Pinball.ImportVectorOutlines [File|\"File\"] [WallClass=Path] [RampClass=Path] [Scale=UnitsPerFileUnit]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ImportVectorOutlinesCommand));
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,91 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+
+class ASplineActor;
+class UWorld;
+
+/**
+ * One outline read from a vector file, as spline points with separate arrive and leave tangents
+ * Coordinates are in file units with Y pointing down, the same way the spline edit widget shows them
+ */
+struct FVectorOutline
+{
+	FVectorOutline();
+
+	/** Name of the element or layer the outline came from, used as the actor label */
+	FString Name;
+
+	/** Whether this outline should become a ramp rather than a wall */
+	bool bRamp;
+
+	bool bClosedLoop;
+
+	TArray<FVector2D> Locations;
+	TArray<FVector2D> ArriveTangents;
+	TArray<FVector2D> LeaveTangents;
+
+	/** Starts the outline at this location, must be called first */
+	void MoveTo(const FVector2D& Location);
+
+	/** Straight segment from the last point */
+	void LineTo(const FVector2D& Location);
+
+	/** Cubic bezier segment from the last point, converted to hermite tangents on the two end points */
+	void CubicTo(const FVector2D& Control1, const FVector2D& Control2, const FVector2D& Location);
+
+	/** Quadratic bezier segment from the last point */
+	void QuadraticTo(const FVector2D& Control, const FVector2D& Location);
+
+	/**
+	 * Elliptical arc starting at the last point, which is expected to be on the ellipse at StartAngle
+	 * Split into segments of at most 90 degrees, so the hermite segments stay close to the ellipse
+	 */
+	void EllipticalArcTo(const FVector2D& Center, const FVector2D& Radii, float Rotation, float StartAngle, float SweepAngle);
+
+	/** Closes the outline back to its first point */
+	void Close();
+
+	/** Fixes up the end tangents of an open outline, call once all segments have been added */
+	void Finish();
+
+	/** Mirrors the outline vertically, for file formats with Y pointing up */
+	void FlipY();
+
+	const FVector2D& GetLastLocation() const
+	{
+		return Locations.Last();
+	}
+
+private:
+	/** Adds a hermite segment from the last point */
+	void AddSegment(const FVector2D& StartLeaveTangent, const FVector2D& Location, const FVector2D& EndArriveTangent);
+};
+
+/**
+ * Imports wall and ramp outlines from SVG paths or DXF polylines
+ * Files are read in fixed size chunks and scanned in a single pass, so large playfields don't need to be loaded whole
+ * Outlines whose element, group or layer name contains "ramp" become ramps, everything else becomes a wall
+ */
+class FVectorOutlineImporter
+{
+public:
+	/** Reads every outline of a .svg or .dxf file, returns false with OutError set if the file can't be read */
+	static bool ReadOutlines(const FString& Filename, TArray<FVectorOutline>& OutOutlines, FString& OutError);
+
+	/**
+	 * Spawns one spline actor per outline in a single transaction
+	 * Actors are spawned deferred and all spline points are set in one batch, construction scripts only run once per actor at the end
+	 * @param Scale		Unreal units per file unit
+	 */
+	static void SpawnOutlineActors(UWorld* World, const TArray<FVectorOutline>& Outlines, TSubclassOf<ASplineActor> WallClass, TSubclassOf<ASplineActor> RampClass, float Scale, TArray<ASplineActor*>& OutSpawnedActors);
+
+	/**
+	 * Reads and spawns the outlines of a file, logging the time spent in each step
+	 * @return	Number of spawned actors
+	 */
+	static int32 ImportFile(UWorld* World, const FString& Filename, TSubclassOf<ASplineActor> WallClass, TSubclassOf<ASplineActor> RampClass, float Scale);
+};